@@ -9,6 +9,23 @@
 #define RIO_BGFX 1
 #endif // RIO_BGFX
 
+// Asynchronous file reads with io_uring, falls back to threads at runtime on older kernels
+#ifndef RIO_IO_URING
+#define RIO_IO_URING RIO_PLATFORM_LINUX
+#endif // RIO_IO_URING
+
+// Mutex and Semaphore wait on a futex instead of pthreads or Win32 objects.
+// Windows needs WaitOnAddress(), Windows 8 or later.
+#ifndef RIO_FUTEX
+#define RIO_FUTEX (RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID)
+#endif // RIO_FUTEX
+
 #ifndef RIO_DEBUG
 #define RIO_DEBUG 1
 #endif // RIO_DEBUG
+
+// Reverse lookup of string ids, see StringIdDebug.h.
+// Off by default, every string id hashed at runtime then takes a global lock and copies its string.
+#ifndef RIO_STRINGID_DEBUG
+#define RIO_STRINGID_DEBUG 0
+#endif // RIO_STRINGID_DEBUG
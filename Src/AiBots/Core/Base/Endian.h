@@ -0,0 +1,89 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#pragma once
+
+#include "Core/Base/Config.h"
+#include "Core/Base/Platform.h"
+#include "Core/Base/Types.h"
+
+#include <cstring> // memcpy
+
+#if RIO_COMPILER_MSVC
+	#include <stdlib.h> // _byteswap_*
+#endif // RIO_COMPILER_MSVC
+
+namespace Rio
+{
+	// Conversions between the byte order of the CPU and the byte order of files.
+	// Each function is its own inverse, e.g. toBigEndian() also converts from big-endian.
+	namespace EndianFn
+	{
+		inline uint8_t swap(uint8_t value)
+		{
+			return value;
+		}
+
+		inline uint16_t swap(uint16_t value)
+		{
+#if RIO_COMPILER_MSVC
+			return _byteswap_ushort(value);
+#else
+			return __builtin_bswap16(value);
+#endif // RIO_COMPILER_MSVC
+		}
+
+		inline uint32_t swap(uint32_t value)
+		{
+#if RIO_COMPILER_MSVC
+			return _byteswap_ulong(value);
+#else
+			return __builtin_bswap32(value);
+#endif // RIO_COMPILER_MSVC
+		}
+
+		inline uint64_t swap(uint64_t value)
+		{
+#if RIO_COMPILER_MSVC
+			return _byteswap_uint64(value);
+#else
+			return __builtin_bswap64(value);
+#endif // RIO_COMPILER_MSVC
+		}
+
+		// Reverses the bytes of any 1, 2, 4 or 8 bytes type, floats included
+		template <typename T>
+		inline T swapBytes(T value)
+		{
+			static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8, "Unsupported size");
+			typedef typename std::conditional<sizeof(T) == 1, uint8_t,
+				typename std::conditional<sizeof(T) == 2, uint16_t,
+				typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type>::type>::type Bits;
+
+			Bits bits;
+			memcpy(&bits, &value, sizeof(T));
+			bits = swap(bits);
+			memcpy(&value, &bits, sizeof(T));
+			return value;
+		}
+
+		template <typename T>
+		inline T toLittleEndian(T value)
+		{
+#if RIO_CPU_ENDIAN_BIG
+			return swapBytes(value);
+#else
+			return value;
+#endif // RIO_CPU_ENDIAN_BIG
+		}
+
+		template <typename T>
+		inline T toBigEndian(T value)
+		{
+#if RIO_CPU_ENDIAN_LITTLE
+			return swapBytes(value);
+#else
+			return value;
+#endif // RIO_CPU_ENDIAN_LITTLE
+		}
+	} // namespace EndianFn
+
+} // namespace Rio
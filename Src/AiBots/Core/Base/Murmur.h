@@ -8,4 +8,104 @@ namespace Rio
 {
 uint32_t murmur32(const void* key, size_t len, uint32_t seed = 0);
 uint64_t murmur64(const void* key, int len, uint64_t seed = 0);
+
+// Compile-time versions of murmur32() and murmur64()
+// The input is read byte-wise as little-endian words, so the results
+// are the same as the runtime versions on little-endian machines.
+// C++11 constexpr functions are limited to a single return statement,
+// hence the recursion (one step per word).
+namespace MurmurInternalFn
+{
+	const uint32_t m32 = 0x5bd1e995;
+	const int r32 = 24;
+	const uint64_t m64 = 0xc6a4a7935bd1e995ull;
+	const int r64 = 47;
+
+	constexpr uint32_t getByte32(const char* str, size_t i)
+	{
+		return uint32_t(uint8_t(str[i]));
+	}
+
+	constexpr uint64_t getByte64(const char* str, size_t i)
+	{
+		return uint64_t(uint8_t(str[i]));
+	}
+
+	constexpr uint32_t read32(const char* str)
+	{
+		return getByte32(str, 0) | (getByte32(str, 1) << 8) | (getByte32(str, 2) << 16) | (getByte32(str, 3) << 24);
+	}
+
+	constexpr uint64_t read64(const char* str)
+	{
+		return getByte64(str, 0) | (getByte64(str, 1) << 8) | (getByte64(str, 2) << 16) | (getByte64(str, 3) << 24)
+			| (getByte64(str, 4) << 32) | (getByte64(str, 5) << 40) | (getByte64(str, 6) << 48) | (getByte64(str, 7) << 56);
+	}
+
+	constexpr uint32_t mixKey32(uint32_t k)
+	{
+		return (k ^ (k >> r32)) * m32;
+	}
+
+	constexpr uint32_t finalize32(uint32_t h)
+	{
+		return ((h ^ (h >> 13)) * m32) ^ (((h ^ (h >> 13)) * m32) >> 15);
+	}
+
+	constexpr uint32_t mixTail32(const char* str, size_t len, uint32_t h)
+	{
+		return len == 3 ? (h ^ (getByte32(str, 2) << 16) ^ (getByte32(str, 1) << 8) ^ getByte32(str, 0)) * m32
+			: len == 2 ? (h ^ (getByte32(str, 1) << 8) ^ getByte32(str, 0)) * m32
+			: len == 1 ? (h ^ getByte32(str, 0)) * m32
+			: h;
+	}
+
+	constexpr uint32_t mix32(const char* str, size_t len, uint32_t h)
+	{
+		return len >= 4
+			? mix32(str + 4, len - 4, (h * m32) ^ mixKey32(read32(str) * m32))
+			: finalize32(mixTail32(str, len, h));
+	}
+
+	constexpr uint64_t mixKey64(uint64_t k)
+	{
+		return (k ^ (k >> r64)) * m64;
+	}
+
+	constexpr uint64_t finalize64(uint64_t h)
+	{
+		return ((h ^ (h >> r64)) * m64) ^ (((h ^ (h >> r64)) * m64) >> r64);
+	}
+
+	constexpr uint64_t mixTail64(const char* str, size_t len, uint64_t h)
+	{
+		return len == 0 ? h
+			: (h
+				^ (len > 6 ? getByte64(str, 6) << 48 : 0)
+				^ (len > 5 ? getByte64(str, 5) << 40 : 0)
+				^ (len > 4 ? getByte64(str, 4) << 32 : 0)
+				^ (len > 3 ? getByte64(str, 3) << 24 : 0)
+				^ (len > 2 ? getByte64(str, 2) << 16 : 0)
+				^ (len > 1 ? getByte64(str, 1) << 8 : 0)
+				^ getByte64(str, 0)) * m64;
+	}
+
+	constexpr uint64_t mix64(const char* str, size_t len, uint64_t h)
+	{
+		return len >= 8
+			? mix64(str + 8, len - 8, (h ^ mixKey64(read64(str) * m64)) * m64)
+			: finalize64(mixTail64(str, len, h));
+	}
+} // namespace MurmurInternalFn
+
+constexpr uint32_t murmur32Const(const char* str, size_t len, uint32_t seed = 0)
+{
+	return MurmurInternalFn::mix32(str, len, seed ^ uint32_t(len));
+}
+
+constexpr uint64_t murmur64Const(const char* str, size_t len, uint64_t seed = 0)
+{
+	return MurmurInternalFn::mix64(str, len, seed ^ (uint64_t(len) * MurmurInternalFn::m64));
+}
+
 } // namespace Rio
@@ -121,6 +121,30 @@
 	#define RIO_ARCH_32BIT 32
 #endif //
 
+///////////////////////////
+// SIMD instruction sets //
+///////////////////////////
+// Enabled by the compiler flags (-msse2, -mssse3, -mavx2, /arch:AVX2), no runtime detection
+#define RIO_SIMD_SSE2 0
+#define RIO_SIMD_SSSE3 0
+#define RIO_SIMD_AVX2 0
+
+#if RIO_CPU_X86
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#undef RIO_SIMD_SSE2
+		#define RIO_SIMD_SSE2 1
+	#endif
+	// MSVC has no SSSE3 switch, /arch:AVX implies it
+	#if defined(__SSSE3__) || defined(__AVX__)
+		#undef RIO_SIMD_SSSE3
+		#define RIO_SIMD_SSSE3 1
+	#endif
+	#if defined(__AVX2__)
+		#undef RIO_SIMD_AVX2
+		#define RIO_SIMD_AVX2 1
+	#endif
+#endif // RIO_CPU_X86
+
 #if RIO_CPU_PPC
 	#undef RIO_CPU_ENDIAN_BIG
 	#define RIO_CPU_ENDIAN_BIG 1
@@ -129,6 +153,12 @@
 	#define RIO_CPU_ENDIAN_LITTLE 1
 #endif
 
+#if RIO_COMPILER_MSVC
+	#define RIO_NO_INLINE __declspec(noinline)
+#else
+	#define RIO_NO_INLINE __attribute__((noinline))
+#endif // RIO_COMPILER_MSVC
+
 #if RIO_COMPILER_GCC
 	#define RIO_COMPILER_NAME "GCC"
 #elif RIO_COMPILER_MSVC
@@ -0,0 +1,442 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#pragma once
+
+#include "Core/Base/Config.h"
+#include "Core/Base/Types.h"
+
+#include "Core/Debug/Error.h" // RIO_ASSERT
+
+#include "Core/Memory/Allocator.h"
+
+#include "Core/Thread/Atomic.h"
+#include "Core/Thread/Epoch.h"
+#include "Core/Thread/Mutex.h"
+#include "Core/Thread/ScopedMutex.h"
+
+#include <cstring> // memset
+
+namespace Rio
+{
+	// Hash map for POD types shared between threads, with the uint64_t keys of HashMap<T>.
+	// The keys are spread over SHARDS_COUNT shards, each an open addressing table with its own lock.
+	//
+	// Reads take no lock: they probe the table of the shard and copy the value out of its entry.
+	// Writes lock the shard only, they never change an entry in place but link a new one,
+	// the replaced entries and tables are freed by epochs once no reader can see them (see Epoch.h).
+	// A read concurrent with a write of the same key returns the value before or after it.
+	//
+	// The allocator must be thread safe, writers of different shards allocate at the same time.
+	template <typename T>
+	struct ConcurrentHashMap
+	{
+		static const uint32_t SHARDS_COUNT = 64;
+
+		ConcurrentHashMap(Allocator& a);
+		// No thread may use the map anymore
+		~ConcurrentHashMap();
+
+		struct Entry
+		{
+			uint64_t key;
+			T value;
+		};
+
+		struct Table
+		{
+			uint32_t mask;
+			// Entry, removed entry or nullptr for the end of a probe
+			Atomic<Entry*>* slots;
+		};
+
+		struct alignas(RIO_CACHE_LINE_SIZE) Shard
+		{
+			Shard(Allocator& a)
+				: retired(a)
+				, table(nullptr)
+				, count(0)
+				, usedCount(0)
+			{
+			}
+
+			// Retired entries and tables
+			RetireList retired;
+			// Read by the readers, written under the mutex
+			Atomic<Table*> table;
+			Mutex mutex;
+			Atomic<uint32_t> count;
+			// Slots taken by entries and removed entries, the table grows before they fill it
+			uint32_t usedCount;
+		};
+
+		Allocator* allocator;
+		Shard* shards[SHARDS_COUNT];
+	private:
+		// Disable copying
+		ConcurrentHashMap(const ConcurrentHashMap&);
+		ConcurrentHashMap& operator=(const ConcurrentHashMap&);
+	};
+
+	// Safe to call from any thread at the same time
+	namespace ConcurrentHashMapFn
+	{
+		template<typename T> bool has(const ConcurrentHashMap<T>& h, uint64_t key);
+		// Returns a copy, the entry may be replaced as soon as the lookup is done
+		template<typename T> T get(const ConcurrentHashMap<T>& h, uint64_t key, const T& defaultValue);
+		// Returns whether the key exists and copies its value to value
+		template<typename T> bool tryGet(const ConcurrentHashMap<T>& h, uint64_t key, T& value);
+		template<typename T> void set(ConcurrentHashMap<T>& h, uint64_t key, const T& value);
+		// Sets the value unless the key exists, returns whether it was set
+		template<typename T> bool add(ConcurrentHashMap<T>& h, uint64_t key, const T& value);
+		template<typename T> void remove(ConcurrentHashMap<T>& h, uint64_t key);
+		// Makes room for size entries spread evenly over the shards
+		template<typename T> void reserve(ConcurrentHashMap<T>& h, size_t size);
+		template<typename T> void clear(ConcurrentHashMap<T>& h);
+		// Exact only while no thread writes
+		template<typename T> size_t getCount(const ConcurrentHashMap<T>& h);
+	} // namespace ConcurrentHashMapFn
+
+	namespace ConcurrentHashMapInternalFn
+	{
+		const uint32_t MIN_CAPACITY = 16;
+		const uint32_t NO_SLOT = UINT32_MAX;
+
+		// Ids are often sequential, the shard comes from the high bits and the slot from the low ones
+		inline uint64_t getHash(uint64_t key)
+		{
+			key ^= key >> 33;
+			key *= 0xff51afd7ed558ccdULL;
+			key ^= key >> 33;
+			key *= 0xc4ceb9fe1a85ec53ULL;
+			key ^= key >> 33;
+			return key;
+		}
+
+		template<typename T>
+		inline typename ConcurrentHashMap<T>::Shard& getShard(const ConcurrentHashMap<T>& h, uint64_t hash)
+		{
+			return *h.shards[hash >> 58];
+		}
+
+		// Marks the slots of the removed entries, entries are aligned so it is never one of them
+		template<typename T>
+		inline typename ConcurrentHashMap<T>::Entry* getRemovedEntry()
+		{
+			return (typename ConcurrentHashMap<T>::Entry*)uintptr_t(1);
+		}
+
+		// Called inside an epoch or under the lock of the shard
+		template<typename T>
+		const typename ConcurrentHashMap<T>::Entry* find(const ConcurrentHashMap<T>& h, uint64_t key)
+		{
+			const uint64_t hash = getHash(key);
+			const typename ConcurrentHashMap<T>::Table* table = getShard(h, hash).table.load(MemoryOrder::ACQUIRE);
+			if (table == nullptr)
+			{
+				return nullptr;
+			}
+			// A table is never full, the probe ends on an empty slot
+			for (uint32_t i = uint32_t(hash) & table->mask; ; i = (i + 1) & table->mask)
+			{
+				const typename ConcurrentHashMap<T>::Entry* entry = table->slots[i].load(MemoryOrder::ACQUIRE);
+				if (entry == nullptr)
+				{
+					return nullptr;
+				}
+				if (entry != getRemovedEntry<T>() && entry->key == key)
+				{
+					return entry;
+				}
+			}
+		}
+
+		template<typename T>
+		typename ConcurrentHashMap<T>::Table* allocateTable(ConcurrentHashMap<T>& h, uint32_t capacity)
+		{
+			typedef typename ConcurrentHashMap<T>::Table Table;
+			typedef typename ConcurrentHashMap<T>::Entry Entry;
+			// The slots follow the table, one allocation retired at once
+			Table* table = (Table*)h.allocator->allocate(sizeof(Table) + capacity * sizeof(Atomic<Entry*>), RIO_ALIGNOF(Table));
+			table->mask = capacity - 1;
+			table->slots = (Atomic<Entry*>*)(table + 1);
+			memset((void*)table->slots, 0, capacity * sizeof(Atomic<Entry*>));
+			return table;
+		}
+
+		// Grows the table of the shard so that it has room for usedCount slots, locked by the caller
+		template<typename T>
+		void reserveShard(ConcurrentHashMap<T>& h, typename ConcurrentHashMap<T>::Shard& shard, uint32_t usedCount)
+		{
+			typedef typename ConcurrentHashMap<T>::Table Table;
+			typedef typename ConcurrentHashMap<T>::Entry Entry;
+
+			Table* table = shard.table.load(MemoryOrder::RELAXED);
+			const uint32_t capacity = table != nullptr ? table->mask + 1 : 0;
+			// At most 3/4 full, removed entries included
+			if (usedCount * 4 <= capacity * 3)
+			{
+				return;
+			}
+
+			// The removed entries are dropped, the table is sized for the entries left
+			const uint32_t count = shard.count.load(MemoryOrder::RELAXED);
+			const uint32_t neededCount = usedCount - shard.usedCount + count;
+			uint32_t newCapacity = MIN_CAPACITY;
+			while (newCapacity * 3 < neededCount * 4 * 2)
+			{
+				newCapacity *= 2;
+			}
+
+			// The entries are moved, not copied, readers of the previous table see the same ones
+			Table* newTable = allocateTable(h, newCapacity);
+			for (uint32_t i = 0; i < capacity; ++i)
+			{
+				Entry* entry = table->slots[i].load(MemoryOrder::RELAXED);
+				if (entry == nullptr || entry == getRemovedEntry<T>())
+				{
+					continue;
+				}
+				uint32_t j = uint32_t(getHash(entry->key)) & newTable->mask;
+				while (newTable->slots[j].load(MemoryOrder::RELAXED) != nullptr)
+				{
+					j = (j + 1) & newTable->mask;
+				}
+				newTable->slots[j].store(entry, MemoryOrder::RELAXED);
+			}
+			shard.usedCount = count;
+			shard.table.store(newTable, MemoryOrder::RELEASE);
+			if (table != nullptr)
+			{
+				shard.retired.retire(table);
+			}
+		}
+
+		// Links an entry with the key and value, replacing the previous one unless onlyAdd
+		template<typename T>
+		bool set(ConcurrentHashMap<T>& h, uint64_t key, const T& value, bool onlyAdd)
+		{
+			typedef typename ConcurrentHashMap<T>::Table Table;
+			typedef typename ConcurrentHashMap<T>::Entry Entry;
+
+			const uint64_t hash = getHash(key);
+			typename ConcurrentHashMap<T>::Shard& shard = getShard(h, hash);
+			ScopedMutex lock(shard.mutex);
+
+			reserveShard(h, shard, shard.usedCount + 1);
+			Table* table = shard.table.load(MemoryOrder::RELAXED);
+
+			uint32_t freeSlot = NO_SLOT;
+			uint32_t i = uint32_t(hash) & table->mask;
+			for (; ; i = (i + 1) & table->mask)
+			{
+				Entry* entry = table->slots[i].load(MemoryOrder::RELAXED);
+				if (entry == nullptr)
+				{
+					break;
+				}
+				if (entry == getRemovedEntry<T>())
+				{
+					freeSlot = freeSlot == NO_SLOT ? i : freeSlot;
+				}
+				else if (entry->key == key)
+				{
+					if (onlyAdd)
+					{
+						return false;
+					}
+					freeSlot = i;
+					break;
+				}
+			}
+
+			Entry* newEntry = (Entry*)h.allocator->allocate(sizeof(Entry), RIO_ALIGNOF(Entry));
+			newEntry->key = key;
+			newEntry->value = value;
+
+			if (freeSlot == NO_SLOT)
+			{
+				freeSlot = i;
+				++shard.usedCount;
+			}
+			Entry* previous = table->slots[freeSlot].load(MemoryOrder::RELAXED);
+			// The entry is written before the readers can see it
+			table->slots[freeSlot].store(newEntry, MemoryOrder::RELEASE);
+			if (previous == nullptr || previous == getRemovedEntry<T>())
+			{
+				shard.count.store(shard.count.load(MemoryOrder::RELAXED) + 1, MemoryOrder::RELAXED);
+			}
+			else
+			{
+				shard.retired.retire(previous);
+			}
+			return true;
+		}
+	} // namespace ConcurrentHashMapInternalFn
+
+	namespace ConcurrentHashMapFn
+	{
+		template<typename T>
+		inline bool has(const ConcurrentHashMap<T>& h, uint64_t key)
+		{
+			ScopedEpoch epoch;
+			return ConcurrentHashMapInternalFn::find(h, key) != nullptr;
+		}
+
+		template<typename T>
+		inline T get(const ConcurrentHashMap<T>& h, uint64_t key, const T& defaultValue)
+		{
+			ScopedEpoch epoch;
+			const typename ConcurrentHashMap<T>::Entry* entry = ConcurrentHashMapInternalFn::find(h, key);
+			return entry != nullptr ? entry->value : defaultValue;
+		}
+
+		template<typename T>
+		inline bool tryGet(const ConcurrentHashMap<T>& h, uint64_t key, T& value)
+		{
+			ScopedEpoch epoch;
+			const typename ConcurrentHashMap<T>::Entry* entry = ConcurrentHashMapInternalFn::find(h, key);
+			if (entry == nullptr)
+			{
+				return false;
+			}
+			value = entry->value;
+			return true;
+		}
+
+		template<typename T>
+		inline void set(ConcurrentHashMap<T>& h, uint64_t key, const T& value)
+		{
+			ConcurrentHashMapInternalFn::set(h, key, value, false);
+		}
+
+		template<typename T>
+		inline bool add(ConcurrentHashMap<T>& h, uint64_t key, const T& value)
+		{
+			return ConcurrentHashMapInternalFn::set(h, key, value, true);
+		}
+
+		template<typename T>
+		void remove(ConcurrentHashMap<T>& h, uint64_t key)
+		{
+			typedef typename ConcurrentHashMap<T>::Table Table;
+			typedef typename ConcurrentHashMap<T>::Entry Entry;
+
+			const uint64_t hash = ConcurrentHashMapInternalFn::getHash(key);
+			typename ConcurrentHashMap<T>::Shard& shard = ConcurrentHashMapInternalFn::getShard(h, hash);
+			ScopedMutex lock(shard.mutex);
+
+			Table* table = shard.table.load(MemoryOrder::RELAXED);
+			if (table == nullptr)
+			{
+				return;
+			}
+			for (uint32_t i = uint32_t(hash) & table->mask; ; i = (i + 1) & table->mask)
+			{
+				Entry* entry = table->slots[i].load(MemoryOrder::RELAXED);
+				if (entry == nullptr)
+				{
+					return;
+				}
+				if (entry != ConcurrentHashMapInternalFn::getRemovedEntry<T>() && entry->key == key)
+				{
+					// The slot stays taken, the probes of the keys after it go on through it
+					table->slots[i].store(ConcurrentHashMapInternalFn::getRemovedEntry<T>(), MemoryOrder::RELEASE);
+					shard.count.store(shard.count.load(MemoryOrder::RELAXED) - 1, MemoryOrder::RELAXED);
+					shard.retired.retire(entry);
+					return;
+				}
+			}
+		}
+
+		template<typename T>
+		void reserve(ConcurrentHashMap<T>& h, size_t size)
+		{
+			const uint32_t shardSize = uint32_t(size / ConcurrentHashMap<T>::SHARDS_COUNT) + 1;
+			for (uint32_t i = 0; i < ConcurrentHashMap<T>::SHARDS_COUNT; ++i)
+			{
+				typename ConcurrentHashMap<T>::Shard& shard = *h.shards[i];
+				ScopedMutex lock(shard.mutex);
+				const uint32_t count = shard.count.load(MemoryOrder::RELAXED);
+				if (shardSize > count)
+				{
+					ConcurrentHashMapInternalFn::reserveShard(h, shard, shard.usedCount + shardSize - count);
+				}
+			}
+		}
+
+		template<typename T>
+		void clear(ConcurrentHashMap<T>& h)
+		{
+			typedef typename ConcurrentHashMap<T>::Table Table;
+			typedef typename ConcurrentHashMap<T>::Entry Entry;
+
+			for (uint32_t i = 0; i < ConcurrentHashMap<T>::SHARDS_COUNT; ++i)
+			{
+				typename ConcurrentHashMap<T>::Shard& shard = *h.shards[i];
+				ScopedMutex lock(shard.mutex);
+				Table* table = shard.table.load(MemoryOrder::RELAXED);
+				if (table == nullptr)
+				{
+					continue;
+				}
+				shard.table.store(nullptr, MemoryOrder::RELEASE);
+				for (uint32_t j = 0; j <= table->mask; ++j)
+				{
+					Entry* entry = table->slots[j].load(MemoryOrder::RELAXED);
+					if (entry != nullptr && entry != ConcurrentHashMapInternalFn::getRemovedEntry<T>())
+					{
+						shard.retired.retire(entry);
+					}
+				}
+				shard.retired.retire(table);
+				shard.count.store(0, MemoryOrder::RELAXED);
+				shard.usedCount = 0;
+			}
+		}
+
+		template<typename T>
+		inline size_t getCount(const ConcurrentHashMap<T>& h)
+		{
+			size_t count = 0;
+			for (uint32_t i = 0; i < ConcurrentHashMap<T>::SHARDS_COUNT; ++i)
+			{
+				count += h.shards[i]->count.load(MemoryOrder::RELAXED);
+			}
+			return count;
+		}
+	} // namespace ConcurrentHashMapFn
+
+	template <typename T>
+	inline ConcurrentHashMap<T>::ConcurrentHashMap(Allocator& a)
+		: allocator(&a)
+	{
+		for (uint32_t i = 0; i < SHARDS_COUNT; ++i)
+		{
+			shards[i] = new (a.allocate(sizeof(Shard), RIO_ALIGNOF(Shard))) Shard(a);
+		}
+	}
+
+	template <typename T>
+	inline ConcurrentHashMap<T>::~ConcurrentHashMap()
+	{
+		for (uint32_t i = 0; i < SHARDS_COUNT; ++i)
+		{
+			Shard* shard = shards[i];
+			Table* table = shard->table.load(MemoryOrder::RELAXED);
+			if (table != nullptr)
+			{
+				for (uint32_t j = 0; j <= table->mask; ++j)
+				{
+					Entry* entry = table->slots[j].load(MemoryOrder::RELAXED);
+					if (entry != nullptr && entry != ConcurrentHashMapInternalFn::getRemovedEntry<T>())
+					{
+						allocator->deallocate(entry);
+					}
+				}
+				allocator->deallocate(table);
+			}
+			// Frees the retired memory
+			allocator->makeDelete(shard);
+		}
+	}
+
+} // namespace Rio
@@ -173,17 +173,27 @@ namespace Rio
 				return;
 			}
 
-			h.hashData[fr.dataIndex] = h.hashData[ArrayFn::getCount(h.hashData) - 1];
-			FindResult last = find(h, h.hashData[fr.dataIndex].key);
+			const size_t lastIndex = ArrayFn::getCount(h.hashData) - 1;
+			h.hashData[fr.dataIndex] = h.hashData[lastIndex];
 
-			if (last.dataPrev != END_OF_LIST)
+			// Relinks the moved entry, a multi-hash may have other entries with its key
+			// so the link to lastIndex is looked for instead of the key
+			const size_t hashIndex = h.hashData[fr.dataIndex].key % ArrayFn::getCount(h.hashes);
+			if (h.hashes[hashIndex] == lastIndex)
 			{
-				h.hashData[last.dataPrev].next = fr.dataIndex;
+				h.hashes[hashIndex] = fr.dataIndex;
 			}
 			else
 			{
-				h.hashes[last.hashIndex] = fr.dataIndex;
+				size_t dataIndex = h.hashes[hashIndex];
+				while (h.hashData[dataIndex].next != lastIndex)
+				{
+					dataIndex = h.hashData[dataIndex].next;
+				}
+				h.hashData[dataIndex].next = fr.dataIndex;
 			}
+
+			ArrayFn::popBack(h.hashData);
 		}
 
 		template<typename T> size_t findOrFail(const HashMap<T>& h, uint64_t key)
@@ -240,7 +250,7 @@ namespace Rio
 
 		template<typename T> void rehash(HashMap<T>& h, size_t newSize)
 		{
-			HashMap<T> nh(*h.hashes._allocator);
+			HashMap<T> nh(*h.hashes.allocator);
 			ArrayFn::resize(nh.hashes, newSize);
 			ArrayFn::reserve(nh.hashData, ArrayFn::getCount(h.hashData));
 			for (size_t i = 0; i < newSize; ++i)
@@ -249,11 +259,11 @@ namespace Rio
 			}
 			for (size_t i = 0; i < ArrayFn::getCount(h.hashData); ++i)
 			{
-				auto& e = h.data[i];
+				auto& e = h.hashData[i];
 				MultiHashMapFn::insert(nh, e.key, e.value);
 			}
 
-			HashMap<T> empty(h.hashes.allocator);
+			HashMap<T> empty(*h.hashes.allocator);
 			h.~HashMap<T>();
 			memcpy(&h, &nh, sizeof(HashMap<T>));
 			memcpy(&nh, &empty, sizeof(HashMap<T>));
@@ -306,7 +316,7 @@ namespace Rio
 			HashMapInternalFn::findAndErase(h, key);
 		}
 
-		template<typename T> void reserve(HashMap<T>& h, uint32_t size)
+		template<typename T> void reserve(HashMap<T>& h, size_t size)
 		{
 			HashMapInternalFn::rehash(h, size);
 		}
@@ -0,0 +1,74 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#pragma once
+
+#include "Core/Base/Config.h"
+#include "Core/Base/Types.h"
+
+namespace Rio
+{
+	// Layout of the archives written by ArchiveBuilder and read by ArchiveFilesystem.
+	// The archive is mapped into memory and its tables are used in place, so every
+	// structure is little-endian and aligned to its natural alignment:
+	//
+	// ArchiveHeader
+	// the blocks of the files, each one aligned to ARCHIVE_BLOCK_ALIGNMENT
+	// ArchiveEntry[entriesCount], sorted by pathHash
+	// ArchiveBlock[blocksCount]
+	// the NUL-terminated paths of the files
+	//
+	// The contents of a file are split in blocks of blockSize bytes (the last one may be shorter),
+	// each compressed on its own with Lz4Fn so any block can be read without the previous ones.
+	// Blocks which do not get smaller are stored uncompressed.
+	const uint32_t ARCHIVE_MAGIC = 0x414f4952; // "RIOA"
+	const uint32_t ARCHIVE_VERSION = 1;
+	const uint32_t ARCHIVE_BLOCK_SIZE = 64 * 1024;
+	const uint32_t ARCHIVE_BLOCK_ALIGNMENT = 16;
+
+	struct ArchiveHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t blockSize;
+		uint32_t entriesCount;
+		uint32_t blocksCount;
+		uint32_t pathsSize;
+		uint64_t entriesOffset;
+		uint64_t blocksOffset;
+		uint64_t pathsOffset;
+	};
+
+	struct ArchiveEntry
+	{
+		// murmur64() of the path, the same as StringId64(path)
+		uint64_t pathHash;
+		uint64_t size;
+		uint64_t lastModifiedTime;
+		// Index of the first block of the file, the others follow
+		uint32_t firstBlock;
+		// Offset of the path from ArchiveHeader::pathsOffset
+		uint32_t pathOffset;
+	};
+
+	struct ArchiveBlockFlags
+	{
+		enum Enum
+		{
+			NONE = 0,
+			COMPRESSED = 1 << 0
+		};
+	};
+
+	struct ArchiveBlock
+	{
+		// Offset from the start of the archive
+		uint64_t offset;
+		// Size in the archive, the uncompressed size follows from the size of the file
+		uint32_t size;
+		uint32_t flags;
+	};
+
+	static_assert(sizeof(ArchiveHeader) == 48, "ArchiveHeader must not have padding");
+	static_assert(sizeof(ArchiveEntry) == 32, "ArchiveEntry must not have padding");
+	static_assert(sizeof(ArchiveBlock) == 16, "ArchiveBlock must not have padding");
+
+} // namespace Rio
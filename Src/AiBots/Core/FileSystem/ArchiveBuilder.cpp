@@ -0,0 +1,208 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/FileSystem/ArchiveBuilder.h"
+
+#include "Core/Base/Murmur.h"
+#include "Core/Containers/Vector.h"
+#include "Core/Debug/Error.h"
+#include "Core/FileSystem/Lz4.h"
+#include "Core/Memory/TempAllocator.h"
+#include "Core/Strings/DynamicString.h"
+#include "Core/Strings/StringUtils.h"
+#include "Core/Strings/StringView.h"
+
+#include <algorithm> // std::sort
+#include <cstring> // memset
+
+namespace Rio
+{
+	namespace
+	{
+		bool isPathHashLess(const ArchiveEntry& a, const ArchiveEntry& b)
+		{
+			return a.pathHash < b.pathHash;
+		}
+	} // namespace (anonymous)
+
+	ArchiveBuilder::ArchiveBuilder(Allocator& a, File& out)
+		: allocator(&a)
+		, out(&out)
+		, position(0)
+		, entries(a)
+		, blocks(a)
+		, paths(a)
+		, blockBuffer(nullptr)
+		, compressedBuffer(nullptr)
+		, compressedBufferSize(Lz4Fn::getMaxCompressedSize(ARCHIVE_BLOCK_SIZE))
+		, isFinished(false)
+	{
+		blockBuffer = (char*)a.allocate(ARCHIVE_BLOCK_SIZE);
+		compressedBuffer = (char*)a.allocate(compressedBufferSize);
+
+		// Written by finish()
+		ArchiveHeader header;
+		memset(&header, 0, sizeof(header));
+		write(&header, sizeof(header));
+	}
+
+	ArchiveBuilder::~ArchiveBuilder()
+	{
+		RIO_ASSERT(isFinished, "finish() must be called");
+		allocator->deallocate(compressedBuffer);
+		allocator->deallocate(blockBuffer);
+	}
+
+	void ArchiveBuilder::addFile(const char* path, const void* data, size_t size, uint64_t lastModifiedTime)
+	{
+		RIO_ASSERT(data != nullptr || size == 0, "Data must be != NULL");
+
+		addEntry(path, size, lastModifiedTime);
+		for (size_t offset = 0; offset < size; offset += ARCHIVE_BLOCK_SIZE)
+		{
+			const size_t remaining = size - offset;
+			addBlock((const char*)data + offset, remaining < ARCHIVE_BLOCK_SIZE ? remaining : ARCHIVE_BLOCK_SIZE);
+		}
+	}
+
+	void ArchiveBuilder::addFile(Filesystem& fs, const char* path)
+	{
+		File* file = fs.fileOpen(path, FileOpenMode::Read);
+		const size_t size = file->getFileSize();
+
+		addEntry(path, size, fs.getLastModifiedTime(path));
+		for (size_t offset = 0; offset < size; offset += ARCHIVE_BLOCK_SIZE)
+		{
+			const size_t remaining = size - offset;
+			const size_t blockSize = remaining < ARCHIVE_BLOCK_SIZE ? remaining : ARCHIVE_BLOCK_SIZE;
+			const size_t bytesRead = file->read(blockBuffer, blockSize);
+			RIO_ASSERT(bytesRead == blockSize, "File changed while added: %s", path);
+			RIO_UNUSED(bytesRead);
+			addBlock(blockBuffer, blockSize);
+		}
+
+		fs.fileClose(*file);
+	}
+
+	void ArchiveBuilder::addDirectory(Filesystem& fs, const char* path)
+	{
+		RIO_ASSERT_NOT_NULL(path);
+
+		Vector<DynamicString> files(*allocator);
+		fs.getFileList(path, files);
+
+		for (size_t i = 0; i < VectorFn::getCount(files); ++i)
+		{
+			// Archive paths always use '/'
+			TempAllocator256 ta;
+			DynamicString filePath(path, ta);
+			if (filePath.getLength() > 0)
+			{
+				filePath += '/';
+			}
+			filePath += files[i];
+
+			if (fs.isDirectory(filePath.toCStr()))
+			{
+				addDirectory(fs, filePath.toCStr());
+			}
+			else
+			{
+				addFile(fs, filePath.toCStr());
+			}
+		}
+	}
+
+	void ArchiveBuilder::finish()
+	{
+		RIO_ASSERT(!isFinished, "finish() was already called");
+
+		std::sort(ArrayFn::begin(entries), ArrayFn::end(entries), isPathHashLess);
+		for (uint32_t i = 1; i < ArrayFn::getCount(entries); ++i)
+		{
+			RIO_ASSERT(entries[i].pathHash != entries[i - 1].pathHash, "Same path hash: %s and %s"
+				, ArrayFn::begin(paths) + entries[i].pathOffset
+				, ArrayFn::begin(paths) + entries[i - 1].pathOffset
+				);
+		}
+
+		ArchiveHeader header;
+		header.magic = ARCHIVE_MAGIC;
+		header.version = ARCHIVE_VERSION;
+		header.blockSize = ARCHIVE_BLOCK_SIZE;
+		header.entriesCount = uint32_t(ArrayFn::getCount(entries));
+		header.blocksCount = uint32_t(ArrayFn::getCount(blocks));
+		header.pathsSize = uint32_t(ArrayFn::getCount(paths));
+
+		writePadding(RIO_ALIGNOF(ArchiveEntry));
+		header.entriesOffset = position;
+		write(ArrayFn::begin(entries), ArrayFn::getCount(entries) * sizeof(ArchiveEntry));
+		writePadding(RIO_ALIGNOF(ArchiveBlock));
+		header.blocksOffset = position;
+		write(ArrayFn::begin(blocks), ArrayFn::getCount(blocks) * sizeof(ArchiveBlock));
+		header.pathsOffset = position;
+		write(ArrayFn::begin(paths), ArrayFn::getCount(paths));
+
+		out->seek(0);
+		out->write(&header, sizeof(header));
+		out->flush();
+		isFinished = true;
+	}
+
+	void ArchiveBuilder::addEntry(const char* path, size_t size, uint64_t lastModifiedTime)
+	{
+		RIO_ASSERT_NOT_NULL(path);
+		RIO_ASSERT(!isFinished, "finish() was already called");
+		RIO_ASSERT(path[0] != '/' && StringView(path).findChar('\\') == StringView::NOT_FOUND, "Archive paths must be relative and use '/': %s", path);
+
+		const uint32_t length = strLen32(path);
+
+		ArchiveEntry entry;
+		entry.pathHash = murmur64(path, length);
+		entry.size = size;
+		entry.lastModifiedTime = lastModifiedTime;
+		entry.firstBlock = uint32_t(ArrayFn::getCount(blocks));
+		entry.pathOffset = uint32_t(ArrayFn::getCount(paths));
+		ArrayFn::pushBack(entries, entry);
+
+		ArrayFn::push(paths, path, length + 1);
+	}
+
+	void ArchiveBuilder::addBlock(const void* data, size_t size)
+	{
+		writePadding(ARCHIVE_BLOCK_ALIGNMENT);
+
+		ArchiveBlock block;
+		block.offset = position;
+
+		const size_t compressedSize = Lz4Fn::compress(data, size, compressedBuffer, compressedBufferSize);
+		if (compressedSize != 0 && compressedSize < size)
+		{
+			block.size = uint32_t(compressedSize);
+			block.flags = ArchiveBlockFlags::COMPRESSED;
+			write(compressedBuffer, compressedSize);
+		}
+		else
+		{
+			block.size = uint32_t(size);
+			block.flags = ArchiveBlockFlags::NONE;
+			write(data, size);
+		}
+		ArrayFn::pushBack(blocks, block);
+	}
+
+	void ArchiveBuilder::write(const void* data, size_t size)
+	{
+		const size_t bytesWritten = out->write(data, size);
+		RIO_ASSERT(bytesWritten == size, "Unable to write the archive");
+		RIO_UNUSED(bytesWritten);
+		position += size;
+	}
+
+	void ArchiveBuilder::writePadding(size_t alignment)
+	{
+		const char zeros[ARCHIVE_BLOCK_ALIGNMENT] = {};
+		const size_t padding = (alignment - position % alignment) % alignment;
+		RIO_ASSERT(padding <= sizeof(zeros), "Alignment too large");
+		write(zeros, padding);
+	}
+
+} // namespace Rio
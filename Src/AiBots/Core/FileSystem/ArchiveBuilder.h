@@ -0,0 +1,62 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#pragma once
+
+#include "Core/Base/Config.h"
+
+#include "Core/Containers/Array.h"
+#include "Core/FileSystem/Archive.h"
+#include "Core/FileSystem/File.h"
+#include "Core/FileSystem/FileSystem.h"
+#include "Core/Memory/Allocator.h"
+
+namespace Rio
+{
+	// Writes an archive for ArchiveFilesystem, see Archive.h for the layout.
+	// The blocks are compressed and written as the files are added,
+	// only the table of contents is kept in memory until finish().
+	//
+	// DiskFilesystem data("/home/foo/data");
+	// File* out = data.fileOpen("/home/foo/data.rioa", FileOpenMode::Write);
+	// ArchiveBuilder builder(getDefaultAllocator(), *out);
+	// builder.addDirectory(data, "");
+	// builder.finish();
+	// data.fileClose(*out);
+	class ArchiveBuilder
+	{
+	public:
+		// out must be open for writing and support seek()
+		ArchiveBuilder(Allocator& a, File& out);
+		~ArchiveBuilder();
+		// Adds a file, path follows the rules of Filesystem
+		void addFile(const char* path, const void* data, size_t size, uint64_t lastModifiedTime = 0);
+		// Adds the file of fs at the same path in the archive
+		void addFile(Filesystem& fs, const char* path);
+		// Adds the files of the directory and its subdirectories, "" is the root of fs
+		void addDirectory(Filesystem& fs, const char* path);
+		// Writes the table of contents, nothing can be added afterwards
+		void finish();
+	private:
+		void addEntry(const char* path, size_t size, uint64_t lastModifiedTime);
+		// Compresses and writes the next block of the last file added
+		void addBlock(const void* data, size_t size);
+		void write(const void* data, size_t size);
+		void writePadding(size_t alignment);
+
+		Allocator* allocator;
+		File* out;
+		size_t position;
+		Array<ArchiveEntry> entries;
+		Array<ArchiveBlock> blocks;
+		Array<char> paths;
+		// Holds a block of a file being read and its compressed version
+		char* blockBuffer;
+		char* compressedBuffer;
+		size_t compressedBufferSize;
+		bool isFinished;
+	private:
+		// Disable copying
+		ArchiveBuilder(const ArchiveBuilder&);
+		ArchiveBuilder& operator=(const ArchiveBuilder&);
+	};
+
+} // namespace Rio
@@ -0,0 +1,146 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/FileSystem/ArchiveFile.h"
+
+#include "Core/Debug/Error.h"
+#include "Core/FileSystem/Lz4.h"
+
+#include <cstring> // memcpy
+
+namespace Rio
+{
+	ArchiveFile::ArchiveFile(Allocator& a, const char* archive, const ArchiveEntry& entry)
+		: allocator(&a)
+		, archive(archive)
+		, header((const ArchiveHeader*)archive)
+		, entry(&entry)
+		, position(0)
+		, buffer(nullptr)
+		, bufferBlock(UINT32_MAX)
+	{
+	}
+
+	ArchiveFile::~ArchiveFile()
+	{
+		close();
+	}
+
+	void ArchiveFile::open(const char* path, FileOpenMode mode)
+	{
+		RIO_UNUSED(path);
+		RIO_UNUSED(mode);
+		RIO_FATAL("Archive files are opened with ArchiveFilesystem::fileOpen()");
+	}
+
+	void ArchiveFile::close()
+	{
+		allocator->deallocate(buffer);
+		buffer = nullptr;
+		bufferBlock = UINT32_MAX;
+		entry = nullptr;
+	}
+
+	void ArchiveFile::seek(size_t position)
+	{
+		RIO_ASSERT(position <= entry->size, "Position out of bounds");
+		this->position = position;
+	}
+
+	void ArchiveFile::seekToEnd()
+	{
+		position = size_t(entry->size);
+	}
+
+	void ArchiveFile::skip(size_t bytes)
+	{
+		RIO_ASSERT(position + bytes <= entry->size, "Position out of bounds");
+		position += bytes;
+	}
+
+	size_t ArchiveFile::read(void* data, size_t size)
+	{
+		RIO_ASSERT_NOT_NULL(data);
+
+		const size_t blockSize = header->blockSize;
+		const size_t fileSize = size_t(entry->size);
+		const size_t toRead = position + size <= fileSize ? size : fileSize - position;
+
+		size_t bytesRead = 0;
+		while (bytesRead < toRead)
+		{
+			const uint32_t block = uint32_t(position / blockSize);
+			const size_t offset = position % blockSize;
+			size_t count = blockSize - offset;
+			if (count > toRead - bytesRead)
+			{
+				count = toRead - bytesRead;
+			}
+
+			memcpy((char*)data + bytesRead, getBlockData(block) + offset, count);
+			bytesRead += count;
+			position += count;
+		}
+		return bytesRead;
+	}
+
+	size_t ArchiveFile::write(const void* data, size_t size)
+	{
+		RIO_UNUSED(data);
+		RIO_UNUSED(size);
+		RIO_FATAL("Archive files are read-only");
+		return 0;
+	}
+
+	void ArchiveFile::flush()
+	{
+	}
+
+	bool ArchiveFile::isValid()
+	{
+		return entry != nullptr;
+	}
+
+	bool ArchiveFile::getIsEndOfFile()
+	{
+		return position == entry->size;
+	}
+
+	size_t ArchiveFile::getFileSize()
+	{
+		return size_t(entry->size);
+	}
+
+	size_t ArchiveFile::getFilePosition()
+	{
+		return position;
+	}
+
+	const char* ArchiveFile::getBlockData(uint32_t block)
+	{
+		const ArchiveBlock* blocks = (const ArchiveBlock*)(archive + header->blocksOffset);
+		const ArchiveBlock& archiveBlock = blocks[entry->firstBlock + block];
+		const char* blockData = archive + archiveBlock.offset;
+
+		if ((archiveBlock.flags & ArchiveBlockFlags::COMPRESSED) == 0)
+		{
+			return blockData;
+		}
+
+		if (block != bufferBlock)
+		{
+			if (buffer == nullptr)
+			{
+				buffer = (char*)allocator->allocate(header->blockSize);
+			}
+
+			const size_t blockStart = size_t(block) * header->blockSize;
+			const size_t remaining = size_t(entry->size) - blockStart;
+			const size_t blockSize = remaining < header->blockSize ? remaining : header->blockSize;
+			const bool isValid = Lz4Fn::decompress(blockData, archiveBlock.size, buffer, blockSize);
+			RIO_ASSERT(isValid, "Corrupted archive block");
+			RIO_UNUSED(isValid);
+			bufferBlock = block;
+		}
+		return buffer;
+	}
+
+} // namespace Rio
@@ -0,0 +1,54 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#pragma once
+
+#include "Core/Base/Config.h"
+
+#include "Core/FileSystem/Archive.h"
+#include "Core/FileSystem/File.h"
+#include "Core/Memory/Allocator.h"
+
+namespace Rio
+{
+	// Read-only file in an archive mapped into memory, opened by ArchiveFilesystem.
+	// Uncompressed blocks are copied straight from the mapping,
+	// compressed ones are decompressed to a block-sized buffer which is kept
+	// until a read moves to another block.
+	class ArchiveFile : public File
+	{
+	public:
+		// archive is the start of the mapped archive, it must outlive the file
+		ArchiveFile(Allocator& a, const char* archive, const ArchiveEntry& entry);
+		virtual ~ArchiveFile();
+		// Files are opened by ArchiveFilesystem
+		void open(const char* path, FileOpenMode mode);
+		void close();
+		void seek(size_t position);
+		void seekToEnd();
+		void skip(size_t bytes);
+		size_t read(void* data, size_t size);
+		// Archives are read-only
+		size_t write(const void* data, size_t size);
+		void flush();
+		bool isValid();
+		bool getIsEndOfFile();
+		size_t getFileSize();
+		size_t getFilePosition();
+	private:
+		// Returns the uncompressed contents of the block
+		const char* getBlockData(uint32_t block);
+
+		Allocator* allocator;
+		const char* archive;
+		const ArchiveHeader* header;
+		const ArchiveEntry* entry;
+		size_t position;
+		// Decompressed block, allocated on the first read of a compressed block
+		char* buffer;
+		uint32_t bufferBlock;
+	private:
+		// Disable copying
+		ArchiveFile(const ArchiveFile&);
+		ArchiveFile& operator=(const ArchiveFile&);
+	};
+
+} // namespace Rio
@@ -0,0 +1,211 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/FileSystem/ArchiveFileSystem.h"
+
+#include "Core/Base/Murmur.h"
+#include "Core/Debug/Error.h"
+#include "Core/FileSystem/ArchiveFile.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Strings/Path.h"
+#include "Core/Strings/StringUtils.h"
+#include "Core/Strings/StringView.h"
+
+namespace Rio
+{
+	ArchiveFilesystem::ArchiveFilesystem(const char* archivePath)
+		: archivePath(archivePath)
+		, header(nullptr)
+		, entries(nullptr)
+	{
+		archive.open(archivePath, FileOpenMode::Read);
+		RIO_ASSERT(archive.getSize() >= sizeof(ArchiveHeader), "Not an archive: %s", archivePath);
+
+		header = (const ArchiveHeader*)archive.getData();
+		RIO_ASSERT(header->magic == ARCHIVE_MAGIC, "Not an archive: %s", archivePath);
+		RIO_ASSERT(header->version == ARCHIVE_VERSION, "Unsupported archive version %u: %s", header->version, archivePath);
+		RIO_ASSERT(header->pathsOffset + header->pathsSize <= archive.getSize(), "Truncated archive: %s", archivePath);
+		entries = (const ArchiveEntry*)(archive.getData() + header->entriesOffset);
+
+		// The table of contents is read on every open, the blocks only when files are read
+		archive.advise(FileAccessPattern::WILL_NEED, size_t(header->entriesOffset), size_t(header->pathsOffset + header->pathsSize - header->entriesOffset));
+		archive.advise(FileAccessPattern::RANDOM, 0, size_t(header->entriesOffset));
+	}
+
+	File* ArchiveFilesystem::fileOpen(const char* path, FileOpenMode mode)
+	{
+		RIO_ASSERT_NOT_NULL(path);
+		RIO_ASSERT(mode == FileOpenMode::Read, "Archives are read-only");
+		RIO_UNUSED(mode);
+
+		return fileOpen(StringId64(path));
+	}
+
+	File* ArchiveFilesystem::fileOpen(StringId64 path)
+	{
+		const ArchiveEntry* entry = findEntry(path.getId());
+		RIO_ASSERT(entry != nullptr, "File not found in archive");
+
+		return getDefaultAllocator().makeNew<ArchiveFile>(getDefaultAllocator(), archive.getData(), *entry);
+	}
+
+	void ArchiveFilesystem::fileClose(File& file)
+	{
+		getDefaultAllocator().makeDelete(&file);
+	}
+
+	MappedFile* ArchiveFilesystem::mapFile(const char* path)
+	{
+		RIO_UNUSED(path);
+		RIO_FATAL("Files in archives cannot be mapped, use fileOpen()");
+		return nullptr;
+	}
+
+	void ArchiveFilesystem::unmapFile(MappedFile& file)
+	{
+		RIO_UNUSED(file);
+		RIO_FATAL("Files in archives cannot be mapped, use fileOpen()");
+	}
+
+	bool ArchiveFilesystem::doesPathExist(const char* path)
+	{
+		return isFile(path) || isDirectory(path);
+	}
+
+	bool ArchiveFilesystem::isDirectory(const char* path)
+	{
+		RIO_ASSERT_NOT_NULL(path);
+
+		const StringView directory(path);
+		if (directory.getIsEmpty())
+		{
+			return true;
+		}
+
+		for (uint32_t i = 0; i < header->entriesCount; ++i)
+		{
+			const StringView filePath(getPath(entries[i]));
+			if (filePath.getLength() > directory.getLength()
+				&& filePath.startsWith(directory)
+				&& filePath[directory.getLength()] == '/')
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool ArchiveFilesystem::isFile(const char* path)
+	{
+		RIO_ASSERT_NOT_NULL(path);
+		return isFile(StringId64(path));
+	}
+
+	bool ArchiveFilesystem::isFile(StringId64 path)
+	{
+		return findEntry(path.getId()) != nullptr;
+	}
+
+	uint64_t ArchiveFilesystem::getLastModifiedTime(const char* path)
+	{
+		RIO_ASSERT_NOT_NULL(path);
+
+		const ArchiveEntry* entry = findEntry(StringId64(path).getId());
+		RIO_ASSERT(entry != nullptr, "File not found in archive: %s", path);
+		return entry->lastModifiedTime;
+	}
+
+	void ArchiveFilesystem::createDirectory(const char* path)
+	{
+		RIO_UNUSED(path);
+		RIO_FATAL("Archives are read-only");
+	}
+
+	void ArchiveFilesystem::deleteDirectory(const char* path)
+	{
+		RIO_UNUSED(path);
+		RIO_FATAL("Archives are read-only");
+	}
+
+	void ArchiveFilesystem::createFile(const char* path)
+	{
+		RIO_UNUSED(path);
+		RIO_FATAL("Archives are read-only");
+	}
+
+	void ArchiveFilesystem::deleteFile(const char* path)
+	{
+		RIO_UNUSED(path);
+		RIO_FATAL("Archives are read-only");
+	}
+
+	void ArchiveFilesystem::getFileList(const char* path, Vector<DynamicString>& files)
+	{
+		RIO_ASSERT_NOT_NULL(path);
+
+		const StringView directory(path);
+		const size_t prefixLength = directory.getIsEmpty() ? 0 : directory.getLength() + 1;
+
+		for (uint32_t i = 0; i < header->entriesCount; ++i)
+		{
+			const StringView filePath(getPath(entries[i]));
+			if (filePath.getLength() <= prefixLength
+				|| !filePath.startsWith(directory)
+				|| (prefixLength > 0 && filePath[directory.getLength()] != '/'))
+			{
+				continue;
+			}
+
+			// Files in subdirectories give the name of the subdirectory
+			StringView name = filePath.getSubstring(prefixLength);
+			const size_t separator = name.findChar('/');
+			if (separator != StringView::NOT_FOUND)
+			{
+				name = name.getSubstring(0, separator);
+			}
+
+			bool isListed = false;
+			for (size_t j = 0; j < VectorFn::getCount(files) && !isListed; ++j)
+			{
+				isListed = files[j] == name;
+			}
+			if (!isListed)
+			{
+				DynamicString fileName(name, getDefaultAllocator());
+				VectorFn::pushBack(files, fileName);
+			}
+		}
+	}
+
+	void ArchiveFilesystem::getAbsolutePath(const char* path, DynamicString& osPath)
+	{
+		PathFn::joinPaths(archivePath.toCStr(), path, osPath);
+	}
+
+	const ArchiveEntry* ArchiveFilesystem::findEntry(uint64_t pathHash) const
+	{
+		uint32_t first = 0;
+		uint32_t last = header->entriesCount;
+		while (first < last)
+		{
+			const uint32_t middle = first + (last - first) / 2;
+			if (entries[middle].pathHash < pathHash)
+			{
+				first = middle + 1;
+			}
+			else
+			{
+				last = middle;
+			}
+		}
+		if (first < header->entriesCount && entries[first].pathHash == pathHash)
+		{
+			return &entries[first];
+		}
+		return nullptr;
+	}
+
+	const char* ArchiveFilesystem::getPath(const ArchiveEntry& entry) const
+	{
+		return archive.getData() + header->pathsOffset + entry.pathOffset;
+	}
+
+} // namespace Rio
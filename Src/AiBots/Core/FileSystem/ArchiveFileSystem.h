@@ -0,0 +1,64 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#pragma once
+
+#include "Core/Base/Config.h"
+
+#include "Core/FileSystem/Archive.h"
+#include "Core/FileSystem/FileSystem.h"
+#include "Core/FileSystem/MappedFile.h"
+#include "Core/Strings/StringId64.h"
+
+namespace Rio
+{
+	// Read-only access to the files of an archive written by ArchiveBuilder.
+	// The archive is mapped once and its table of contents is used in place,
+	// opening a file is a binary search of its path hash, without any system call.
+	// Paths follow the rules of Filesystem, the root is the root of the archive.
+	class ArchiveFilesystem : public Filesystem
+	{
+	public:
+		// Maps the archive at the given OS path, which must be absolute
+		ArchiveFilesystem(const char* archivePath);
+		using Filesystem::fileOpen;
+		using Filesystem::doesPathExist;
+		using Filesystem::isDirectory;
+		using Filesystem::isFile;
+		using Filesystem::getAbsolutePath;
+		// mode must be FileOpenMode::Read
+		File* fileOpen(const char* path, FileOpenMode mode);
+		// Opens the file whose path hashes to path, e.g. a path id computed at compile time
+		File* fileOpen(StringId64 path);
+		void fileClose(File& file);
+		// Not supported, the files of an archive are opened with fileOpen()
+		MappedFile* mapFile(const char* path);
+		void unmapFile(MappedFile& file);
+		bool doesPathExist(const char* path);
+		// Returns true if path is a directory, i.e. the prefix of the path of a file.
+		// Slower than isFile(), the paths are searched linearly.
+		bool isDirectory(const char* path);
+		// Returns true if path is a regular file.
+		bool isFile(const char* path);
+		bool isFile(StringId64 path);
+		// Returns the time of the file when the archive was built.
+		uint64_t getLastModifiedTime(const char* path);
+		// Archives are read-only
+		void createDirectory(const char* path);
+		void deleteDirectory(const char* path);
+		void createFile(const char* path);
+		void deleteFile(const char* path);
+		// Returns the relative file names in the given path, "" is the root of the archive.
+		void getFileList(const char* path, Vector<DynamicString>& files);
+		// Returns the path of the archive joined with the given path.
+		void getAbsolutePath(const char* path, DynamicString& osPath);
+	private:
+		// Returns nullptr if there is no such file
+		const ArchiveEntry* findEntry(uint64_t pathHash) const;
+		const char* getPath(const ArchiveEntry& entry) const;
+
+		DynamicString archivePath;
+		MappedFile archive;
+		const ArchiveHeader* header;
+		const ArchiveEntry* entries;
+	};
+
+} // namespace Rio
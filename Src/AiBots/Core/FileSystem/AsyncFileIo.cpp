@@ -0,0 +1,324 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/FileSystem/AsyncFileIo.h"
+
+#include "Core/Debug/Error.h"
+#include "Core/Memory/TempAllocator.h"
+#include "Core/Thread/JobSystem.h"
+#include "Core/Thread/ScopedMutex.h"
+
+namespace Rio
+{
+	AsyncFileIo::AsyncFileIo(Allocator& a, uint32_t threadsCount, uint32_t queueDepth)
+		: allocator(&a)
+		, done(a)
+		, waitersCount(0)
+		, isStopping(false)
+		, ioUring(nullptr)
+		, threads(a)
+	{
+		for (uint32_t i = 0; i < AsyncIoPriority::COUNT; ++i)
+		{
+			pending[i] = a.makeNew<Queue<uint32_t>>(a);
+		}
+
+		if (createIoUring(queueDepth))
+		{
+			return;
+		}
+
+		RIO_ASSERT(threadsCount > 0, "At least one thread is needed");
+		for (uint32_t i = 0; i < threadsCount; ++i)
+		{
+			Thread* thread = a.makeNew<Thread>();
+			thread->start(workerMain, this);
+			ArrayFn::pushBack(threads, thread);
+		}
+	}
+
+	AsyncFileIo::~AsyncFileIo()
+	{
+		{
+			ScopedMutex sm(mutex);
+			isStopping = true;
+
+			// Nothing new is started, the requests in progress are finished
+			for (uint32_t i = 0; i < AsyncIoPriority::COUNT; ++i)
+			{
+				while (!QueueFn::getIsEmpty(*pending[i]))
+				{
+					Id id;
+					id.decode(QueueFn::front(*pending[i]));
+					QueueFn::popFront(*pending[i]);
+					if (IdArrayFn::has(requests, id))
+					{
+						IdArrayFn::get(requests, id).status = AsyncIoStatus::CANCELED;
+					}
+				}
+			}
+		}
+
+		if (ioUring != nullptr)
+		{
+			destroyIoUring();
+		}
+
+		pendingSemaphore.post(uint32_t(ArrayFn::getCount(threads)));
+		for (uint32_t i = 0; i < ArrayFn::getCount(threads); ++i)
+		{
+			threads[i]->stop();
+			allocator->makeDelete(threads[i]);
+		}
+
+		for (uint32_t i = 0; i < AsyncIoPriority::COUNT; ++i)
+		{
+			allocator->makeDelete(pending[i]);
+		}
+	}
+
+	Id AsyncFileIo::read(const AsyncReadRequest& params)
+	{
+		RIO_ASSERT_NOT_NULL(params.file);
+		RIO_ASSERT_NOT_NULL(params.data);
+		RIO_ASSERT(params.priority < AsyncIoPriority::COUNT, "Unknown priority");
+
+		Request request;
+		request.params = params;
+		request.bytesRead = 0;
+		request.status = AsyncIoStatus::PENDING;
+
+		Id id;
+		{
+			ScopedMutex sm(mutex);
+			RIO_ASSERT(!isStopping, "AsyncFileIo is being destroyed");
+			id = IdArrayFn::create(requests, request);
+			QueueFn::pushBack(*pending[params.priority], id.encode());
+		}
+
+		if (ioUring != nullptr)
+		{
+			wakeIoUring();
+		}
+		else
+		{
+			pendingSemaphore.post();
+		}
+		return id;
+	}
+
+	bool AsyncFileIo::cancel(Id id)
+	{
+		ScopedMutex sm(mutex);
+		RIO_ASSERT(IdArrayFn::has(requests, id), "Unknown request");
+
+		Request& request = IdArrayFn::get(requests, id);
+		if (request.status != AsyncIoStatus::PENDING)
+		{
+			return false;
+		}
+
+		// The id stays in the pending queue and is skipped when popped
+		request.status = AsyncIoStatus::CANCELED;
+		if (request.params.callback != nullptr)
+		{
+			ArrayFn::pushBack(done, id.encode());
+		}
+		if (waitersCount > 0)
+		{
+			doneSemaphore.post(waitersCount);
+			waitersCount = 0;
+		}
+		return true;
+	}
+
+	AsyncIoStatus::Enum AsyncFileIo::getStatus(Id id)
+	{
+		ScopedMutex sm(mutex);
+		RIO_ASSERT(IdArrayFn::has(requests, id), "Unknown request");
+		return IdArrayFn::get(requests, id).status;
+	}
+
+	size_t AsyncFileIo::getBytesRead(Id id)
+	{
+		ScopedMutex sm(mutex);
+		RIO_ASSERT(IdArrayFn::has(requests, id), "Unknown request");
+		return IdArrayFn::get(requests, id).bytesRead;
+	}
+
+	AsyncIoStatus::Enum AsyncFileIo::wait(Id id)
+	{
+		mutex.lock();
+		RIO_ASSERT(IdArrayFn::has(requests, id), "Unknown request");
+		RIO_ASSERT(IdArrayFn::get(requests, id).params.callback == nullptr, "Requests with callbacks are freed by update()");
+
+		AsyncIoStatus::Enum status = IdArrayFn::get(requests, id).status;
+		while (status == AsyncIoStatus::PENDING || status == AsyncIoStatus::IN_PROGRESS)
+		{
+			++waitersCount;
+			mutex.unlock();
+			doneSemaphore.wait();
+			mutex.lock();
+			status = IdArrayFn::get(requests, id).status;
+		}
+		mutex.unlock();
+		return status;
+	}
+
+	AsyncIoStatus::Enum AsyncFileIo::wait(JobSystem& jobSystem, Id id)
+	{
+		{
+			ScopedMutex sm(mutex);
+			RIO_ASSERT(IdArrayFn::has(requests, id), "Unknown request");
+			RIO_ASSERT(IdArrayFn::get(requests, id).params.callback == nullptr, "Requests with callbacks are freed by update()");
+		}
+
+		Waiter waiter;
+		waiter.asyncFileIo = this;
+		waiter.request = id;
+		jobSystem.waitUntil(isRequestDone, &waiter);
+		return getStatus(id);
+	}
+
+	bool AsyncFileIo::isRequestDone(void* data)
+	{
+		const Waiter& waiter = *(const Waiter*)data;
+		const AsyncIoStatus::Enum status = waiter.asyncFileIo->getStatus(waiter.request);
+		return status != AsyncIoStatus::PENDING && status != AsyncIoStatus::IN_PROGRESS;
+	}
+
+	void AsyncFileIo::release(Id id)
+	{
+		ScopedMutex sm(mutex);
+		RIO_ASSERT(IdArrayFn::has(requests, id), "Unknown request");
+
+		const Request& request = IdArrayFn::get(requests, id);
+		RIO_ASSERT(request.params.callback == nullptr, "Requests with callbacks are freed by update()");
+		RIO_ASSERT(request.status != AsyncIoStatus::PENDING && request.status != AsyncIoStatus::IN_PROGRESS, "Request is not done");
+		RIO_UNUSED(request);
+		IdArrayFn::destroy(requests, id);
+	}
+
+	void AsyncFileIo::update()
+	{
+		TempAllocator1024 ta;
+		Array<uint32_t> ids(ta);
+		{
+			ScopedMutex sm(mutex);
+			ArrayFn::push(ids, ArrayFn::begin(done), ArrayFn::getCount(done));
+			ArrayFn::clear(done);
+		}
+
+		for (uint32_t i = 0; i < ArrayFn::getCount(ids); ++i)
+		{
+			Id id;
+			id.decode(ids[i]);
+
+			Request request;
+			{
+				ScopedMutex sm(mutex);
+				request = IdArrayFn::get(requests, id);
+				IdArrayFn::destroy(requests, id);
+			}
+			// Called without the lock, the callback may queue new reads
+			request.params.callback(id, request.status, request.bytesRead, request.params.userData);
+		}
+	}
+
+	bool AsyncFileIo::getIsIoUringUsed() const
+	{
+		return ioUring != nullptr;
+	}
+
+	bool AsyncFileIo::popPending(Id& id, AsyncReadRequest& params)
+	{
+		ScopedMutex sm(mutex);
+		for (uint32_t i = 0; i < AsyncIoPriority::COUNT; ++i)
+		{
+			while (!QueueFn::getIsEmpty(*pending[i]))
+			{
+				id.decode(QueueFn::front(*pending[i]));
+				QueueFn::popFront(*pending[i]);
+
+				// Canceled and possibly already freed
+				if (!IdArrayFn::has(requests, id))
+				{
+					continue;
+				}
+				Request& request = IdArrayFn::get(requests, id);
+				if (request.status != AsyncIoStatus::PENDING)
+				{
+					continue;
+				}
+
+				request.status = AsyncIoStatus::IN_PROGRESS;
+				params = request.params;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void AsyncFileIo::complete(Id id, size_t bytesRead, AsyncIoStatus::Enum status)
+	{
+		ScopedMutex sm(mutex);
+		Request& request = IdArrayFn::get(requests, id);
+		request.bytesRead = bytesRead;
+		request.status = status;
+		if (request.params.callback != nullptr)
+		{
+			ArrayFn::pushBack(done, id.encode());
+		}
+		if (waitersCount > 0)
+		{
+			doneSemaphore.post(waitersCount);
+			waitersCount = 0;
+		}
+	}
+
+	int32_t AsyncFileIo::workerMain(void* data)
+	{
+		AsyncFileIo* io = (AsyncFileIo*)data;
+		while (true)
+		{
+			// One post per queued request, canceled ones included
+			io->pendingSemaphore.wait();
+
+			Id id;
+			AsyncReadRequest params;
+			if (io->popPending(id, params))
+			{
+				const size_t bytesRead = params.file->readAt(params.data, params.size, params.offset);
+				io->complete(id, bytesRead, AsyncIoStatus::COMPLETED);
+				continue;
+			}
+
+			ScopedMutex sm(io->mutex);
+			if (io->isStopping)
+			{
+				return 0;
+			}
+		}
+	}
+
+#if !RIO_IO_URING
+	bool AsyncFileIo::createIoUring(uint32_t queueDepth)
+	{
+		RIO_UNUSED(queueDepth);
+		return false;
+	}
+
+	void AsyncFileIo::destroyIoUring()
+	{
+	}
+
+	void AsyncFileIo::wakeIoUring()
+	{
+	}
+
+	int32_t AsyncFileIo::ioUringMain(void* data)
+	{
+		RIO_UNUSED(data);
+		return 0;
+	}
+#endif // !RIO_IO_URING
+
+} // namespace Rio
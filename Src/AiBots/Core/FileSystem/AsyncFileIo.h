@@ -0,0 +1,147 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#pragma once
+
+#include "Core/Base/Config.h"
+#include "Core/Base/Types.h"
+#include "Core/Base/Id.h"
+
+#include "Core/Memory/Allocator.h"
+#include "Core/Containers/Array.h"
+#include "Core/Containers/Queue.h"
+#include "Core/Containers/IdArray.h"
+#include "Core/FileSystem/OsFile.h"
+#include "Core/Thread/Mutex.h"
+#include "Core/Thread/Semaphore.h"
+#include "Core/Thread/Thread.h"
+
+namespace Rio
+{
+	class JobSystem;
+
+	struct AsyncIoPriority
+	{
+		enum Enum
+		{
+			HIGH,
+			NORMAL,
+			LOW,
+
+			COUNT
+		};
+	};
+
+	struct AsyncIoStatus
+	{
+		enum Enum
+		{
+			PENDING,
+			IN_PROGRESS,
+			COMPLETED,
+			FAILED,
+			CANCELED
+		};
+	};
+
+	// Called by AsyncFileIo::update() on the thread that calls update()
+	typedef void (*AsyncIoCallback)(Id request, AsyncIoStatus::Enum status, size_t bytesRead, void* userData);
+
+	struct AsyncReadRequest
+	{
+		// Must stay open until the request is done
+		const OsFile* file;
+		// Must stay valid until the request is done, aligned as OsFile::readAt() requires
+		void* data;
+		size_t size;
+		size_t offset;
+		AsyncIoPriority::Enum priority;
+		// Optional
+		AsyncIoCallback callback;
+		void* userData;
+	};
+
+	// Reads files without blocking the calling thread.
+	// Uses io_uring on Linux when the kernel supports it (RIO_IO_URING),
+	// a fixed pool of threads calling OsFile::readAt() otherwise.
+	// Pending requests are started by priority, in submission order within a priority.
+	//
+	// A request is either polled with getStatus() or wait() and then freed with release(),
+	// or given a callback, which is called by update() once it is done and then freed automatically.
+	class AsyncFileIo
+	{
+	public:
+		static const uint32_t MAX_REQUESTS = 1024;
+
+		// threadsCount is the number of threads of the fallback pool.
+		// queueDepth is the maximum number of reads in flight with io_uring.
+		AsyncFileIo(Allocator& a, uint32_t threadsCount = 2, uint32_t queueDepth = 64);
+		// Cancels the pending requests and waits for the ones in progress
+		~AsyncFileIo();
+
+		// Queues the read and returns its handle
+		Id read(const AsyncReadRequest& request);
+		// Cancels the request if it has not started yet, returns whether it was canceled
+		bool cancel(Id request);
+		AsyncIoStatus::Enum getStatus(Id request);
+		// Returns the number of bytes read, less than the requested size at the end of the file
+		size_t getBytesRead(Id request);
+		// Blocks until the request is done and returns its status
+		AsyncIoStatus::Enum wait(Id request);
+		// Same but suspends the calling job instead of blocking its thread, see JobSystem::waitUntil()
+		AsyncIoStatus::Enum wait(JobSystem& jobSystem, Id request);
+		// Frees a request without callback, it must be done
+		void release(Id request);
+		// Calls the callbacks of the requests done since the last call
+		void update();
+		// Returns whether reads are done with io_uring
+		bool getIsIoUringUsed() const;
+
+	private:
+		struct Request
+		{
+			AsyncReadRequest params;
+			size_t bytesRead;
+			AsyncIoStatus::Enum status;
+		};
+
+		struct Waiter
+		{
+			AsyncFileIo* asyncFileIo;
+			Id request;
+		};
+
+		static bool isRequestDone(void* data);
+		// Returns the next pending request marked as in progress or false if there are none
+		bool popPending(Id& id, AsyncReadRequest& params);
+		void complete(Id id, size_t bytesRead, AsyncIoStatus::Enum status);
+		static int32_t workerMain(void* data);
+
+		// io_uring backend, see Posix/AsyncFileIo_Posix.cpp
+		struct IoUring;
+		bool createIoUring(uint32_t queueDepth);
+		void destroyIoUring();
+		void wakeIoUring();
+		static int32_t ioUringMain(void* data);
+
+		Allocator* allocator;
+		Mutex mutex;
+		IdArray<MAX_REQUESTS, Request> requests;
+		// Encoded ids of the pending requests, the canceled ones are skipped
+		Queue<uint32_t>* pending[AsyncIoPriority::COUNT];
+		// Encoded ids of the requests with callbacks which are done
+		Array<uint32_t> done;
+		// Posted once per pending request for the thread pool
+		Semaphore pendingSemaphore;
+		// Posted once per waiter registered in waitersCount when a request is done
+		Semaphore doneSemaphore;
+		uint32_t waitersCount;
+		bool isStopping;
+
+		IoUring* ioUring;
+		Array<Thread*> threads;
+	private:
+		// Disable copying
+		AsyncFileIo(const AsyncFileIo&);
+		AsyncFileIo& operator=(const AsyncFileIo&);
+	};
+
+} // namespace Rio
@@ -0,0 +1,431 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/FileSystem/DirectoryScanner.h"
+
+#include "Core/Base/Murmur.h"
+#include "Core/Debug/Error.h"
+#include "Core/FileSystem/DiskFile.h"
+#include "Core/FileSystem/FileBinaryReader.h"
+#include "Core/FileSystem/FileBinaryWriter.h"
+#include "Core/Thread/ScopedMutex.h"
+#include "Core/Thread/Thread.h"
+
+#include <algorithm> // std::sort
+#include <cstring> // memcpy, strcmp
+
+namespace Rio
+{
+	namespace
+	{
+		// Paths are copied to chunks of this size, longer paths get their own chunk
+		const size_t CHUNK_SIZE = 64 * 1024;
+		const uint32_t CACHE_MAGIC = 0x434f4952; // "RIOC"
+		const uint32_t CACHE_VERSION = 1;
+
+		bool isPathLess(const DirectoryEntry& a, const DirectoryEntry& b)
+		{
+			return strcmp(a.path, b.path) < 0;
+		}
+	} // namespace (anonymous)
+
+	DirectoryScanner::Worker::Worker(Allocator& a)
+		: scanner(nullptr)
+		, entries(a)
+		, listings(a)
+		, chunks(nullptr)
+		, chunkPosition(nullptr)
+		, chunkRemaining(0)
+		, cachedDirectoriesCount(0)
+	{
+	}
+
+	DirectoryScanner::DirectoryScanner(Allocator& a, uint32_t threadsCount)
+		: allocator(&a)
+		, threadsCount(threadsCount)
+		, entries(a)
+		, workers(a)
+		, pending(a)
+		, pendingCount(0)
+		, isDone(false)
+		, cache(nullptr)
+		, cacheIndices(a)
+	{
+		RIO_ASSERT(threadsCount > 0, "At least one thread is needed");
+	}
+
+	DirectoryScanner::~DirectoryScanner()
+	{
+		for (uint32_t i = 0; i < ArrayFn::getCount(workers); ++i)
+		{
+			freeChunks(*allocator, *workers[i]);
+			allocator->makeDelete(workers[i]);
+		}
+	}
+
+	bool DirectoryScanner::scan(const char* osPath, const char* cacheOsPath)
+	{
+		RIO_ASSERT_NOT_NULL(osPath);
+
+		ArrayFn::clear(entries);
+		for (uint32_t i = 0; i < ArrayFn::getCount(workers); ++i)
+		{
+			freeChunks(*allocator, *workers[i]);
+			allocator->makeDelete(workers[i]);
+		}
+		ArrayFn::clear(workers);
+
+		PendingDirectory root;
+		root.path = "";
+		root.pathLength = 0;
+		if (!openRoot(osPath, root.lastModifiedTime))
+		{
+			return false;
+		}
+
+		if (cacheOsPath != nullptr && getIsFile(cacheOsPath))
+		{
+			readCache(cacheOsPath, osPath);
+		}
+
+		ArrayFn::pushBack(pending, root);
+		pendingCount = 1;
+		isDone = false;
+		semaphore.post();
+
+		Array<Thread*> threads(*allocator);
+		for (uint32_t i = 0; i < threadsCount; ++i)
+		{
+			Worker* worker = allocator->makeNew<Worker>(*allocator);
+			worker->scanner = this;
+			ArrayFn::pushBack(workers, worker);
+
+			Thread* thread = allocator->makeNew<Thread>();
+			thread->start(workerMain, worker);
+			ArrayFn::pushBack(threads, thread);
+		}
+		for (uint32_t i = 0; i < threadsCount; ++i)
+		{
+			threads[i]->stop();
+			allocator->makeDelete(threads[i]);
+		}
+		closeRoot();
+
+		size_t entriesCount = 0;
+		for (uint32_t i = 0; i < threadsCount; ++i)
+		{
+			entriesCount += ArrayFn::getCount(workers[i]->entries);
+		}
+		ArrayFn::reserve(entries, entriesCount);
+		for (uint32_t i = 0; i < threadsCount; ++i)
+		{
+			ArrayFn::push(entries, ArrayFn::begin(workers[i]->entries), ArrayFn::getCount(workers[i]->entries));
+		}
+		std::sort(ArrayFn::begin(entries), ArrayFn::end(entries), isPathLess);
+
+		if (cacheOsPath != nullptr)
+		{
+			writeCache(cacheOsPath, osPath);
+		}
+		freeCache();
+		return true;
+	}
+
+	const Array<DirectoryEntry>& DirectoryScanner::getEntries() const
+	{
+		return entries;
+	}
+
+	uint32_t DirectoryScanner::getCachedDirectoriesCount() const
+	{
+		uint32_t count = 0;
+		for (uint32_t i = 0; i < ArrayFn::getCount(workers); ++i)
+		{
+			count += workers[i]->cachedDirectoriesCount;
+		}
+		return count;
+	}
+
+	int32_t DirectoryScanner::workerMain(void* data)
+	{
+		Worker& worker = *(Worker*)data;
+		DirectoryScanner& scanner = *worker.scanner;
+
+		while (true)
+		{
+			// Posted once per queued directory and once per thread when done
+			scanner.semaphore.wait();
+
+			PendingDirectory directory;
+			{
+				ScopedMutex sm(scanner.mutex);
+				if (ArrayFn::getIsEmpty(scanner.pending))
+				{
+					if (scanner.isDone)
+					{
+						return 0;
+					}
+					continue;
+				}
+				// Depth first, the directories of a subtree are listed close in time
+				directory = ArrayFn::back(scanner.pending);
+				ArrayFn::popBack(scanner.pending);
+			}
+
+			Listing listing;
+			listing.path = directory.path;
+			listing.pathLength = directory.pathLength;
+			listing.lastModifiedTime = directory.lastModifiedTime;
+			listing.firstEntry = uint32_t(ArrayFn::getCount(worker.entries));
+
+			const Listing* cachedListing = scanner.findCachedListing(directory);
+			if (cachedListing != nullptr)
+			{
+				++worker.cachedDirectoriesCount;
+			}
+			scanner.listDirectory(worker, directory, cachedListing);
+
+			listing.entriesCount = uint32_t(ArrayFn::getCount(worker.entries)) - listing.firstEntry;
+			ArrayFn::pushBack(worker.listings, listing);
+
+			ScopedMutex sm(scanner.mutex);
+			if (--scanner.pendingCount == 0)
+			{
+				scanner.isDone = true;
+				scanner.semaphore.post(scanner.threadsCount);
+			}
+		}
+	}
+
+	char* DirectoryScanner::allocateString(Allocator& a, Worker& worker, size_t length)
+	{
+		const size_t size = length + 1;
+		char* str;
+		if (size > CHUNK_SIZE / 4)
+		{
+			Chunk* chunk = (Chunk*)a.allocate(sizeof(Chunk) + size, RIO_ALIGNOF(Chunk));
+			chunk->next = worker.chunks;
+			worker.chunks = chunk;
+			str = (char*)(chunk + 1);
+		}
+		else
+		{
+			if (size > worker.chunkRemaining)
+			{
+				Chunk* chunk = (Chunk*)a.allocate(sizeof(Chunk) + CHUNK_SIZE, RIO_ALIGNOF(Chunk));
+				chunk->next = worker.chunks;
+				worker.chunks = chunk;
+				worker.chunkPosition = (char*)(chunk + 1);
+				worker.chunkRemaining = CHUNK_SIZE;
+			}
+			str = worker.chunkPosition;
+			worker.chunkPosition += size;
+			worker.chunkRemaining -= size;
+		}
+		str[length] = '\0';
+		return str;
+	}
+
+	const char* DirectoryScanner::copyString(Allocator& a, Worker& worker, const char* str, size_t length)
+	{
+		char* copy = allocateString(a, worker, length);
+		memcpy(copy, str, length);
+		return copy;
+	}
+
+	void DirectoryScanner::freeChunks(Allocator& a, Worker& worker)
+	{
+		Chunk* chunk = worker.chunks;
+		while (chunk != nullptr)
+		{
+			Chunk* next = chunk->next;
+			a.deallocate(chunk);
+			chunk = next;
+		}
+		worker.chunks = nullptr;
+		worker.chunkPosition = nullptr;
+		worker.chunkRemaining = 0;
+	}
+
+	void DirectoryScanner::addEntry(Worker& worker, const PendingDirectory& directory, const char* name, size_t nameLength
+		, DirectoryEntryType::Enum type, uint64_t size, uint64_t lastModifiedTime)
+	{
+		// The path is built in place in the chunk
+		const size_t separatorLength = directory.pathLength > 0 ? 1 : 0;
+		const size_t pathLength = directory.pathLength + separatorLength + nameLength;
+		char* path = allocateString(*allocator, worker, pathLength);
+		memcpy(path, directory.path, directory.pathLength);
+		path[directory.pathLength] = '/';
+		memcpy(path + directory.pathLength + separatorLength, name, nameLength);
+
+		DirectoryEntry entry;
+		entry.path = path;
+		entry.pathLength = uint32_t(pathLength);
+		entry.type = type;
+		entry.size = size;
+		entry.lastModifiedTime = lastModifiedTime;
+		ArrayFn::pushBack(worker.entries, entry);
+
+		if (type == DirectoryEntryType::DIRECTORY)
+		{
+			PendingDirectory child;
+			child.path = path;
+			child.pathLength = uint32_t(pathLength);
+			child.lastModifiedTime = lastModifiedTime;
+			{
+				ScopedMutex sm(mutex);
+				ArrayFn::pushBack(pending, child);
+				++pendingCount;
+			}
+			semaphore.post();
+		}
+	}
+
+	const DirectoryScanner::Listing* DirectoryScanner::findCachedListing(const PendingDirectory& directory) const
+	{
+		if (cache == nullptr)
+		{
+			return nullptr;
+		}
+
+		const uint32_t index = HashMapFn::get(cacheIndices, murmur64(directory.path, int(directory.pathLength)), UINT32_MAX);
+		if (index == UINT32_MAX)
+		{
+			return nullptr;
+		}
+		const Listing& listing = cache->listings[index];
+		if (listing.lastModifiedTime != directory.lastModifiedTime
+			|| listing.pathLength != directory.pathLength
+			|| memcmp(listing.path, directory.path, directory.pathLength) != 0)
+		{
+			return nullptr;
+		}
+		return &listing;
+	}
+
+	// The cache holds the listings of the directories:
+	// uint32_t magic, uint32_t version, varuint root path length, root path, varuint listings count, then for each listing
+	// varuint path length, path, uint64_t modification time, varuint entries count, then for each entry
+	// varuint path length, path (relative to the scanned directory), uint8_t type
+	void DirectoryScanner::readCache(const char* cacheOsPath, const char* osPath)
+	{
+		cache = allocator->makeNew<Worker>(*allocator);
+
+		DiskFile file;
+		file.open(cacheOsPath, FileOpenMode::Read);
+		FileBinaryReader reader(file, *allocator);
+
+		uint32_t magic = 0;
+		uint32_t version = 0;
+		uint64_t pathLength = 0;
+		uint64_t listingsCount = 0;
+		char path[1024];
+		reader.read(magic);
+		reader.read(version);
+		// The cache of another directory is ignored
+		bool isValid = magic == CACHE_MAGIC && version == CACHE_VERSION
+			&& reader.readVarUint(pathLength)
+			&& pathLength == strlen(osPath)
+			&& pathLength < sizeof(path)
+			&& reader.read(path, size_t(pathLength)) == pathLength
+			&& memcmp(path, osPath, size_t(pathLength)) == 0
+			&& reader.readVarUint(listingsCount);
+
+		for (uint64_t i = 0; i < listingsCount && isValid; ++i)
+		{
+			uint64_t entriesCount = 0;
+			Listing listing;
+			isValid = reader.readVarUint(pathLength)
+				&& pathLength < sizeof(path)
+				&& reader.read(path, size_t(pathLength)) == pathLength
+				&& reader.read(listing.lastModifiedTime) == sizeof(listing.lastModifiedTime)
+				&& reader.readVarUint(entriesCount);
+			if (!isValid)
+			{
+				break;
+			}
+			listing.path = copyString(*allocator, *cache, path, size_t(pathLength));
+			listing.pathLength = uint32_t(pathLength);
+			listing.firstEntry = uint32_t(ArrayFn::getCount(cache->entries));
+			listing.entriesCount = uint32_t(entriesCount);
+
+			for (uint64_t j = 0; j < entriesCount && isValid; ++j)
+			{
+				uint8_t type = 0;
+				isValid = reader.readVarUint(pathLength)
+					&& pathLength < sizeof(path)
+					&& reader.read(path, size_t(pathLength)) == pathLength
+					&& reader.read(type) == 1
+					&& type <= DirectoryEntryType::OTHER;
+				if (isValid)
+				{
+					DirectoryEntry entry;
+					entry.path = copyString(*allocator, *cache, path, size_t(pathLength));
+					entry.pathLength = uint32_t(pathLength);
+					entry.type = DirectoryEntryType::Enum(type);
+					entry.size = 0;
+					entry.lastModifiedTime = 0;
+					ArrayFn::pushBack(cache->entries, entry);
+				}
+			}
+
+			HashMapFn::set(cacheIndices, murmur64(listing.path, int(listing.pathLength)), uint32_t(ArrayFn::getCount(cache->listings)));
+			ArrayFn::pushBack(cache->listings, listing);
+		}
+
+		if (!isValid)
+		{
+			// Corrupted or from another version, rebuilt from scratch
+			freeCache();
+		}
+	}
+
+	void DirectoryScanner::writeCache(const char* cacheOsPath, const char* osPath)
+	{
+		uint64_t listingsCount = 0;
+		for (uint32_t i = 0; i < ArrayFn::getCount(workers); ++i)
+		{
+			listingsCount += ArrayFn::getCount(workers[i]->listings);
+		}
+
+		DiskFile file;
+		file.open(cacheOsPath, FileOpenMode::Write);
+		FileBinaryWriter writer(file, *allocator);
+		writer.write(CACHE_MAGIC);
+		writer.write(CACHE_VERSION);
+		writer.writeVarUint(strlen(osPath));
+		writer.write(osPath, strlen(osPath));
+		writer.writeVarUint(listingsCount);
+
+		for (uint32_t i = 0; i < ArrayFn::getCount(workers); ++i)
+		{
+			const Worker& worker = *workers[i];
+			for (uint32_t j = 0; j < ArrayFn::getCount(worker.listings); ++j)
+			{
+				const Listing& listing = worker.listings[j];
+				writer.writeVarUint(listing.pathLength);
+				writer.write(listing.path, listing.pathLength);
+				writer.write(listing.lastModifiedTime);
+				writer.writeVarUint(listing.entriesCount);
+
+				for (uint32_t k = 0; k < listing.entriesCount; ++k)
+				{
+					const DirectoryEntry& entry = worker.entries[listing.firstEntry + k];
+					writer.writeVarUint(entry.pathLength);
+					writer.write(entry.path, entry.pathLength);
+					writer.write(uint8_t(entry.type));
+				}
+			}
+		}
+	}
+
+	void DirectoryScanner::freeCache()
+	{
+		if (cache != nullptr)
+		{
+			freeChunks(*allocator, *cache);
+			allocator->makeDelete(cache);
+			cache = nullptr;
+		}
+		HashMapFn::clear(cacheIndices);
+	}
+
+} // namespace Rio
@@ -0,0 +1,152 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#pragma once
+
+#include "Core/Base/Config.h"
+#include "Core/Base/Types.h"
+
+#include "Core/Containers/Array.h"
+#include "Core/Containers/HashMap.h"
+#include "Core/Memory/Allocator.h"
+#include "Core/Thread/Mutex.h"
+#include "Core/Thread/Semaphore.h"
+
+namespace Rio
+{
+	struct DirectoryEntryType
+	{
+		enum Enum
+		{
+			FILE,
+			DIRECTORY,
+			// Symbolic links, devices, etc. Symbolic links are not followed.
+			OTHER
+		};
+	};
+
+	struct DirectoryEntry
+	{
+		// Relative to the scanned directory, using '/', NUL-terminated
+		const char* path;
+		uint32_t pathLength;
+		DirectoryEntryType::Enum type;
+		uint64_t size;
+		// Nanoseconds since 1970-01-01 UTC
+		uint64_t lastModifiedTime;
+	};
+
+	// Lists a directory and all of its subdirectories with a pool of threads,
+	// one directory at a time per thread. The entries come with their size and
+	// modification time, the paths are stored in arenas owned by the scanner.
+	//
+	// A cache file can be given to scan() to keep the listings between runs.
+	// The listing of a directory whose modification time did not change is read
+	// from the cache instead of the disk. The size and time of the files are
+	// always read again, changing a file does not change its directory.
+	class DirectoryScanner
+	{
+	public:
+		DirectoryScanner(Allocator& a, uint32_t threadsCount = 4);
+		~DirectoryScanner();
+
+		// Scans the OS path, the entries of the previous scan are freed.
+		// cacheOsPath is optional, the cache is read if it exists and then updated.
+		// Returns false if the directory cannot be opened.
+		bool scan(const char* osPath, const char* cacheOsPath = nullptr);
+		// Returns the entries sorted by path, valid until the next scan
+		const Array<DirectoryEntry>& getEntries() const;
+		// Returns the number of directories read from the cache by the last scan
+		uint32_t getCachedDirectoriesCount() const;
+	private:
+		// Chunk of memory the paths are copied to
+		struct Chunk
+		{
+			Chunk* next;
+		};
+
+		// Listing of a directory, kept in the cache
+		struct Listing
+		{
+			const char* path;
+			uint32_t pathLength;
+			uint64_t lastModifiedTime;
+			// Entries of the owner of the listing, a worker or the cache
+			uint32_t firstEntry;
+			uint32_t entriesCount;
+		};
+
+		// Directory waiting to be listed
+		struct PendingDirectory
+		{
+			const char* path;
+			uint32_t pathLength;
+			uint64_t lastModifiedTime;
+		};
+
+		// State of a thread, merged once every directory has been listed
+		struct Worker
+		{
+			DirectoryScanner* scanner;
+			Array<DirectoryEntry> entries;
+			Array<Listing> listings;
+			Chunk* chunks;
+			char* chunkPosition;
+			size_t chunkRemaining;
+			uint32_t cachedDirectoriesCount;
+
+			Worker(Allocator& a);
+		};
+
+		static int32_t workerMain(void* data);
+		// Returns length + 1 bytes from the chunks of the worker, ending with a '\0'
+		static char* allocateString(Allocator& a, Worker& worker, size_t length);
+		// Copies the string to the chunks of the worker, adds a '\0'
+		static const char* copyString(Allocator& a, Worker& worker, const char* str, size_t length);
+		static void freeChunks(Allocator& a, Worker& worker);
+		// Adds the entry of a child of directory to the worker, queues it if it is a directory
+		void addEntry(Worker& worker, const PendingDirectory& directory, const char* name, size_t nameLength
+			, DirectoryEntryType::Enum type, uint64_t size, uint64_t lastModifiedTime);
+		// Returns the cached listing of the directory if its modification time is the same, nullptr otherwise
+		const Listing* findCachedListing(const PendingDirectory& directory) const;
+		void readCache(const char* cacheOsPath, const char* osPath);
+		void writeCache(const char* cacheOsPath, const char* osPath);
+		void freeCache();
+
+		// Implemented per platform, see Posix/DirectoryScanner_Posix.cpp and Windows/DirectoryScanner_Windows.cpp
+		// Opens the scanned directory and returns its modification time
+		bool openRoot(const char* osPath, uint64_t& lastModifiedTime);
+		void closeRoot();
+		static bool getIsFile(const char* osPath);
+		// Adds the children of the directory with addEntry(), the names are taken
+		// from cachedListing instead of the disk when it is not nullptr
+		void listDirectory(Worker& worker, const PendingDirectory& directory, const Listing* cachedListing);
+
+		Allocator* allocator;
+		uint32_t threadsCount;
+		Array<DirectoryEntry> entries;
+		Array<Worker*> workers;
+
+		// Directories waiting for a thread, the semaphore is posted once per directory
+		Mutex mutex;
+		Semaphore semaphore;
+		Array<PendingDirectory> pending;
+		// Directories queued or being listed
+		uint32_t pendingCount;
+		bool isDone;
+
+		// Listings read from the cache, indexed by the murmur64() of the path
+		Worker* cache;
+		HashMap<uint32_t> cacheIndices;
+
+		// Platform handle of the scanned directory
+#if RIO_PLATFORM_POSIX
+		int rootFd;
+#elif RIO_PLATFORM_WINDOWS
+		char rootPath[1024];
+#endif // RIO_PLATFORM_POSIX
+	private:
+		// Disable copying
+		DirectoryScanner(const DirectoryScanner&);
+		DirectoryScanner& operator=(const DirectoryScanner&);
+	};
+
+} // namespace Rio
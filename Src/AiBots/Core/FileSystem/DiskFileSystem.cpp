@@ -42,6 +42,24 @@ namespace Rio
 		getDefaultAllocator().makeDelete(&file);
 	}
 
+	MappedFile* DiskFilesystem::mapFile(const char* path)
+	{
+		RIO_ASSERT_NOT_NULL(path);
+
+		TempAllocator256 alloc;
+		DynamicString absPath(alloc);
+		getAbsolutePath(path, absPath);
+
+		MappedFile* file = getDefaultAllocator().makeNew<MappedFile>();
+		file->open(absPath.toCStr(), FileOpenMode::Read);
+		return file;
+	}
+
+	void DiskFilesystem::unmapFile(MappedFile& file)
+	{
+		getDefaultAllocator().makeDelete(&file);
+	}
+
 	bool DiskFilesystem::doesPathExist(const char* path)
 	{
 		RIO_ASSERT_NOT_NULL(path);
@@ -50,7 +68,7 @@ namespace Rio
 		DynamicString absPath(alloc);
 		getAbsolutePath(path, absPath);
 
-		return Os::doesPathExist(absPath.toCStr());
+		return Os::exists(absPath.toCStr());
 	}
 
 	bool DiskFilesystem::isDirectory(const char* path)
@@ -94,7 +112,7 @@ namespace Rio
 		DynamicString absPath(alloc);
 		getAbsolutePath(path, absPath);
 
-		if (!Os::doesPathExist(absPath.toCStr()))
+		if (!Os::exists(absPath.toCStr()))
 		{
 			Os::createDirectory(absPath.toCStr());
 		}
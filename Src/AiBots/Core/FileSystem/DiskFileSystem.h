@@ -22,8 +22,15 @@ namespace Rio
 		// Sets the root path to the given prefix.
 		// NOTE The prefix must be absolute.
 		DiskFilesystem(const char* prefix);
+		using Filesystem::fileOpen;
+		using Filesystem::doesPathExist;
+		using Filesystem::isDirectory;
+		using Filesystem::isFile;
+		using Filesystem::getAbsolutePath;
 		File* fileOpen(const char* path, FileOpenMode mode);
 		void fileClose(File& file);
+		MappedFile* mapFile(const char* path);
+		void unmapFile(MappedFile& file);
 		bool doesPathExist(const char* path);
 		// Returns true if path is a directory.
 		bool isDirectory(const char* path);
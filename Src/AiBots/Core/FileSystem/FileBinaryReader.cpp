@@ -0,0 +1,121 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/FileSystem/FileBinaryReader.h"
+
+#include "Core/Debug/Error.h"
+
+namespace Rio
+{
+	FileBinaryReader::FileBinaryReader(File& file, Allocator& a, size_t bufferSize)
+		: file(file)
+		, allocator(&a)
+		, buffer(nullptr)
+		, bufferSize(bufferSize)
+		, current(nullptr)
+		, end(nullptr)
+	{
+		RIO_ASSERT(bufferSize > 0, "Buffer size must be > 0");
+		buffer = (char*)a.allocate(bufferSize);
+		current = buffer;
+		end = buffer;
+	}
+
+	FileBinaryReader::~FileBinaryReader()
+	{
+		// Gives back what was read ahead
+		if (current != end)
+		{
+			file.seek(getPosition());
+		}
+		allocator->deallocate(buffer);
+	}
+
+	bool FileBinaryReader::readVarUint(uint64_t& value)
+	{
+		value = 0;
+		for (uint32_t shift = 0; shift < 64; shift += 7)
+		{
+			uint8_t byte;
+			if (read(byte) != 1)
+			{
+				return false;
+			}
+			value |= uint64_t(byte & 0x7f) << shift;
+			if ((byte & 0x80) == 0)
+			{
+				// The 10th byte has room for the highest bit only
+				return shift < 63 || byte <= 1;
+			}
+		}
+		return false;
+	}
+
+	bool FileBinaryReader::readVarInt(int64_t& value)
+	{
+		uint64_t zigzag;
+		const bool isRead = readVarUint(zigzag);
+		value = int64_t(zigzag >> 1) ^ -int64_t(zigzag & 1);
+		return isRead;
+	}
+
+	void FileBinaryReader::skip(size_t bytes)
+	{
+		const size_t buffered = size_t(end - current);
+		if (bytes <= buffered)
+		{
+			current += bytes;
+			return;
+		}
+
+		current = buffer;
+		end = buffer;
+		file.skip(bytes - buffered);
+	}
+
+	bool FileBinaryReader::getIsEndOfFile()
+	{
+		return current == end && !fill();
+	}
+
+	size_t FileBinaryReader::getPosition()
+	{
+		return file.getFilePosition() - size_t(end - current);
+	}
+
+	size_t FileBinaryReader::readBuffered(void* data, size_t size)
+	{
+		char* out = (char*)data;
+		size_t bytesRead = size_t(end - current);
+		memcpy(out, current, bytesRead);
+		current = end;
+
+		while (bytesRead < size)
+		{
+			const size_t remaining = size - bytesRead;
+			if (remaining >= bufferSize)
+			{
+				// Not worth copying through the buffer
+				bytesRead += file.read(out + bytesRead, remaining);
+				break;
+			}
+
+			if (!fill())
+			{
+				break;
+			}
+			const size_t count = remaining < size_t(end - current) ? remaining : size_t(end - current);
+			memcpy(out + bytesRead, current, count);
+			current += count;
+			bytesRead += count;
+		}
+		return bytesRead;
+	}
+
+	bool FileBinaryReader::fill()
+	{
+		const size_t bytesRead = file.read(buffer, bufferSize);
+		current = buffer;
+		end = buffer + bytesRead;
+		return bytesRead != 0;
+	}
+
+} // namespace Rio
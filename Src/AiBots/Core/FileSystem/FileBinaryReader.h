@@ -4,33 +4,96 @@
 #include "Core/Base/Config.h"
 
 #include "Core/Base/Types.h"
+#include "Core/Base/Endian.h"
+#include "Core/Memory/Memory.h"
 #include "File.h"
 
+#include <cstring> // memcpy
+
 namespace Rio
 {
 	// A reader that offers a convenient way to read from a File
+	// The file is read ahead in blocks of bufferSize bytes, so reading
+	// small values is a copy from the buffer instead of a call to File::read().
+	// Reads of at least bufferSize bytes go straight to the file.
+	// The file is moved back to getPosition() when the reader is destroyed.
 	class FileBinaryReader
 	{
 	public:
-		FileBinaryReader(File& file) 
-			: file(file) 
-		{}
+		static const size_t DEFAULT_BUFFER_SIZE = 16 * 1024;
+
+		FileBinaryReader(File& file, Allocator& a = getDefaultAllocator(), size_t bufferSize = DEFAULT_BUFFER_SIZE);
+		~FileBinaryReader();
 
+		// Returns the number of bytes read, less than size at the end of the file
 		size_t read(void* data, size_t size)
 		{
-			return file.read(data, size);
+			if (size <= size_t(end - current))
+			{
+				memcpy(data, current, size);
+				current += size;
+				return size;
+			}
+			return readBuffered(data, size);
 		}
 
 		template <typename T>
 		size_t read(T& data)
 		{
-			return file.read(&data, sizeof(T));
+			return read(&data, sizeof(T));
+		}
+
+		// Returns the number of whole items read
+		template <typename T>
+		size_t readArray(T* data, size_t count)
+		{
+			return read(data, count * sizeof(T)) / sizeof(T);
+		}
+
+		// Reads a value stored in little-endian or big-endian byte order
+		template <typename T>
+		size_t readLittleEndian(T& data)
+		{
+			const size_t bytesRead = read(data);
+			data = EndianFn::toLittleEndian(data);
+			return bytesRead;
 		}
-		void skip(size_t bytes)
+
+		template <typename T>
+		size_t readBigEndian(T& data)
 		{
-			file.skip(bytes);
+			const size_t bytesRead = read(data);
+			data = EndianFn::toBigEndian(data);
+			return bytesRead;
 		}
+
+		// Reads an unsigned LEB128 number, 7 bits per byte.
+		// Returns false at the end of the file or if the number does not fit in 64 bits.
+		bool readVarUint(uint64_t& value);
+		// Reads a zigzag encoded number written by FileBinaryWriter::writeVarInt()
+		bool readVarInt(int64_t& value);
+
+		void skip(size_t bytes);
+		// Returns whether everything has been read, reads ahead if the buffer is empty
+		bool getIsEndOfFile();
+		// Returns the position of the next byte to read in the file
+		size_t getPosition();
 	private:
+		// Reads what is left in the buffer and the rest from the file
+		size_t readBuffered(void* data, size_t size);
+		// Reads the next block of the file, returns false at the end of the file
+		bool fill();
+
 		File& file;
+		Allocator* allocator;
+		char* buffer;
+		size_t bufferSize;
+		// The bytes of the buffer which have not been read yet
+		const char* current;
+		const char* end;
+	private:
+		// Disable copying
+		FileBinaryReader(const FileBinaryReader&);
+		FileBinaryReader& operator=(const FileBinaryReader&);
 	};
-} // namespace Rio
\ No newline at end of file
+} // namespace Rio
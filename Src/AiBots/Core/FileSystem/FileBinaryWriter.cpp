@@ -0,0 +1,73 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/FileSystem/FileBinaryWriter.h"
+
+#include "Core/Debug/Error.h"
+
+namespace Rio
+{
+	FileBinaryWriter::FileBinaryWriter(File& file, Allocator& a, size_t bufferSize)
+		: file(file)
+		, allocator(&a)
+		, buffer(nullptr)
+		, bufferSize(bufferSize)
+		, current(nullptr)
+		, bufferEnd(nullptr)
+	{
+		RIO_ASSERT(bufferSize > 0, "Buffer size must be > 0");
+		buffer = (char*)a.allocate(bufferSize);
+		current = buffer;
+		bufferEnd = buffer + bufferSize;
+	}
+
+	FileBinaryWriter::~FileBinaryWriter()
+	{
+		flush();
+		allocator->deallocate(buffer);
+	}
+
+	void FileBinaryWriter::writeVarUint(uint64_t value)
+	{
+		uint8_t bytes[10];
+		uint32_t count = 0;
+		while (value >= 0x80)
+		{
+			bytes[count++] = uint8_t(value | 0x80);
+			value >>= 7;
+		}
+		bytes[count++] = uint8_t(value);
+		write(bytes, count);
+	}
+
+	void FileBinaryWriter::writeVarInt(int64_t value)
+	{
+		writeVarUint((uint64_t(value) << 1) ^ uint64_t(value >> 63));
+	}
+
+	void FileBinaryWriter::skip(size_t bytes)
+	{
+		flush();
+		file.skip(bytes);
+	}
+
+	void FileBinaryWriter::flush()
+	{
+		if (current != buffer)
+		{
+			file.write(buffer, size_t(current - buffer));
+			current = buffer;
+		}
+	}
+
+	void FileBinaryWriter::writeBuffered(const void* data, size_t size)
+	{
+		flush();
+		if (size >= bufferSize)
+		{
+			file.write(data, size);
+			return;
+		}
+		memcpy(current, data, size);
+		current += size;
+	}
+
+} // namespace Rio
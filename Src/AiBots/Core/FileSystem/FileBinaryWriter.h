@@ -4,32 +4,84 @@
 #include "Core/Base/Config.h"
 
 #include "Core/Base/Types.h"
+#include "Core/Base/Endian.h"
+#include "Core/Memory/Memory.h"
 #include "File.h"
 
+#include <cstring> // memcpy
+
 namespace Rio
 {
 	// A writer that offers a convenient way to write to a File
+	// Writes are gathered in a buffer of bufferSize bytes which is written
+	// to the file when full, by flush() or when the writer is destroyed.
+	// Writes of at least bufferSize bytes go straight to the file.
 	class FileBinaryWriter
 	{
 	public:
-		FileBinaryWriter(File& file) : file(file) {}
+		static const size_t DEFAULT_BUFFER_SIZE = 16 * 1024;
+
+		FileBinaryWriter(File& file, Allocator& a = getDefaultAllocator(), size_t bufferSize = DEFAULT_BUFFER_SIZE);
+		~FileBinaryWriter();
 
 		void write(const void* data, size_t size)
 		{
-			file.write(data, size);
+			if (size <= size_t(bufferEnd - current))
+			{
+				memcpy(current, data, size);
+				current += size;
+				return;
+			}
+			writeBuffered(data, size);
 		}
 
 		template <typename T>
 		void write(const T& data)
 		{
-			file.write(&data, sizeof(T));
+			write(&data, sizeof(T));
+		}
+
+		template <typename T>
+		void writeArray(const T* data, size_t count)
+		{
+			write(data, count * sizeof(T));
 		}
 
-		void skip(size_t bytes)
+		// Writes a value in little-endian or big-endian byte order
+		template <typename T>
+		void writeLittleEndian(T data)
 		{
-			file.skip(bytes);
+			write(EndianFn::toLittleEndian(data));
 		}
+
+		template <typename T>
+		void writeBigEndian(T data)
+		{
+			write(EndianFn::toBigEndian(data));
+		}
+
+		// Writes an unsigned LEB128 number, 7 bits per byte, small numbers take one byte
+		void writeVarUint(uint64_t value);
+		// Writes a zigzag encoded number, small negative numbers take one byte as well
+		void writeVarInt(int64_t value);
+
+		void skip(size_t bytes);
+		// Writes the buffer to the file.
+		// It does not call File::flush(), the data may still be buffered by the file.
+		void flush();
 	private:
+		// Writes the buffer to the file and then data, or buffers it if it fits
+		void writeBuffered(const void* data, size_t size);
+
 		File& file;
+		Allocator* allocator;
+		char* buffer;
+		size_t bufferSize;
+		char* current;
+		char* bufferEnd;
+	private:
+		// Disable copying
+		FileBinaryWriter(const FileBinaryWriter&);
+		FileBinaryWriter& operator=(const FileBinaryWriter&);
 	};
-} // namespace Rio
\ No newline at end of file
+} // namespace Rio
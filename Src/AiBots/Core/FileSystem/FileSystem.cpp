@@ -0,0 +1,44 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "FileSystem.h"
+
+#include "Core/Memory/TempAllocator.h"
+
+namespace Rio
+{
+
+	File* Filesystem::fileOpen(StringView path, FileOpenMode mode)
+	{
+		TempAllocator256 alloc;
+		DynamicString pathString(path, alloc);
+		return fileOpen(pathString.toCStr(), mode);
+	}
+
+	bool Filesystem::doesPathExist(StringView path)
+	{
+		TempAllocator256 alloc;
+		DynamicString pathString(path, alloc);
+		return doesPathExist(pathString.toCStr());
+	}
+
+	bool Filesystem::isDirectory(StringView path)
+	{
+		TempAllocator256 alloc;
+		DynamicString pathString(path, alloc);
+		return isDirectory(pathString.toCStr());
+	}
+
+	bool Filesystem::isFile(StringView path)
+	{
+		TempAllocator256 alloc;
+		DynamicString pathString(path, alloc);
+		return isFile(pathString.toCStr());
+	}
+
+	void Filesystem::getAbsolutePath(StringView path, DynamicString& osPath)
+	{
+		TempAllocator256 alloc;
+		DynamicString pathString(path, alloc);
+		getAbsolutePath(pathString.toCStr(), osPath);
+	}
+
+} // namespace Rio
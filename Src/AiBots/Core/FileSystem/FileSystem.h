@@ -4,7 +4,9 @@
 #include "Core/Base/Config.h"
 
 #include "Core/FileSystem/File.h"
+#include "Core/FileSystem/MappedFile.h"
 #include "Core/Strings/DynamicString.h"
+#include "Core/Strings/StringView.h"
 #include "Core/Containers/Vector.h"
 
 namespace Rio
@@ -65,6 +67,10 @@ namespace Rio
 	public:
 		virtual File* fileOpen(const char* path, FileOpenMode mode) = 0;
 		virtual void fileClose(File& file) = 0;
+		// Maps the file read-only into memory, its contents are accessed without copying
+		// with MappedFile::getData(). Close it with unmapFile().
+		virtual MappedFile* mapFile(const char* path) = 0;
+		virtual void unmapFile(MappedFile& file) = 0;
 		virtual bool doesPathExist(const char* path) = 0;
 		// Returns true if path is a directory.
 		virtual bool isDirectory(const char* path) = 0;
@@ -80,6 +86,14 @@ namespace Rio
 		// Returns the absolute path of the given path based on
 		// the root path of the file source. If the path is absolute, the given path is returned.
 		virtual void getAbsolutePath(const char* path, DynamicString& osPath) = 0;
+
+		// Same as above for paths which are not NUL-terminated, e.g. parts of a larger string.
+		// The path is copied to a temporary NUL-terminated string.
+		File* fileOpen(StringView path, FileOpenMode mode);
+		bool doesPathExist(StringView path);
+		bool isDirectory(StringView path);
+		bool isFile(StringView path);
+		void getAbsolutePath(StringView path, DynamicString& osPath);
 	};
 
 } // namespace Rio
@@ -5,15 +5,17 @@
 
 #include "Core/Base/Types.h"
 #include "Core/FileSystem/File.h"
+#include "Core/FileSystem/FileBinaryReader.h"
 
 namespace Rio
 {
 	// A reader that offers a convenient way to read text from a File
+	// The file is read ahead like with FileBinaryReader.
 	class FileTextReader
 	{
 	public:
-		FileTextReader(File& file) 
-			: file(file) {}
+		FileTextReader(File& file, Allocator& a = getDefaultAllocator(), size_t bufferSize = FileBinaryReader::DEFAULT_BUFFER_SIZE)
+			: reader(file, a, bufferSize) {}
 
 		// Reads characters from file and stores them as a C string
 		// until (size-1) characters have been read or a newline or EOF is reached, whichever comes first.
@@ -26,9 +28,8 @@ namespace Rio
 			char currentChar;
 			size_t bytesRead = 0;
 
-			while (!file.getIsEndOfFile() && bytesRead < size - 1)
+			while (bytesRead < size - 1 && reader.read(currentChar) == 1)
 			{
-				file.read(&currentChar, 1);
 				string[bytesRead] = currentChar;
 
 				bytesRead++;
@@ -43,6 +44,6 @@ namespace Rio
 			return bytesRead;
 		}
 	private:
-		File& file;
+		FileBinaryReader reader;
 	};
-} // namespace Rio
\ No newline at end of file
+} // namespace Rio
@@ -7,23 +7,31 @@
 #include "Core/Strings/StringUtils.h"
 
 #include "Core/FileSystem/File.h"
+#include "Core/FileSystem/FileBinaryWriter.h"
 
 namespace Rio
 {
 	// A reader that offers a convenient way to write text to a File
+	// Writes are buffered like with FileBinaryWriter.
 	class FileTextWriter
 	{
 	public:
-		FileTextWriter(File& file) : file(file) {}
+		FileTextWriter(File& file, Allocator& a = getDefaultAllocator(), size_t bufferSize = FileBinaryWriter::DEFAULT_BUFFER_SIZE)
+			: writer(file, a, bufferSize) {}
 		// Writes the string pointed by string to the file.
 		// The function begins copying from the address specified (string)
 		// until it reaches the terminating null character ('\0').
 		// The final null character is not copied to the file.
 		void writeString(const char* string)
 		{
-			file.write(string, Rio::strLen(string));
+			writer.write(string, Rio::strLen(string));
+		}
+		// Writes the buffer to the file
+		void flush()
+		{
+			writer.flush();
 		}
 	private:
-		File& file;
+		FileBinaryWriter writer;
 	};
-} // namespace Rio
\ No newline at end of file
+} // namespace Rio
@@ -0,0 +1,183 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/FileSystem/FileWatcher.h"
+
+#include "Core/Base/Murmur.h"
+#include "Core/Debug/Error.h"
+#include "Core/Memory/TempAllocator.h"
+#include "Core/Strings/Path.h"
+#include "Core/Strings/StringUtils.h"
+
+#include <cstring> // memcpy
+
+namespace Rio
+{
+	FileWatcher::FileWatcher(Allocator& a, DiskFilesystem& fs, const char* path, uint32_t debounceMilliseconds)
+		: allocator(&a)
+		, prefix(path, a)
+		, debounceMilliseconds(debounceMilliseconds)
+		, pending(a)
+		, pendingIndices(a)
+		, isEventsLostPending(false)
+		, events(nullptr)
+		, eventsHead(0)
+		, eventsTail(0)
+		, backend(nullptr)
+	{
+		RIO_ASSERT_NOT_NULL(path);
+
+		if (prefix.getLength() > 0)
+		{
+			prefix += '/';
+		}
+		events = (FileWatchEvent*)a.allocate(QUEUE_SIZE * sizeof(FileWatchEvent), RIO_ALIGNOF(FileWatchEvent));
+
+		TempAllocator256 ta;
+		DynamicString osPath(ta);
+		fs.getAbsolutePath(path, osPath);
+		const StringView watchedPath = PathFn::stripTrailingSeparator(osPath.toStringView());
+		osPath.resize(watchedPath.getLength());
+
+		createBackend(osPath.toCStr());
+	}
+
+	FileWatcher::~FileWatcher()
+	{
+		if (backend != nullptr)
+		{
+			destroyBackend();
+		}
+		allocator->deallocate(events);
+	}
+
+	bool FileWatcher::getIsWatching() const
+	{
+		return backend != nullptr;
+	}
+
+	bool FileWatcher::popEvent(FileWatchEvent& event)
+	{
+		const uint32_t head = eventsHead.load(MemoryOrder::RELAXED);
+		if (head == eventsTail.load(MemoryOrder::ACQUIRE))
+		{
+			return false;
+		}
+		event = events[head % QUEUE_SIZE];
+		eventsHead.store(head + 1, MemoryOrder::RELEASE);
+		return true;
+	}
+
+	void FileWatcher::addChange(const char* path, size_t length, FileWatchAction::Enum action, int64_t now)
+	{
+		const size_t prefixLength = prefix.getLength();
+		if (prefixLength + length >= FileWatchEvent::MAX_PATH_LENGTH)
+		{
+			// Cannot be reported, the user has to rescan
+			addEventsLost();
+			return;
+		}
+
+		char fullPath[FileWatchEvent::MAX_PATH_LENGTH];
+		memcpy(fullPath, prefix.toCStr(), prefixLength);
+		memcpy(fullPath + prefixLength, path, length);
+		fullPath[prefixLength + length] = '\0';
+
+		const uint64_t key = murmur64(fullPath, int(prefixLength + length));
+		const uint32_t index = HashMapFn::get(pendingIndices, key, UINT32_MAX);
+		if (index == UINT32_MAX)
+		{
+			PendingChange change;
+			change.action = action;
+			change.deadline = now + debounceMilliseconds;
+			memcpy(change.path, fullPath, prefixLength + length + 1);
+			HashMapFn::set(pendingIndices, key, uint32_t(ArrayFn::getCount(pending)));
+			ArrayFn::pushBack(pending, change);
+			return;
+		}
+
+		PendingChange& change = pending[index];
+		change.deadline = now + debounceMilliseconds;
+		if (change.action == FileWatchAction::ADDED)
+		{
+			// Removed before being reported, e.g. a temporary file of an editor
+			if (action == FileWatchAction::REMOVED)
+			{
+				removePending(index);
+			}
+		}
+		else
+		{
+			// A file removed then added back has been replaced, i.e. modified
+			change.action = action == FileWatchAction::REMOVED ? FileWatchAction::REMOVED : FileWatchAction::MODIFIED;
+		}
+	}
+
+	void FileWatcher::addEventsLost()
+	{
+		isEventsLostPending = true;
+	}
+
+	int32_t FileWatcher::publishChanges(int64_t now)
+	{
+		// When the queue is full the changes stay pending and are retried after a while
+		const int32_t retryMilliseconds = int32_t(debounceMilliseconds);
+
+		if (isEventsLostPending)
+		{
+			if (!pushEvent(FileWatchAction::EVENTS_LOST, ""))
+			{
+				return retryMilliseconds;
+			}
+			isEventsLostPending = false;
+		}
+
+		int64_t nextDeadline = INT64_MAX;
+		for (uint32_t i = 0; i < ArrayFn::getCount(pending); )
+		{
+			const PendingChange& change = pending[i];
+			if (change.deadline > now)
+			{
+				nextDeadline = change.deadline < nextDeadline ? change.deadline : nextDeadline;
+				++i;
+				continue;
+			}
+
+			if (!pushEvent(change.action, change.path))
+			{
+				return retryMilliseconds;
+			}
+			removePending(i);
+		}
+
+		return nextDeadline == INT64_MAX ? -1 : int32_t(nextDeadline - now);
+	}
+
+	void FileWatcher::removePending(uint32_t index)
+	{
+		HashMapFn::remove(pendingIndices, murmur64(pending[index].path, int(strLen(pending[index].path))));
+
+		const uint32_t last = uint32_t(ArrayFn::getCount(pending) - 1);
+		if (index != last)
+		{
+			pending[index] = pending[last];
+			HashMapFn::set(pendingIndices, murmur64(pending[index].path, int(strLen(pending[index].path))), index);
+		}
+		ArrayFn::popBack(pending);
+	}
+
+	bool FileWatcher::pushEvent(FileWatchAction::Enum action, const char* path)
+	{
+		const uint32_t tail = eventsTail.load(MemoryOrder::RELAXED);
+		if (tail - eventsHead.load(MemoryOrder::ACQUIRE) == QUEUE_SIZE)
+		{
+			return false;
+		}
+
+		FileWatchEvent& event = events[tail % QUEUE_SIZE];
+		event.action = action;
+		strnCpy(event.path, path, FileWatchEvent::MAX_PATH_LENGTH);
+		event.path[FileWatchEvent::MAX_PATH_LENGTH - 1] = '\0';
+		eventsTail.store(tail + 1, MemoryOrder::RELEASE);
+		return true;
+	}
+
+} // namespace Rio
@@ -0,0 +1,111 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#pragma once
+
+#include "Core/Base/Config.h"
+#include "Core/Base/Types.h"
+
+#include "Core/Containers/Array.h"
+#include "Core/Containers/HashMap.h"
+#include "Core/FileSystem/DiskFileSystem.h"
+#include "Core/Memory/Allocator.h"
+#include "Core/Strings/DynamicString.h"
+#include "Core/Thread/Atomic.h"
+
+namespace Rio
+{
+	struct FileWatchAction
+	{
+		enum Enum
+		{
+			ADDED,
+			MODIFIED,
+			// Also reported for a directory moved out of the watched one, its files are not listed
+			REMOVED,
+			// Events were lost, every watched file may have changed
+			EVENTS_LOST
+		};
+	};
+
+	struct FileWatchEvent
+	{
+		static const uint32_t MAX_PATH_LENGTH = 256;
+
+		FileWatchAction::Enum action;
+		// Relative to the root of the filesystem, using '/', empty for FileWatchAction::EVENTS_LOST
+		char path[MAX_PATH_LENGTH];
+	};
+
+	// Watches a directory of a DiskFilesystem and its subdirectories and reports the files
+	// which are added, modified or removed, without polling. Uses inotify on Linux and
+	// ReadDirectoryChangesW on Windows. Elsewhere getIsWatching() is false and
+	// Filesystem::getLastModifiedTime() must be polled instead.
+	//
+	// The changes are collected by a thread and debounced: the changes of a path are merged
+	// and reported once no new change happened for debounceMilliseconds, so the several events
+	// of an editor saving a file give a single one. A file added then removed is not reported,
+	// a file replaced by renaming another one over it is reported as added.
+	// The events are passed to the thread calling popEvent() through a lock-free queue,
+	// while it is full the changes stay pending.
+	class FileWatcher
+	{
+	public:
+		static const uint32_t QUEUE_SIZE = 1024;
+
+		// Watches path of fs and its subdirectories, "" watches the whole filesystem
+		FileWatcher(Allocator& a, DiskFilesystem& fs, const char* path = "", uint32_t debounceMilliseconds = 100);
+		~FileWatcher();
+
+		// Returns whether the changes are reported
+		bool getIsWatching() const;
+		// Pops the next change, returns false if there are none.
+		// Must be called by a single thread.
+		bool popEvent(FileWatchEvent& event);
+	private:
+		struct PendingChange
+		{
+			FileWatchAction::Enum action;
+			int64_t deadline;
+			char path[FileWatchEvent::MAX_PATH_LENGTH];
+		};
+
+		// Called by the thread of the backend, time is in milliseconds
+		// Merges the change of path, relative to the watched directory, with the pending ones
+		void addChange(const char* path, size_t length, FileWatchAction::Enum action, int64_t now);
+		void addEventsLost();
+		// Removes pending[index] by moving the last one in its place
+		void removePending(uint32_t index);
+		// Queues the pending changes which are due, returns the milliseconds until
+		// publishChanges() must be called again or -1 if nothing is pending
+		int32_t publishChanges(int64_t now);
+		// Returns false if the queue is full
+		bool pushEvent(FileWatchAction::Enum action, const char* path);
+
+		// Implemented per platform, see Posix/FileWatcher_Posix.cpp and Windows/FileWatcher_Windows.cpp
+		struct Backend;
+		// Leaves backend null where watching is not supported
+		void createBackend(const char* osPath);
+		void destroyBackend();
+		static int32_t watcherMain(void* data);
+
+		Allocator* allocator;
+		// Prefix of the reported paths, the watched directory followed by '/'
+		DynamicString prefix;
+		uint32_t debounceMilliseconds;
+		Array<PendingChange> pending;
+		// Index in pending of the murmur64() of the reported path
+		HashMap<uint32_t> pendingIndices;
+		bool isEventsLostPending;
+
+		// Single producer single consumer queue of QUEUE_SIZE events
+		FileWatchEvent* events;
+		Atomic<uint32_t> eventsHead;
+		Atomic<uint32_t> eventsTail;
+
+		Backend* backend;
+	private:
+		// Disable copying
+		FileWatcher(const FileWatcher&);
+		FileWatcher& operator=(const FileWatcher&);
+	};
+
+} // namespace Rio
@@ -0,0 +1,238 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/FileSystem/Lz4.h"
+
+#include <cstring> // memcpy, memset
+
+namespace Rio
+{
+	namespace Lz4Fn
+	{
+		namespace
+		{
+			const uint32_t MIN_MATCH = 4;
+			// The format requires the last 5 bytes to be literals
+			// and the last match to start at least 12 bytes before the end
+			const size_t LAST_LITERALS = 5;
+			const size_t MATCH_FIND_LIMIT = 12;
+			const size_t MAX_OFFSET = 65535;
+			const uint32_t HASH_BITS = 12;
+
+			uint32_t read32(const uint8_t* p)
+			{
+				uint32_t value;
+				memcpy(&value, p, sizeof(value));
+				return value;
+			}
+
+			uint32_t hash(uint32_t sequence)
+			{
+				return (sequence * 2654435761u) >> (32 - HASH_BITS);
+			}
+
+			// Writes the extra bytes of a length that does not fit in its 4 bits
+			uint8_t* writeLength(uint8_t* op, size_t length)
+			{
+				while (length >= 255)
+				{
+					*op++ = 255;
+					length -= 255;
+				}
+				*op++ = uint8_t(length);
+				return op;
+			}
+
+			// Returns false if the input ends in the middle of the length
+			bool readLength(const uint8_t*& ip, const uint8_t* ipEnd, size_t& length)
+			{
+				uint8_t byte;
+				do
+				{
+					if (ip == ipEnd)
+					{
+						return false;
+					}
+					byte = *ip++;
+					length += byte;
+				}
+				while (byte == 255);
+				return true;
+			}
+
+			// Writes a sequence, matchLength 0 for the last one which has only literals.
+			// Returns nullptr if it does not fit.
+			uint8_t* writeSequence(uint8_t* op, uint8_t* opEnd, const uint8_t* literals, size_t literalsCount, size_t offset, size_t matchLength)
+			{
+				const size_t maxSize = 1 + literalsCount / 255 + 1 + literalsCount + 2 + matchLength / 255 + 1;
+				if (maxSize > size_t(opEnd - op))
+				{
+					return nullptr;
+				}
+
+				uint8_t* token = op++;
+				*token = uint8_t((literalsCount < 15 ? literalsCount : 15) << 4);
+				if (literalsCount >= 15)
+				{
+					op = writeLength(op, literalsCount - 15);
+				}
+				if (literalsCount > 0)
+				{
+					memcpy(op, literals, literalsCount);
+					op += literalsCount;
+				}
+
+				if (matchLength == 0)
+				{
+					return op;
+				}
+
+				*op++ = uint8_t(offset);
+				*op++ = uint8_t(offset >> 8);
+				const size_t length = matchLength - MIN_MATCH;
+				*token |= uint8_t(length < 15 ? length : 15);
+				if (length >= 15)
+				{
+					op = writeLength(op, length - 15);
+				}
+				return op;
+			}
+		} // namespace (anonymous)
+
+		size_t getMaxCompressedSize(size_t size)
+		{
+			return size + size / 255 + 16;
+		}
+
+		size_t compress(const void* src, size_t srcSize, void* dst, size_t dstCapacity)
+		{
+			const uint8_t* const begin = (const uint8_t*)src;
+			const uint8_t* const end = begin + srcSize;
+			const uint8_t* anchor = begin;
+			uint8_t* op = (uint8_t*)dst;
+			uint8_t* const opEnd = op + dstCapacity;
+
+			if (srcSize > MATCH_FIND_LIMIT)
+			{
+				const uint8_t* const matchFindLimit = end - MATCH_FIND_LIMIT;
+				const uint8_t* const matchLimit = end - LAST_LITERALS;
+
+				// Positions of the last occurrences of the hashed 4-byte sequences,
+				// the empty ones point at begin and are rejected by the comparison
+				uint32_t table[1 << HASH_BITS];
+				memset(table, 0, sizeof(table));
+
+				const uint8_t* ip = begin + 1;
+				while (ip < matchFindLimit)
+				{
+					const uint32_t sequence = read32(ip);
+					const uint32_t h = hash(sequence);
+					const uint8_t* match = begin + table[h];
+					table[h] = uint32_t(ip - begin);
+
+					if (match >= ip || size_t(ip - match) > MAX_OFFSET || read32(match) != sequence)
+					{
+						++ip;
+						continue;
+					}
+
+					while (ip > anchor && match > begin && ip[-1] == match[-1])
+					{
+						--ip;
+						--match;
+					}
+					size_t matchLength = MIN_MATCH;
+					while (ip + matchLength < matchLimit && ip[matchLength] == match[matchLength])
+					{
+						++matchLength;
+					}
+
+					op = writeSequence(op, opEnd, anchor, size_t(ip - anchor), size_t(ip - match), matchLength);
+					if (op == nullptr)
+					{
+						return 0;
+					}
+					ip += matchLength;
+					anchor = ip;
+				}
+			}
+
+			op = writeSequence(op, opEnd, anchor, size_t(end - anchor), 0, 0);
+			if (op == nullptr)
+			{
+				return 0;
+			}
+			return size_t(op - (uint8_t*)dst);
+		}
+
+		bool decompress(const void* src, size_t srcSize, void* dst, size_t dstSize)
+		{
+			const uint8_t* ip = (const uint8_t*)src;
+			const uint8_t* const ipEnd = ip + srcSize;
+			uint8_t* const begin = (uint8_t*)dst;
+			uint8_t* op = begin;
+			uint8_t* const opEnd = op + dstSize;
+
+			while (ip != ipEnd)
+			{
+				const uint8_t token = *ip++;
+
+				size_t literalsCount = token >> 4;
+				if (literalsCount == 15 && !readLength(ip, ipEnd, literalsCount))
+				{
+					return false;
+				}
+				if (literalsCount > size_t(ipEnd - ip) || literalsCount > size_t(opEnd - op))
+				{
+					return false;
+				}
+				memcpy(op, ip, literalsCount);
+				ip += literalsCount;
+				op += literalsCount;
+
+				// The last sequence has no match
+				if (ip == ipEnd)
+				{
+					break;
+				}
+
+				if (ipEnd - ip < 2)
+				{
+					return false;
+				}
+				const size_t offset = size_t(ip[0]) | (size_t(ip[1]) << 8);
+				ip += 2;
+				if (offset == 0 || offset > size_t(op - begin))
+				{
+					return false;
+				}
+
+				size_t matchLength = token & 15;
+				if (matchLength == 15 && !readLength(ip, ipEnd, matchLength))
+				{
+					return false;
+				}
+				matchLength += MIN_MATCH;
+				if (matchLength > size_t(opEnd - op))
+				{
+					return false;
+				}
+
+				const uint8_t* match = op - offset;
+				if (offset >= matchLength)
+				{
+					memcpy(op, match, matchLength);
+					op += matchLength;
+				}
+				else
+				{
+					// Overlapping match, repeats the last offset bytes
+					for (size_t i = 0; i < matchLength; ++i)
+					{
+						*op++ = *match++;
+					}
+				}
+			}
+			return op == opEnd;
+		}
+	} // namespace Lz4Fn
+
+} // namespace Rio
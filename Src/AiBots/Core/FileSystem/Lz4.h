@@ -0,0 +1,21 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#pragma once
+
+#include "Core/Base/Config.h"
+#include "Core/Base/Types.h"
+
+namespace Rio
+{
+	// Compression in the LZ4 block format (no frame header, no checksum).
+	// Favors decompression speed over ratio, used for the blocks of archives.
+	namespace Lz4Fn
+	{
+		// Returns the size of the largest output of compress() for size bytes of input
+		size_t getMaxCompressedSize(size_t size);
+		// Compresses src into dst and returns the compressed size, 0 if it does not fit in dstCapacity
+		size_t compress(const void* src, size_t srcSize, void* dst, size_t dstCapacity);
+		// Decompresses src into exactly dstSize bytes, returns false if src is corrupted
+		bool decompress(const void* src, size_t srcSize, void* dst, size_t dstSize);
+	} // namespace Lz4Fn
+
+} // namespace Rio
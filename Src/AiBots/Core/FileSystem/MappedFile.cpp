@@ -0,0 +1,108 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/FileSystem/MappedFile.h"
+
+#include "Core/Debug/Error.h"
+
+#include <cstring> // memcpy
+
+namespace Rio
+{
+	MappedFile::MappedFile()
+		: data(nullptr)
+		, size(0)
+		, position(0)
+	{
+	}
+
+	MappedFile::~MappedFile()
+	{
+		close();
+	}
+
+	void MappedFile::open(const char* path, FileOpenMode mode)
+	{
+		RIO_ASSERT_NOT_NULL(path);
+		RIO_ASSERT(mode == FileOpenMode::Read, "Mapped files are read-only");
+		RIO_UNUSED(mode);
+
+		close();
+		map(path);
+	}
+
+	void MappedFile::close()
+	{
+		if (isValid())
+		{
+			unmap();
+			data = nullptr;
+			size = 0;
+			position = 0;
+		}
+	}
+
+	void MappedFile::seek(size_t position)
+	{
+		RIO_ASSERT(position <= size, "Position out of bounds");
+		this->position = position;
+	}
+
+	void MappedFile::seekToEnd()
+	{
+		position = size;
+	}
+
+	void MappedFile::skip(size_t bytes)
+	{
+		RIO_ASSERT(position + bytes <= size, "Position out of bounds");
+		position += bytes;
+	}
+
+	size_t MappedFile::read(void* data, size_t size)
+	{
+		RIO_ASSERT_NOT_NULL(data);
+		const size_t available = this->size - position;
+		const size_t bytesRead = size < available ? size : available;
+		memcpy(data, this->data + position, bytesRead);
+		position += bytesRead;
+		return bytesRead;
+	}
+
+	size_t MappedFile::write(const void* data, size_t size)
+	{
+		RIO_FATAL("Mapped files are read-only");
+		RIO_UNUSED(data);
+		RIO_UNUSED(size);
+		return 0;
+	}
+
+	void MappedFile::flush()
+	{
+	}
+
+	bool MappedFile::isValid()
+	{
+		return data != nullptr;
+	}
+
+	bool MappedFile::getIsEndOfFile()
+	{
+		return position == size;
+	}
+
+	size_t MappedFile::getFileSize()
+	{
+		return size;
+	}
+
+	size_t MappedFile::getFilePosition()
+	{
+		return position;
+	}
+
+	bool MappedFile::getIsNulTerminated() const
+	{
+		// Empty files are not mapped, data is ""
+		return size == 0 || size % getPageSize() != 0;
+	}
+
+} // namespace Rio
@@ -0,0 +1,71 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#pragma once
+
+#include "Core/Base/Config.h"
+#include "Core/Base/Platform.h"
+
+#include "Core/Base/Types.h"
+#include "Core/FileSystem/File.h"
+#include "Core/FileSystem/OsFile.h" // FileAccessPattern
+
+namespace Rio
+{
+	// Read-only file mapped into memory.
+	// The contents are accessed in place with getData(), pages are loaded by the OS on first access
+	// and shared with the page cache, nothing is copied.
+	// read() is supported as well and copies from the mapping.
+	class MappedFile : public File
+	{
+	public:
+		MappedFile();
+		virtual ~MappedFile();
+		// Maps the whole file, mode must be FileOpenMode::Read
+		void open(const char* path, FileOpenMode mode);
+		void close();
+		void seek(size_t position);
+		void seekToEnd();
+		void skip(size_t bytes);
+		size_t read(void* data, size_t size);
+		// Mapped files are read-only
+		size_t write(const void* data, size_t size);
+		void flush();
+		bool isValid();
+		bool getIsEndOfFile();
+		size_t getFileSize();
+		size_t getFilePosition();
+
+		// Returns the contents of the file, valid until the file is closed
+		const char* getData() const
+		{
+			return data;
+		}
+
+		size_t getSize() const
+		{
+			return size;
+		}
+
+		// Returns whether a '\0' follows the last byte of the file, i.e. getData() can be used as a C string.
+		// The OS fills the rest of the last page with zeros, so it is true unless the size is a multiple of the page size.
+		bool getIsNulTerminated() const;
+		// Tells the OS how the range will be accessed, length 0 means up to the end of the file.
+		// It is a hint, ignored where it is not supported.
+		void advise(FileAccessPattern::Enum pattern, size_t offset = 0, size_t length = 0);
+
+		// Returns the size of the pages of the mappings
+		static size_t getPageSize();
+	private:
+		// Implemented per platform
+		void map(const char* path);
+		void unmap();
+
+		const char* data;
+		size_t size;
+		size_t position;
+	private:
+		// Disable copying
+		MappedFile(const MappedFile&);
+		MappedFile& operator=(const MappedFile&);
+	};
+
+} // namespace Rio
@@ -9,7 +9,6 @@
 #include "Core/FileSystem/File.h" // FileOpenMode
 
 #if RIO_PLATFORM_POSIX
-	#include <cstdio>
 	#include <errno.h>
 #elif RIO_PLATFORM_WINDOWS
 	#include "tchar.h"
@@ -18,10 +17,41 @@
 
 namespace Rio
 {
+	struct OsFileFlags
+	{
+		enum Enum
+		{
+			NONE = 0,
+			// Bypasses the OS page cache, for large sequential reads of data used once.
+			// Buffers, sizes and offsets must be multiples of OsFile::DIRECT_ALIGNMENT,
+			// the size may go past the end of the file.
+			// Falls back to cached access where the file system does not support it.
+			DIRECT = 1 << 0
+		};
+	};
+
+	// Expected access pattern of a range of the file, see OsFile::advise()
+	struct FileAccessPattern
+	{
+		enum Enum
+		{
+			NORMAL,
+			SEQUENTIAL,
+			RANDOM,
+			// The range will be read soon, start reading it ahead
+			WILL_NEED,
+			// The range will not be read again, drop it from the page cache
+			DONT_NEED
+		};
+	};
+
 	// OS file wrapper
 	class OsFile
 	{
 	public:
+		// Alignment of buffers, sizes and offsets in OsFileFlags::DIRECT mode
+		static const size_t DIRECT_ALIGNMENT = 4096;
+
 		OsFile()
 		{}
 
@@ -30,7 +60,8 @@ namespace Rio
 			close();
 		}
 
-		void open(const char* path, FileOpenMode mode);
+		// flags is a combination of OsFileFlags
+		void open(const char* path, FileOpenMode mode, uint32_t flags = OsFileFlags::NONE);
 		void close();
 		bool isFileOpen() const;
 		size_t getFileSize() const;
@@ -51,12 +82,38 @@ namespace Rio
 		size_t getFilePosition() const;
 		// Returns whether the file pointer is at the end of the file.
 		bool getIsEndOfFile() const;
+		// Returns whether the file was opened with OsFileFlags::DIRECT and the OS honored it
+		bool getIsDirect() const;
+
+		// Reads size bytes at offset from the start of the file into data.
+		// Returns the number of bytes read, less than size at the end of the file.
+		// Does not use the file pointer, several threads can read the same file at once.
+		// On Windows the handle is synchronous and the file pointer is left after the bytes read,
+		// do not mix readAt() with read() or seek() on the same file there.
+		size_t readAt(void* data, size_t size, size_t offset) const;
+		// Writes size bytes of data at offset from the start of the file.
+		// Does not use the file pointer, on Windows it is left after the bytes written like readAt().
+		size_t writeAt(const void* data, size_t size, size_t offset);
+		// Tells the OS how the range will be accessed, length 0 means up to the end of the file.
+		// It is a hint, ignored where it is not supported.
+		void advise(FileAccessPattern::Enum pattern, size_t offset = 0, size_t length = 0);
+#if RIO_PLATFORM_POSIX
+		int getFileDescriptor() const
+		{
+			return file;
+		}
+#endif // RIO_PLATFORM_POSIX
 	private:
 #if RIO_PLATFORM_POSIX
-		FILE* file = NULL;
+		int file = -1;
+		// The file pointer is kept here, read() and write() are done with pread() and pwrite()
+		size_t position = 0;
+		bool isEndOfFile = false;
+		bool isDirect = false;
 #elif RIO_PLATFORM_WINDOWS
 		HANDLE file = INVALID_HANDLE_VALUE;
 		bool isEndOfFile = false;
+		bool isDirect = false;
 #endif
 	};
 
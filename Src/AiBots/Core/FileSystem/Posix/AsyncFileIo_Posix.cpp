@@ -0,0 +1,403 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/FileSystem/AsyncFileIo.h"
+
+#if RIO_IO_URING
+
+#include "Core/Debug/Error.h"
+#include "Core/Thread/Atomic.h"
+#include "Core/Thread/ScopedMutex.h"
+
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h> // mmap, munmap
+#include <sys/syscall.h>
+#include <unistd.h> // close, read, write
+
+#include <cstring> // memset
+
+namespace Rio
+{
+	namespace
+	{
+		// user_data of the read of the wake-up eventfd, the reads use their slot index
+		const uint64_t WAKE_USER_DATA = uint64_t(-1);
+		// Longer reads are split, io_uring lengths are 32-bit
+		const size_t MAX_READ_SIZE = size_t(1) << 30;
+
+		int ioUringSetup(uint32_t entries, io_uring_params* params)
+		{
+			return (int)syscall(__NR_io_uring_setup, entries, params);
+		}
+
+		int ioUringEnter(int ringFd, uint32_t toSubmit, uint32_t minComplete, uint32_t flags)
+		{
+			return (int)syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, nullptr, 0);
+		}
+
+		int ioUringRegister(int ringFd, uint32_t opcode, void* arg, uint32_t argsCount)
+		{
+			return (int)syscall(__NR_io_uring_register, ringFd, opcode, arg, argsCount);
+		}
+
+		// IORING_OP_READ needs Linux 5.6, the probe was added in the same version
+		bool isReadSupported(int ringFd)
+		{
+			const uint32_t opsCount = 256;
+			char buffer[sizeof(io_uring_probe) + opsCount * sizeof(io_uring_probe_op)];
+			memset(buffer, 0, sizeof(buffer));
+			io_uring_probe* probe = (io_uring_probe*)buffer;
+
+			if (ioUringRegister(ringFd, IORING_REGISTER_PROBE, probe, opsCount) < 0)
+			{
+				return false;
+			}
+			return probe->last_op >= IORING_OP_READ
+				&& (probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED) != 0;
+		}
+	} // namespace (anonymous)
+
+	struct AsyncFileIo::IoUring
+	{
+		// A read in flight
+		struct Slot
+		{
+			Id id;
+			AsyncReadRequest params;
+			size_t bytesRead;
+			bool isUsed;
+		};
+
+		int ringFd;
+		int wakeFd;
+		uint64_t wakeValue;
+
+		void* sqRing;
+		size_t sqRingSize;
+		void* cqRing;
+		size_t cqRingSize;
+		io_uring_sqe* sqes;
+		size_t sqesSize;
+
+		uint32_t* sqTail;
+		uint32_t* sqMask;
+		uint32_t* sqArray;
+		uint32_t* cqHead;
+		uint32_t* cqTail;
+		uint32_t* cqMask;
+		io_uring_cqe* cqes;
+
+		uint32_t toSubmit;
+		Array<Slot> slots;
+		uint32_t usedSlotsCount;
+		Thread thread;
+
+		IoUring(Allocator& a)
+			: ringFd(-1)
+			, wakeFd(-1)
+			, wakeValue(0)
+			, sqRing(MAP_FAILED)
+			, sqRingSize(0)
+			, cqRing(MAP_FAILED)
+			, cqRingSize(0)
+			, sqes((io_uring_sqe*)MAP_FAILED)
+			, sqesSize(0)
+			, toSubmit(0)
+			, slots(a)
+			, usedSlotsCount(0)
+		{
+		}
+
+		~IoUring()
+		{
+			if (sqes != MAP_FAILED)
+			{
+				munmap(sqes, sqesSize);
+			}
+			if (cqRing != MAP_FAILED && cqRing != sqRing)
+			{
+				munmap(cqRing, cqRingSize);
+			}
+			if (sqRing != MAP_FAILED)
+			{
+				munmap(sqRing, sqRingSize);
+			}
+			if (wakeFd != -1)
+			{
+				close(wakeFd);
+			}
+			if (ringFd != -1)
+			{
+				close(ringFd);
+			}
+		}
+
+		bool create(uint32_t queueDepth)
+		{
+			// One more entry for the read of wakeFd
+			io_uring_params params;
+			memset(&params, 0, sizeof(params));
+			ringFd = ioUringSetup(queueDepth + 1, &params);
+			if (ringFd < 0)
+			{
+				// ENOSYS on old kernels, EPERM where it is disabled
+				ringFd = -1;
+				return false;
+			}
+			if (!isReadSupported(ringFd))
+			{
+				return false;
+			}
+
+			sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+			cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+			if ((params.features & IORING_FEAT_SINGLE_MMAP) != 0)
+			{
+				sqRingSize = sqRingSize > cqRingSize ? sqRingSize : cqRingSize;
+				cqRingSize = sqRingSize;
+			}
+
+			sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+			if (sqRing == MAP_FAILED)
+			{
+				return false;
+			}
+			if ((params.features & IORING_FEAT_SINGLE_MMAP) != 0)
+			{
+				cqRing = sqRing;
+			}
+			else
+			{
+				cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+				if (cqRing == MAP_FAILED)
+				{
+					return false;
+				}
+			}
+			sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+			sqes = (io_uring_sqe*)mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+			if (sqes == MAP_FAILED)
+			{
+				return false;
+			}
+
+			char* sq = (char*)sqRing;
+			sqTail = (uint32_t*)(sq + params.sq_off.tail);
+			sqMask = (uint32_t*)(sq + params.sq_off.ring_mask);
+			sqArray = (uint32_t*)(sq + params.sq_off.array);
+			char* cq = (char*)cqRing;
+			cqHead = (uint32_t*)(cq + params.cq_off.head);
+			cqTail = (uint32_t*)(cq + params.cq_off.tail);
+			cqMask = (uint32_t*)(cq + params.cq_off.ring_mask);
+			cqes = (io_uring_cqe*)(cq + params.cq_off.cqes);
+
+			wakeFd = eventfd(0, EFD_CLOEXEC);
+			if (wakeFd == -1)
+			{
+				return false;
+			}
+
+			ArrayFn::resize(slots, queueDepth);
+			for (uint32_t i = 0; i < queueDepth; ++i)
+			{
+				slots[i].isUsed = false;
+			}
+			return true;
+		}
+
+		// Only the ring thread submits, the kernel only reads the tail
+		io_uring_sqe& getSqe()
+		{
+			const uint32_t tail = *sqTail;
+			const uint32_t index = tail & *sqMask;
+			io_uring_sqe& sqe = sqes[index];
+			memset(&sqe, 0, sizeof(sqe));
+			sqArray[index] = index;
+			AtomicFn::store(sqTail, tail + 1, MemoryOrder::RELEASE);
+			++toSubmit;
+			return sqe;
+		}
+
+		void submitWakeRead()
+		{
+			io_uring_sqe& sqe = getSqe();
+			sqe.opcode = IORING_OP_READ;
+			sqe.fd = wakeFd;
+			sqe.addr = (uint64_t)(uintptr_t)&wakeValue;
+			sqe.len = sizeof(wakeValue);
+			sqe.user_data = WAKE_USER_DATA;
+		}
+
+		void submitRead(uint32_t slotIndex)
+		{
+			const Slot& slot = slots[slotIndex];
+			const size_t remaining = slot.params.size - slot.bytesRead;
+
+			io_uring_sqe& sqe = getSqe();
+			sqe.opcode = IORING_OP_READ;
+			sqe.fd = slot.params.file->getFileDescriptor();
+			sqe.addr = (uint64_t)(uintptr_t)((char*)slot.params.data + slot.bytesRead);
+			sqe.len = uint32_t(remaining < MAX_READ_SIZE ? remaining : MAX_READ_SIZE);
+			sqe.off = uint64_t(slot.params.offset + slot.bytesRead);
+			sqe.user_data = slotIndex;
+		}
+
+		// Returns the index of a free slot or uint32_t(-1)
+		uint32_t findFreeSlot() const
+		{
+			for (uint32_t i = 0; i < ArrayFn::getCount(slots); ++i)
+			{
+				if (!slots[i].isUsed)
+				{
+					return i;
+				}
+			}
+			return uint32_t(-1);
+		}
+	};
+
+	bool AsyncFileIo::createIoUring(uint32_t queueDepth)
+	{
+		RIO_ASSERT(queueDepth > 0, "Queue depth must be > 0");
+
+		IoUring* ring = allocator->makeNew<IoUring>(*allocator);
+		if (!ring->create(queueDepth))
+		{
+			allocator->makeDelete(ring);
+			return false;
+		}
+
+		ioUring = ring;
+		ring->thread.start(ioUringMain, this);
+		return true;
+	}
+
+	void AsyncFileIo::destroyIoUring()
+	{
+		// isStopping is set, the thread exits when the reads in flight are done
+		wakeIoUring();
+		ioUring->thread.stop();
+		allocator->makeDelete(ioUring);
+		ioUring = nullptr;
+	}
+
+	void AsyncFileIo::wakeIoUring()
+	{
+		const uint64_t one = 1;
+		ssize_t result;
+		do
+		{
+			result = write(ioUring->wakeFd, &one, sizeof(one));
+		}
+		while (result == -1 && errno == EINTR);
+		// EAGAIN only when the counter is full, the thread is being woken up anyway
+		RIO_ASSERT(result == sizeof(one) || errno == EAGAIN, "write: errno = %d", errno);
+	}
+
+	int32_t AsyncFileIo::ioUringMain(void* data)
+	{
+		AsyncFileIo* io = (AsyncFileIo*)data;
+		IoUring& ring = *io->ioUring;
+
+		ring.submitWakeRead();
+		bool isWakeReadInFlight = true;
+
+		while (true)
+		{
+			bool isStopping;
+			{
+				ScopedMutex sm(io->mutex);
+				isStopping = io->isStopping;
+			}
+
+			// Starts pending reads while there are free slots, by priority
+			while (!isStopping && ring.usedSlotsCount < ArrayFn::getCount(ring.slots))
+			{
+				Id id;
+				AsyncReadRequest params;
+				if (!io->popPending(id, params))
+				{
+					break;
+				}
+				const uint32_t slotIndex = ring.findFreeSlot();
+				IoUring::Slot& slot = ring.slots[slotIndex];
+				slot.id = id;
+				slot.params = params;
+				slot.bytesRead = 0;
+				slot.isUsed = true;
+				++ring.usedSlotsCount;
+				ring.submitRead(slotIndex);
+			}
+
+			if (isStopping && ring.usedSlotsCount == 0)
+			{
+				// The read of wakeFd still in flight is dropped with the ring
+				return 0;
+			}
+
+			// Submits and sleeps until at least one read or a wake-up is done
+			const int result = ioUringEnter(ring.ringFd, ring.toSubmit, 1, IORING_ENTER_GETEVENTS);
+			if (result < 0)
+			{
+				RIO_ASSERT(errno == EINTR || errno == EAGAIN || errno == EBUSY, "io_uring_enter: errno = %d", errno);
+				continue;
+			}
+			ring.toSubmit -= uint32_t(result) < ring.toSubmit ? uint32_t(result) : ring.toSubmit;
+
+			uint32_t head = *ring.cqHead;
+			const uint32_t tail = AtomicFn::load(ring.cqTail, MemoryOrder::ACQUIRE);
+			for (; head != tail; ++head)
+			{
+				const io_uring_cqe& cqe = ring.cqes[head & *ring.cqMask];
+
+				if (cqe.user_data == WAKE_USER_DATA)
+				{
+					isWakeReadInFlight = false;
+					continue;
+				}
+
+				IoUring::Slot& slot = ring.slots[uint32_t(cqe.user_data)];
+				if (cqe.res == -EINTR || cqe.res == -EAGAIN)
+				{
+					ring.submitRead(uint32_t(cqe.user_data));
+					continue;
+				}
+
+				AsyncIoStatus::Enum status = AsyncIoStatus::COMPLETED;
+				bool isDone = true;
+				if (cqe.res < 0)
+				{
+					status = AsyncIoStatus::FAILED;
+				}
+				else if (cqe.res > 0)
+				{
+					slot.bytesRead += size_t(cqe.res);
+					// Same rules as OsFile::readAt(), short reads before the end of the file are resumed
+					const bool isLastDirectBlock = slot.params.file->getIsDirect() && slot.bytesRead % OsFile::DIRECT_ALIGNMENT != 0;
+					isDone = slot.bytesRead == slot.params.size || isLastDirectBlock;
+				}
+
+				if (isDone)
+				{
+					io->complete(slot.id, slot.bytesRead, status);
+					slot.isUsed = false;
+					--ring.usedSlotsCount;
+				}
+				else
+				{
+					ring.submitRead(uint32_t(cqe.user_data));
+				}
+			}
+			AtomicFn::store(ring.cqHead, head, MemoryOrder::RELEASE);
+
+			if (!isWakeReadInFlight && !isStopping)
+			{
+				ring.submitWakeRead();
+				isWakeReadInFlight = true;
+			}
+		}
+	}
+
+} // namespace Rio
+
+#endif // RIO_IO_URING
@@ -0,0 +1,169 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/FileSystem/DirectoryScanner.h"
+
+#if RIO_PLATFORM_POSIX
+
+#include "Core/Debug/Error.h"
+
+#include <dirent.h> // DIR, fdopendir, readdir
+#include <fcntl.h> // open, openat
+#include <string.h> // strlen
+#include <sys/stat.h> // fstat, fstatat
+#include <unistd.h> // close
+
+#if RIO_PLATFORM_LINUX
+	#include <sys/syscall.h> // SYS_getdents64
+#endif // RIO_PLATFORM_LINUX
+
+namespace Rio
+{
+	namespace
+	{
+		uint64_t getModifiedTime(const struct stat& info)
+		{
+#if RIO_PLATFORM_OSX || RIO_PLATFORM_IOS
+			return uint64_t(info.st_mtimespec.tv_sec) * 1000000000 + uint64_t(info.st_mtimespec.tv_nsec);
+#else
+			return uint64_t(info.st_mtim.tv_sec) * 1000000000 + uint64_t(info.st_mtim.tv_nsec);
+#endif // RIO_PLATFORM_OSX || RIO_PLATFORM_IOS
+		}
+
+		DirectoryEntryType::Enum getType(mode_t mode)
+		{
+			if (S_ISREG(mode))
+			{
+				return DirectoryEntryType::FILE;
+			}
+			if (S_ISDIR(mode))
+			{
+				return DirectoryEntryType::DIRECTORY;
+			}
+			return DirectoryEntryType::OTHER;
+		}
+
+		bool isDotOrDotDot(const char* name)
+		{
+			return name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'));
+		}
+
+#if RIO_PLATFORM_LINUX
+		// Layout of the records returned by getdents64(), glibc does not declare it
+		struct LinuxDirent64
+		{
+			uint64_t ino;
+			int64_t offset;
+			uint16_t recordLength;
+			uint8_t type;
+			char name[1];
+		};
+#endif // RIO_PLATFORM_LINUX
+	} // namespace (anonymous)
+
+	bool DirectoryScanner::openRoot(const char* osPath, uint64_t& lastModifiedTime)
+	{
+		rootFd = ::open(osPath, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		if (rootFd == -1)
+		{
+			return false;
+		}
+
+		struct stat info;
+		if (fstat(rootFd, &info) != 0)
+		{
+			closeRoot();
+			return false;
+		}
+		lastModifiedTime = getModifiedTime(info);
+		return true;
+	}
+
+	void DirectoryScanner::closeRoot()
+	{
+		if (rootFd != -1)
+		{
+			::close(rootFd);
+			rootFd = -1;
+		}
+	}
+
+	bool DirectoryScanner::getIsFile(const char* osPath)
+	{
+		struct stat info;
+		return fstatat(AT_FDCWD, osPath, &info, 0) == 0 && S_ISREG(info.st_mode);
+	}
+
+	void DirectoryScanner::listDirectory(Worker& worker, const PendingDirectory& directory, const Listing* cachedListing)
+	{
+		// Opened relative to the root, the paths stay short and the root cannot be renamed under us
+		const int fd = openat(rootFd, directory.pathLength > 0 ? directory.path : ".", O_RDONLY | O_DIRECTORY | O_CLOEXEC | O_NOFOLLOW);
+		if (fd == -1)
+		{
+			// Removed or not readable, skipped
+			return;
+		}
+
+		struct stat info;
+		if (cachedListing != nullptr)
+		{
+			for (uint32_t i = 0; i < cachedListing->entriesCount; ++i)
+			{
+				const DirectoryEntry& cached = cache->entries[cachedListing->firstEntry + i];
+				// The cache stores the full paths, only the name is relative to fd
+				const char* name = cached.path + directory.pathLength + (directory.pathLength > 0 ? 1 : 0);
+				const size_t nameLength = cached.pathLength - size_t(name - cached.path);
+				if (fstatat(fd, name, &info, AT_SYMLINK_NOFOLLOW) == 0)
+				{
+					addEntry(worker, directory, name, nameLength, getType(info.st_mode), uint64_t(info.st_size), getModifiedTime(info));
+				}
+			}
+			::close(fd);
+			return;
+		}
+
+#if RIO_PLATFORM_LINUX
+		// getdents64() fills the whole buffer per call, readdir() goes through libc's smaller one
+		char buffer[32 * 1024];
+		while (true)
+		{
+			const long bytesRead = syscall(SYS_getdents64, fd, buffer, sizeof(buffer));
+			if (bytesRead <= 0)
+			{
+				break;
+			}
+
+			for (long offset = 0; offset < bytesRead;)
+			{
+				const LinuxDirent64* record = (const LinuxDirent64*)(buffer + offset);
+				offset += record->recordLength;
+
+				if (isDotOrDotDot(record->name) || fstatat(fd, record->name, &info, AT_SYMLINK_NOFOLLOW) != 0)
+				{
+					continue;
+				}
+				addEntry(worker, directory, record->name, strlen(record->name), getType(info.st_mode), uint64_t(info.st_size), getModifiedTime(info));
+			}
+		}
+		::close(fd);
+#else
+		// fdopendir() owns fd, closedir() closes it
+		DIR* dir = fdopendir(fd);
+		if (dir == nullptr)
+		{
+			::close(fd);
+			return;
+		}
+		for (struct dirent* record = readdir(dir); record != nullptr; record = readdir(dir))
+		{
+			if (isDotOrDotDot(record->d_name) || fstatat(fd, record->d_name, &info, AT_SYMLINK_NOFOLLOW) != 0)
+			{
+				continue;
+			}
+			addEntry(worker, directory, record->d_name, strlen(record->d_name), getType(info.st_mode), uint64_t(info.st_size), getModifiedTime(info));
+		}
+		closedir(dir);
+#endif // RIO_PLATFORM_LINUX
+	}
+
+} // namespace Rio
+
+#endif // RIO_PLATFORM_POSIX
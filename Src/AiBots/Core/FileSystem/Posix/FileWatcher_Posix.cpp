@@ -0,0 +1,388 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/FileSystem/FileWatcher.h"
+
+#if RIO_PLATFORM_POSIX
+
+#include "Core/Debug/Error.h"
+
+#if RIO_PLATFORM_LINUX
+	#include "Core/Thread/Thread.h"
+
+	#include <dirent.h> // opendir, readdir
+	#include <errno.h>
+	#include <poll.h>
+	#include <sys/eventfd.h>
+	#include <sys/inotify.h>
+	#include <sys/stat.h> // lstat
+	#include <time.h> // clock_gettime
+	#include <unistd.h> // close, read, write
+
+	#include <cstdio> // snprintf
+	#include <cstring> // memcpy, strlen
+#endif // RIO_PLATFORM_LINUX
+
+namespace Rio
+{
+#if RIO_PLATFORM_LINUX
+	namespace
+	{
+		const uint32_t DIRECTORY_MASK = IN_ONLYDIR | IN_CREATE | IN_DELETE | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO;
+		const uint32_t MAX_PATH_LENGTH = FileWatchEvent::MAX_PATH_LENGTH;
+
+		int64_t getMilliseconds()
+		{
+			timespec now;
+			clock_gettime(CLOCK_MONOTONIC, &now);
+			return int64_t(now.tv_sec) * 1000 + now.tv_nsec / 1000000;
+		}
+	} // namespace (anonymous)
+
+	struct FileWatcher::Backend
+	{
+		// Directory watched by inotify
+		struct Directory
+		{
+			int wd;
+			// Relative to the watched directory, "" for itself
+			char path[MAX_PATH_LENGTH];
+		};
+
+		FileWatcher* watcher;
+		int inotifyFd;
+		int wakeFd;
+		char rootPath[MAX_PATH_LENGTH];
+		Array<Directory> directories;
+		// Index in directories of the watch descriptors
+		HashMap<uint32_t> directoryIndices;
+		Thread thread;
+
+		Backend(Allocator& a, FileWatcher& watcher)
+			: watcher(&watcher)
+			, inotifyFd(-1)
+			, wakeFd(-1)
+			, directories(a)
+			, directoryIndices(a)
+		{
+		}
+
+		~Backend()
+		{
+			if (wakeFd != -1)
+			{
+				close(wakeFd);
+			}
+			if (inotifyFd != -1)
+			{
+				close(inotifyFd);
+			}
+		}
+
+		// Watches the directory and its subdirectories.
+		// reportFiles is set for directories added while watching, their files are reported as added.
+		void addDirectory(const char* path, size_t length, bool reportFiles, int64_t now)
+		{
+			char osPath[2 * MAX_PATH_LENGTH];
+			const size_t rootLength = strlen(rootPath);
+			memcpy(osPath, rootPath, rootLength);
+			osPath[rootLength] = '/';
+			memcpy(osPath + rootLength + 1, path, length);
+			osPath[rootLength + 1 + length] = '\0';
+
+			const int wd = inotify_add_watch(inotifyFd, osPath, DIRECTORY_MASK);
+			if (wd == -1)
+			{
+				// Removed meanwhile or out of watches (fs.inotify.max_user_watches)
+				if (errno != ENOENT && errno != ENOTDIR)
+				{
+					watcher->addEventsLost();
+				}
+				return;
+			}
+
+			// The same directory moved back gets its watch descriptor back
+			Directory directory;
+			directory.wd = wd;
+			memcpy(directory.path, path, length);
+			directory.path[length] = '\0';
+			const uint32_t index = HashMapFn::get(directoryIndices, uint64_t(wd), uint32_t(ArrayFn::getCount(directories)));
+			if (index == ArrayFn::getCount(directories))
+			{
+				ArrayFn::pushBack(directories, directory);
+				HashMapFn::set(directoryIndices, uint64_t(wd), index);
+			}
+			else
+			{
+				directories[index] = directory;
+			}
+
+			// Files created before the watch was added are found here
+			DIR* dir = opendir(osPath);
+			if (dir == nullptr)
+			{
+				return;
+			}
+			while (dirent* entry = readdir(dir))
+			{
+				if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+				{
+					continue;
+				}
+
+				char childPath[MAX_PATH_LENGTH];
+				const size_t childLength = makePath(path, length, entry->d_name, childPath);
+				if (childLength == 0)
+				{
+					watcher->addEventsLost();
+					continue;
+				}
+
+				bool isDirectory = entry->d_type == DT_DIR;
+				if (entry->d_type == DT_UNKNOWN)
+				{
+					// Not filled by every file system
+					char childOsPath[2 * MAX_PATH_LENGTH + 1];
+					snprintf(childOsPath, sizeof(childOsPath), "%s/%s", rootPath, childPath);
+					struct stat info;
+					isDirectory = lstat(childOsPath, &info) == 0 && S_ISDIR(info.st_mode);
+				}
+
+				if (isDirectory)
+				{
+					addDirectory(childPath, childLength, reportFiles, now);
+				}
+				else if (reportFiles)
+				{
+					watcher->addChange(childPath, childLength, FileWatchAction::ADDED, now);
+				}
+			}
+			closedir(dir);
+		}
+
+		// Stops watching the directory and its subdirectories
+		void removeDirectory(const char* path, size_t length)
+		{
+			for (uint32_t i = 0; i < ArrayFn::getCount(directories); ++i)
+			{
+				const Directory& directory = directories[i];
+				if (strncmp(directory.path, path, length) == 0 && (directory.path[length] == '\0' || directory.path[length] == '/'))
+				{
+					// IN_IGNORED follows and forgets it
+					inotify_rm_watch(inotifyFd, directory.wd);
+				}
+			}
+		}
+
+		void forgetDirectory(int wd)
+		{
+			const uint32_t index = HashMapFn::get(directoryIndices, uint64_t(wd), UINT32_MAX);
+			if (index == UINT32_MAX)
+			{
+				return;
+			}
+			HashMapFn::remove(directoryIndices, uint64_t(wd));
+
+			const uint32_t last = uint32_t(ArrayFn::getCount(directories) - 1);
+			if (index != last)
+			{
+				directories[index] = directories[last];
+				HashMapFn::set(directoryIndices, uint64_t(directories[index].wd), index);
+			}
+			ArrayFn::popBack(directories);
+		}
+
+		// Joins directory and name in path, returns the length or 0 if it is too long
+		static size_t makePath(const char* directory, size_t directoryLength, const char* name, char* path)
+		{
+			const size_t nameLength = strlen(name);
+			const size_t length = directoryLength + (directoryLength > 0 ? 1 : 0) + nameLength;
+			if (length >= MAX_PATH_LENGTH)
+			{
+				return 0;
+			}
+
+			char* out = path;
+			memcpy(out, directory, directoryLength);
+			out += directoryLength;
+			if (directoryLength > 0)
+			{
+				*out++ = '/';
+			}
+			memcpy(out, name, nameLength + 1);
+			return length;
+		}
+
+		void handleEvent(const inotify_event& event, int64_t now)
+		{
+			if ((event.mask & IN_Q_OVERFLOW) != 0)
+			{
+				watcher->addEventsLost();
+				return;
+			}
+			if ((event.mask & IN_IGNORED) != 0)
+			{
+				forgetDirectory(event.wd);
+				return;
+			}
+
+			const uint32_t index = HashMapFn::get(directoryIndices, uint64_t(event.wd), UINT32_MAX);
+			if (index == UINT32_MAX || event.len == 0)
+			{
+				return;
+			}
+
+			char path[MAX_PATH_LENGTH];
+			const Directory& directory = directories[index];
+			const size_t length = makePath(directory.path, strlen(directory.path), event.name, path);
+			if (length == 0)
+			{
+				watcher->addEventsLost();
+				return;
+			}
+
+			if ((event.mask & IN_ISDIR) != 0)
+			{
+				if ((event.mask & (IN_CREATE | IN_MOVED_TO)) != 0)
+				{
+					addDirectory(path, length, true, now);
+				}
+				else if ((event.mask & IN_MOVED_FROM) != 0)
+				{
+					// Its files are not reported one by one
+					removeDirectory(path, length);
+					watcher->addChange(path, length, FileWatchAction::REMOVED, now);
+				}
+				// A deleted directory was emptied first, its files were reported
+				return;
+			}
+
+			if ((event.mask & (IN_CREATE | IN_MOVED_TO)) != 0)
+			{
+				watcher->addChange(path, length, FileWatchAction::ADDED, now);
+			}
+			else if ((event.mask & IN_CLOSE_WRITE) != 0)
+			{
+				watcher->addChange(path, length, FileWatchAction::MODIFIED, now);
+			}
+			else if ((event.mask & (IN_DELETE | IN_MOVED_FROM)) != 0)
+			{
+				watcher->addChange(path, length, FileWatchAction::REMOVED, now);
+			}
+		}
+	};
+
+	void FileWatcher::createBackend(const char* osPath)
+	{
+		if (strlen(osPath) >= MAX_PATH_LENGTH)
+		{
+			return;
+		}
+
+		Backend* watcherBackend = allocator->makeNew<Backend>(*allocator, *this);
+		watcherBackend->inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		watcherBackend->wakeFd = eventfd(0, EFD_CLOEXEC);
+		if (watcherBackend->inotifyFd == -1 || watcherBackend->wakeFd == -1)
+		{
+			allocator->makeDelete(watcherBackend);
+			return;
+		}
+		strcpy(watcherBackend->rootPath, osPath);
+
+		// The existing files are not reported
+		watcherBackend->addDirectory("", 0, false, getMilliseconds());
+		if (ArrayFn::getCount(watcherBackend->directories) == 0)
+		{
+			allocator->makeDelete(watcherBackend);
+			return;
+		}
+
+		backend = watcherBackend;
+		backend->thread.start(watcherMain, this);
+	}
+
+	void FileWatcher::destroyBackend()
+	{
+		const uint64_t one = 1;
+		ssize_t result;
+		do
+		{
+			result = write(backend->wakeFd, &one, sizeof(one));
+		}
+		while (result == -1 && errno == EINTR);
+
+		backend->thread.stop();
+		allocator->makeDelete(backend);
+		backend = nullptr;
+	}
+
+	int32_t FileWatcher::watcherMain(void* data)
+	{
+		FileWatcher* watcher = (FileWatcher*)data;
+		Backend& backend = *watcher->backend;
+
+		// Aligned as inotify_event, large enough for at least one event with the longest name
+		alignas(inotify_event) char buffer[16 * 1024];
+
+		int32_t timeout = -1;
+		while (true)
+		{
+			pollfd fds[2];
+			fds[0].fd = backend.inotifyFd;
+			fds[0].events = POLLIN;
+			fds[0].revents = 0;
+			fds[1].fd = backend.wakeFd;
+			fds[1].events = POLLIN;
+			// Not written by poll() when it fails with EINTR
+			fds[1].revents = 0;
+
+			const int result = poll(fds, 2, timeout);
+			RIO_ASSERT(result != -1 || errno == EINTR, "poll: errno = %d", errno);
+			RIO_UNUSED(result);
+
+			if ((fds[1].revents & POLLIN) != 0)
+			{
+				// Woken up by destroyBackend()
+				return 0;
+			}
+
+			const int64_t now = getMilliseconds();
+			if ((fds[0].revents & POLLIN) != 0)
+			{
+				ssize_t size;
+				while ((size = read(backend.inotifyFd, buffer, sizeof(buffer))) > 0)
+				{
+					for (const char* p = buffer; p < buffer + size; )
+					{
+						const inotify_event& event = *(const inotify_event*)p;
+						backend.handleEvent(event, now);
+						p += sizeof(inotify_event) + event.len;
+					}
+				}
+			}
+
+			timeout = watcher->publishChanges(now);
+		}
+	}
+
+#else
+
+	void FileWatcher::createBackend(const char* osPath)
+	{
+		// No inotify, FSEvents would be needed on OS X
+		RIO_UNUSED(osPath);
+	}
+
+	void FileWatcher::destroyBackend()
+	{
+	}
+
+	int32_t FileWatcher::watcherMain(void* data)
+	{
+		RIO_UNUSED(data);
+		return 0;
+	}
+
+#endif // RIO_PLATFORM_LINUX
+
+} // namespace Rio
+
+#endif // RIO_PLATFORM_POSIX
@@ -0,0 +1,94 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/FileSystem/MappedFile.h"
+
+#if RIO_PLATFORM_POSIX
+
+#include "Core/Debug/Error.h"
+
+#include <errno.h>
+#include <fcntl.h> // open
+#include <sys/mman.h> // mmap, munmap, posix_madvise
+#include <sys/stat.h> // fstat
+#include <unistd.h> // close, sysconf
+
+namespace Rio
+{
+	void MappedFile::map(const char* path)
+	{
+		const int file = ::open(path, O_RDONLY);
+		RIO_ASSERT(file != -1, "open: errno = %d", errno);
+		if (file == -1)
+		{
+			return;
+		}
+
+		struct stat info;
+		int err = fstat(file, &info);
+		RIO_ASSERT(err == 0, "fstat: errno = %d", errno);
+
+		if (err == 0 && info.st_size == 0)
+		{
+			// Zero-length mappings are not allowed
+			data = "";
+		}
+		else if (err == 0)
+		{
+			void* mapping = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+			RIO_ASSERT(mapping != MAP_FAILED, "mmap: errno = %d", errno);
+			// Left invalid and empty when it fails
+			if (mapping != MAP_FAILED)
+			{
+				data = (const char*)mapping;
+				size = (size_t)info.st_size;
+			}
+		}
+
+		// The mapping keeps its own reference to the file
+		::close(file);
+	}
+
+	void MappedFile::unmap()
+	{
+		if (size > 0)
+		{
+			int err = munmap((void*)data, size);
+			RIO_ASSERT(err == 0, "munmap: errno = %d", errno);
+			RIO_UNUSED(err);
+		}
+	}
+
+	void MappedFile::advise(FileAccessPattern::Enum pattern, size_t offset, size_t length)
+	{
+		RIO_ASSERT(offset <= size, "Offset out of bounds");
+		if (size == 0)
+		{
+			return;
+		}
+
+		int advice = POSIX_MADV_NORMAL;
+		switch (pattern)
+		{
+			case FileAccessPattern::NORMAL: advice = POSIX_MADV_NORMAL; break;
+			case FileAccessPattern::SEQUENTIAL: advice = POSIX_MADV_SEQUENTIAL; break;
+			case FileAccessPattern::RANDOM: advice = POSIX_MADV_RANDOM; break;
+			case FileAccessPattern::WILL_NEED: advice = POSIX_MADV_WILLNEED; break;
+			case FileAccessPattern::DONT_NEED: advice = POSIX_MADV_DONTNEED; break;
+			default: RIO_FATAL("Unknown access pattern"); break;
+		}
+
+		// The range must start at a page boundary
+		const size_t pageOffset = offset % getPageSize();
+		const size_t end = (length == 0 || offset + length > size) ? size : offset + length;
+		// Returns the error instead of setting errno, a failed hint is not an error
+		posix_madvise((void*)(data + offset - pageOffset), end - offset + pageOffset, advice);
+	}
+
+	size_t MappedFile::getPageSize()
+	{
+		static const size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+		return pageSize;
+	}
+
+} // namespace Rio
+
+#endif // RIO_PLATFORM_POSIX
@@ -0,0 +1,215 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/FileSystem/OsFile.h"
+
+#if RIO_PLATFORM_POSIX
+
+#include <fcntl.h> // open, posix_fadvise
+#include <sys/stat.h> // fstat
+#include <unistd.h> // pread, pwrite, close, fsync
+
+namespace Rio
+{
+	namespace
+	{
+		bool isDirectAligned(const void* data, size_t size, size_t offset)
+		{
+			return offset % OsFile::DIRECT_ALIGNMENT == 0
+				&& size % OsFile::DIRECT_ALIGNMENT == 0
+				&& (uintptr_t)data % OsFile::DIRECT_ALIGNMENT == 0;
+		}
+	} // namespace (anonymous)
+
+	void OsFile::open(const char* path, FileOpenMode mode, uint32_t flags)
+	{
+		const int openFlags = (mode == FileOpenMode::Read)
+			? O_RDONLY
+			: O_WRONLY | O_CREAT | O_TRUNC;
+
+		close();
+		isDirect = false;
+		isEndOfFile = false;
+		position = 0;
+
+#if defined(O_DIRECT)
+		if ((flags & OsFileFlags::DIRECT) != 0)
+		{
+			file = ::open(path, openFlags | O_DIRECT, 0644);
+			// tmpfs and some other file systems refuse O_DIRECT with EINVAL
+			isDirect = file != -1;
+		}
+		if (file == -1)
+		{
+			file = ::open(path, openFlags, 0644);
+		}
+#else
+		file = ::open(path, openFlags, 0644);
+#endif // defined(O_DIRECT)
+		RIO_ASSERT(file != -1, "open: errno = %d", errno);
+
+#if RIO_PLATFORM_OSX || RIO_PLATFORM_IOS
+		// No O_DIRECT, turn off the page cache for this file instead
+		if (file != -1 && (flags & OsFileFlags::DIRECT) != 0)
+		{
+			isDirect = fcntl(file, F_NOCACHE, 1) != -1;
+		}
+#endif // RIO_PLATFORM_OSX || RIO_PLATFORM_IOS
+		RIO_UNUSED(flags);
+	}
+
+	void OsFile::close()
+	{
+		if (isFileOpen())
+		{
+			::close(file);
+			file = -1;
+		}
+	}
+
+	bool OsFile::isFileOpen() const
+	{
+		return file != -1;
+	}
+
+	size_t OsFile::getFileSize() const
+	{
+		struct stat info;
+		int err = fstat(file, &info);
+		RIO_ASSERT(err == 0, "fstat: errno = %d", errno);
+		RIO_UNUSED(err);
+		return (size_t)info.st_size;
+	}
+
+	size_t OsFile::read(void* data, size_t size)
+	{
+		const size_t bytesRead = readAt(data, size, position);
+		position += bytesRead;
+		if (bytesRead < size)
+		{
+			isEndOfFile = true;
+		}
+		return bytesRead;
+	}
+
+	size_t OsFile::write(const void* data, size_t size)
+	{
+		const size_t bytesWritten = writeAt(data, size, position);
+		position += bytesWritten;
+		return bytesWritten;
+	}
+
+	void OsFile::flush()
+	{
+		int err = fsync(file);
+		RIO_ASSERT(err == 0, "fsync: errno = %d", errno);
+		RIO_UNUSED(err);
+	}
+
+	void OsFile::seek(size_t position)
+	{
+		this->position = position;
+		isEndOfFile = false;
+	}
+
+	void OsFile::seekToEnd()
+	{
+		position = getFileSize();
+	}
+
+	void OsFile::skip(size_t bytes)
+	{
+		position += bytes;
+	}
+
+	size_t OsFile::getFilePosition() const
+	{
+		return position;
+	}
+
+	bool OsFile::getIsEndOfFile() const
+	{
+		return isEndOfFile;
+	}
+
+	bool OsFile::getIsDirect() const
+	{
+		return isDirect;
+	}
+
+	size_t OsFile::readAt(void* data, size_t size, size_t offset) const
+	{
+		RIO_ASSERT(data != NULL, "Data must be != NULL");
+		RIO_ASSERT(!isDirect || isDirectAligned(data, size, offset), "Unaligned direct read");
+
+		// pread() may return less than asked before the end of the file
+		size_t bytesRead = 0;
+		while (bytesRead < size)
+		{
+			const ssize_t result = pread(file, (char*)data + bytesRead, size - bytesRead, off_t(offset + bytesRead));
+			if (result == -1 && errno == EINTR)
+			{
+				continue;
+			}
+			RIO_ASSERT(result != -1, "pread: errno = %d", errno);
+			if (result <= 0)
+			{
+				break;
+			}
+			bytesRead += size_t(result);
+			// In direct mode a short read is the last block of the file,
+			// reading again would start at an unaligned offset
+			if (isDirect && bytesRead % DIRECT_ALIGNMENT != 0)
+			{
+				break;
+			}
+		}
+		return bytesRead;
+	}
+
+	size_t OsFile::writeAt(const void* data, size_t size, size_t offset)
+	{
+		RIO_ASSERT(data != NULL, "Data must be != NULL");
+
+		size_t bytesWritten = 0;
+		while (bytesWritten < size)
+		{
+			const ssize_t result = pwrite(file, (const char*)data + bytesWritten, size - bytesWritten, off_t(offset + bytesWritten));
+			if (result == -1 && errno == EINTR)
+			{
+				continue;
+			}
+			RIO_ASSERT(result != -1, "pwrite: errno = %d", errno);
+			if (result <= 0)
+			{
+				break;
+			}
+			bytesWritten += size_t(result);
+		}
+		RIO_ASSERT(size == bytesWritten, "pwrite: errno = %d", errno);
+		return bytesWritten;
+	}
+
+	void OsFile::advise(FileAccessPattern::Enum pattern, size_t offset, size_t length)
+	{
+#if RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID
+		int advice = POSIX_FADV_NORMAL;
+		switch (pattern)
+		{
+			case FileAccessPattern::NORMAL: advice = POSIX_FADV_NORMAL; break;
+			case FileAccessPattern::SEQUENTIAL: advice = POSIX_FADV_SEQUENTIAL; break;
+			case FileAccessPattern::RANDOM: advice = POSIX_FADV_RANDOM; break;
+			case FileAccessPattern::WILL_NEED: advice = POSIX_FADV_WILLNEED; break;
+			case FileAccessPattern::DONT_NEED: advice = POSIX_FADV_DONTNEED; break;
+			default: RIO_FATAL("Unknown access pattern"); break;
+		}
+		// Returns the error instead of setting errno, a failed hint is not an error
+		posix_fadvise(file, off_t(offset), off_t(length), advice);
+#else
+		RIO_UNUSED(pattern);
+		RIO_UNUSED(offset);
+		RIO_UNUSED(length);
+#endif // RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID
+	}
+
+} // namespace Rio
+
+#endif // RIO_PLATFORM_POSIX
@@ -0,0 +1,106 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/FileSystem/DirectoryScanner.h"
+
+#if RIO_PLATFORM_WINDOWS
+
+#include "Core/Debug/Error.h"
+#include "Core/Os/Windows/Headers_Windows.h"
+
+#include <string.h> // strlen, strcpy
+
+namespace Rio
+{
+	namespace
+	{
+		// FILETIME counts 100 ns intervals since 1601-01-01 UTC
+		uint64_t getModifiedTime(const FILETIME& time)
+		{
+			const uint64_t intervals = (uint64_t(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+			return (intervals - 116444736000000000ull) * 100;
+		}
+
+		bool isDotOrDotDot(const char* name)
+		{
+			return name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'));
+		}
+	} // namespace (anonymous)
+
+	bool DirectoryScanner::openRoot(const char* osPath, uint64_t& lastModifiedTime)
+	{
+		if (strlen(osPath) + 1 > sizeof(rootPath))
+		{
+			return false;
+		}
+
+		WIN32_FILE_ATTRIBUTE_DATA data;
+		if (!GetFileAttributesEx(osPath, GetFileExInfoStandard, &data) || (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0)
+		{
+			return false;
+		}
+		strcpy(rootPath, osPath);
+		lastModifiedTime = getModifiedTime(data.ftLastWriteTime);
+		return true;
+	}
+
+	void DirectoryScanner::closeRoot()
+	{
+	}
+
+	bool DirectoryScanner::getIsFile(const char* osPath)
+	{
+		const DWORD attributes = GetFileAttributes(osPath);
+		return attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY) == 0;
+	}
+
+	void DirectoryScanner::listDirectory(Worker& worker, const PendingDirectory& directory, const Listing* cachedListing)
+	{
+		// The listing already has the size and time of every entry, reading the cache saves nothing
+		RIO_UNUSED(cachedListing);
+
+		char pattern[MAX_PATH * 2];
+		const int length = _snprintf(pattern, sizeof(pattern), "%s\\%s%s*"
+			, rootPath
+			, directory.path
+			, directory.pathLength > 0 ? "\\" : "");
+		if (length < 0 || length >= int(sizeof(pattern)))
+		{
+			return;
+		}
+
+		WIN32_FIND_DATA data;
+		// No short names and larger reads from the file system
+		HANDLE find = FindFirstFileEx(pattern, FindExInfoBasic, &data, FindExSearchNameMatch, NULL, FIND_FIRST_EX_LARGE_FETCH);
+		if (find == INVALID_HANDLE_VALUE)
+		{
+			return;
+		}
+
+		do
+		{
+			if (isDotOrDotDot(data.cFileName))
+			{
+				continue;
+			}
+
+			DirectoryEntryType::Enum type = DirectoryEntryType::FILE;
+			if ((data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0)
+			{
+				// Not followed, like symbolic links on POSIX
+				type = DirectoryEntryType::OTHER;
+			}
+			else if ((data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0)
+			{
+				type = DirectoryEntryType::DIRECTORY;
+			}
+
+			const uint64_t size = (uint64_t(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+			addEntry(worker, directory, data.cFileName, strlen(data.cFileName), type, size, getModifiedTime(data.ftLastWriteTime));
+		}
+		while (FindNextFile(find, &data) != 0);
+
+		FindClose(find);
+	}
+
+} // namespace Rio
+
+#endif // RIO_PLATFORM_WINDOWS
@@ -0,0 +1,280 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/FileSystem/FileWatcher.h"
+
+#if RIO_PLATFORM_WINDOWS
+
+#include "Core/Debug/Error.h"
+#include "Core/Os/Windows/Headers_Windows.h"
+#include "Core/Thread/Thread.h"
+
+#include <cstdio> // _snprintf
+#include <cstring> // strlen
+
+namespace Rio
+{
+	namespace
+	{
+		const DWORD NOTIFY_FILTER = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE;
+		const uint32_t MAX_PATH_LENGTH = FileWatchEvent::MAX_PATH_LENGTH;
+	} // namespace (anonymous)
+
+	struct FileWatcher::Backend
+	{
+		FileWatcher* watcher;
+		HANDLE directory;
+		HANDLE ioEvent;
+		HANDLE stopEvent;
+		OVERLAPPED overlapped;
+		char rootPath[MAX_PATH_LENGTH];
+		// FILE_NOTIFY_INFORMATION must be DWORD aligned
+		DWORD buffer[16 * 1024];
+		Thread thread;
+
+		Backend(FileWatcher& watcher)
+			: watcher(&watcher)
+			, directory(INVALID_HANDLE_VALUE)
+			, ioEvent(NULL)
+			, stopEvent(NULL)
+		{
+		}
+
+		~Backend()
+		{
+			if (stopEvent != NULL)
+			{
+				CloseHandle(stopEvent);
+			}
+			if (ioEvent != NULL)
+			{
+				CloseHandle(ioEvent);
+			}
+			if (directory != INVALID_HANDLE_VALUE)
+			{
+				CloseHandle(directory);
+			}
+		}
+
+		bool readChanges()
+		{
+			memset(&overlapped, 0, sizeof(overlapped));
+			overlapped.hEvent = ioEvent;
+			return ReadDirectoryChangesW(directory, buffer, sizeof(buffer), TRUE, NOTIFY_FILTER, NULL, &overlapped, NULL) != 0;
+		}
+
+		bool getIsDirectory(const char* path) const
+		{
+			char osPath[2 * MAX_PATH_LENGTH + 1];
+			_snprintf(osPath, sizeof(osPath), "%s\\%s", rootPath, path);
+			osPath[sizeof(osPath) - 1] = '\0';
+			const DWORD attributes = GetFileAttributesA(osPath);
+			return attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+		}
+
+		// Reports the files of a directory added while watching
+		void addFiles(const char* path, int64_t now)
+		{
+			char pattern[2 * MAX_PATH_LENGTH + 3];
+			_snprintf(pattern, sizeof(pattern), "%s\\%s\\*", rootPath, path);
+			pattern[sizeof(pattern) - 1] = '\0';
+
+			WIN32_FIND_DATAA data;
+			HANDLE find = FindFirstFileA(pattern, &data);
+			if (find == INVALID_HANDLE_VALUE)
+			{
+				return;
+			}
+			do
+			{
+				if (strcmp(data.cFileName, ".") == 0 || strcmp(data.cFileName, "..") == 0)
+				{
+					continue;
+				}
+
+				char childPath[MAX_PATH_LENGTH];
+				const int length = _snprintf(childPath, sizeof(childPath), "%s/%s", path, data.cFileName);
+				if (length < 0 || length >= int(sizeof(childPath)))
+				{
+					watcher->addEventsLost();
+					continue;
+				}
+
+				if ((data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0)
+				{
+					addFiles(childPath, now);
+				}
+				else
+				{
+					watcher->addChange(childPath, size_t(length), FileWatchAction::ADDED, now);
+				}
+			}
+			while (FindNextFileA(find, &data) != 0);
+			FindClose(find);
+		}
+
+		void handleChanges(DWORD size, int64_t now)
+		{
+			if (size == 0)
+			{
+				// The buffer overflowed
+				watcher->addEventsLost();
+				return;
+			}
+
+			const char* p = (const char*)buffer;
+			while (true)
+			{
+				const FILE_NOTIFY_INFORMATION& info = *(const FILE_NOTIFY_INFORMATION*)p;
+
+				char path[MAX_PATH_LENGTH];
+				const int length = WideCharToMultiByte(CP_UTF8, 0, info.FileName, int(info.FileNameLength / sizeof(WCHAR)), path, sizeof(path) - 1, NULL, NULL);
+				if (length <= 0)
+				{
+					watcher->addEventsLost();
+				}
+				else
+				{
+					path[length] = '\0';
+					for (int i = 0; i < length; ++i)
+					{
+						path[i] = path[i] == '\\' ? '/' : path[i];
+					}
+					handleChange(info.Action, path, size_t(length), now);
+				}
+
+				if (info.NextEntryOffset == 0)
+				{
+					break;
+				}
+				p += info.NextEntryOffset;
+			}
+		}
+
+		void handleChange(DWORD action, const char* path, size_t length, int64_t now)
+		{
+			switch (action)
+			{
+				case FILE_ACTION_ADDED:
+				case FILE_ACTION_RENAMED_NEW_NAME:
+				{
+					if (getIsDirectory(path))
+					{
+						addFiles(path, now);
+					}
+					else
+					{
+						watcher->addChange(path, length, FileWatchAction::ADDED, now);
+					}
+					break;
+				}
+				case FILE_ACTION_MODIFIED:
+				{
+					// Directories are modified when their files change
+					if (!getIsDirectory(path))
+					{
+						watcher->addChange(path, length, FileWatchAction::MODIFIED, now);
+					}
+					break;
+				}
+				case FILE_ACTION_REMOVED:
+				case FILE_ACTION_RENAMED_OLD_NAME:
+				{
+					watcher->addChange(path, length, FileWatchAction::REMOVED, now);
+					break;
+				}
+				default:
+				{
+					break;
+				}
+			}
+		}
+	};
+
+	void FileWatcher::createBackend(const char* osPath)
+	{
+		if (strlen(osPath) >= MAX_PATH_LENGTH)
+		{
+			return;
+		}
+
+		Backend* watcherBackend = allocator->makeNew<Backend>(*this);
+		strcpy(watcherBackend->rootPath, osPath);
+		watcherBackend->directory = CreateFileA(osPath
+			, FILE_LIST_DIRECTORY
+			, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE
+			, NULL
+			, OPEN_EXISTING
+			, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED
+			, NULL
+			);
+		watcherBackend->ioEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+		watcherBackend->stopEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+		if (watcherBackend->directory == INVALID_HANDLE_VALUE
+			|| watcherBackend->ioEvent == NULL
+			|| watcherBackend->stopEvent == NULL
+			|| !watcherBackend->readChanges())
+		{
+			allocator->makeDelete(watcherBackend);
+			return;
+		}
+
+		backend = watcherBackend;
+		backend->thread.start(watcherMain, this);
+	}
+
+	void FileWatcher::destroyBackend()
+	{
+		SetEvent(backend->stopEvent);
+		backend->thread.stop();
+		allocator->makeDelete(backend);
+		backend = nullptr;
+	}
+
+	int32_t FileWatcher::watcherMain(void* data)
+	{
+		FileWatcher* watcher = (FileWatcher*)data;
+		Backend& backend = *watcher->backend;
+
+		int32_t timeout = -1;
+		while (true)
+		{
+			HANDLE handles[] = { backend.stopEvent, backend.ioEvent };
+			const DWORD result = WaitForMultipleObjects(2, handles, FALSE, timeout < 0 ? INFINITE : DWORD(timeout));
+			if (result == WAIT_OBJECT_0)
+			{
+				// The buffer must stay valid until the read is canceled.
+				// CancelIo() would only cancel the reads of this thread, the first one is issued by the constructor
+				DWORD size;
+				CancelIoEx(backend.directory, &backend.overlapped);
+				GetOverlappedResult(backend.directory, &backend.overlapped, &size, TRUE);
+				return 0;
+			}
+
+			const int64_t now = int64_t(GetTickCount64());
+			if (result == WAIT_OBJECT_0 + 1)
+			{
+				DWORD size = 0;
+				if (GetOverlappedResult(backend.directory, &backend.overlapped, &size, FALSE))
+				{
+					backend.handleChanges(size, now);
+				}
+				else
+				{
+					watcher->addEventsLost();
+				}
+				ResetEvent(backend.ioEvent);
+				if (!backend.readChanges())
+				{
+					// The directory was removed
+					watcher->addEventsLost();
+					watcher->publishChanges(now);
+					return 0;
+				}
+			}
+
+			timeout = watcher->publishChanges(now);
+		}
+	}
+
+} // namespace Rio
+
+#endif // RIO_PLATFORM_WINDOWS
@@ -0,0 +1,85 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/FileSystem/MappedFile.h"
+
+#if RIO_PLATFORM_WINDOWS
+
+#include "Core/Debug/Error.h"
+#include "Core/Os/Windows/Headers_Windows.h"
+
+namespace Rio
+{
+	void MappedFile::map(const char* path)
+	{
+		HANDLE file = CreateFile(path,
+			GENERIC_READ,
+			FILE_SHARE_READ,
+			NULL,
+			OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL,
+			NULL);
+		RIO_ASSERT(file != INVALID_HANDLE_VALUE, "CreateFile: GetLastError = %d", GetLastError());
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			return;
+		}
+
+		LARGE_INTEGER fileSize;
+		BOOL result = GetFileSizeEx(file, &fileSize);
+		RIO_ASSERT(result == TRUE, "GetFileSizeEx: GetLastError = %d", GetLastError());
+
+		if (result == TRUE && fileSize.QuadPart == 0)
+		{
+			// Zero-length mappings are not allowed
+			data = "";
+		}
+		else if (result == TRUE)
+		{
+			HANDLE mapping = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+			RIO_ASSERT(mapping != NULL, "CreateFileMapping: GetLastError = %d", GetLastError());
+			const void* view = mapping != NULL ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+			RIO_ASSERT(view != NULL, "MapViewOfFile: GetLastError = %d", GetLastError());
+			// Left invalid and empty when it fails
+			if (view != NULL)
+			{
+				data = (const char*)view;
+				size = (size_t)fileSize.QuadPart;
+			}
+			if (mapping != NULL)
+			{
+				// The view keeps its own reference to the mapping
+				CloseHandle(mapping);
+			}
+		}
+
+		CloseHandle(file);
+	}
+
+	void MappedFile::unmap()
+	{
+		if (size > 0)
+		{
+			BOOL result = UnmapViewOfFile(data);
+			RIO_ASSERT(result == TRUE, "UnmapViewOfFile: GetLastError = %d", GetLastError());
+			RIO_UNUSED(result);
+		}
+	}
+
+	void MappedFile::advise(FileAccessPattern::Enum pattern, size_t offset, size_t length)
+	{
+		// Windows takes no access hints for views
+		RIO_ASSERT(offset <= size, "Offset out of bounds");
+		RIO_UNUSED(pattern);
+		RIO_UNUSED(offset);
+		RIO_UNUSED(length);
+	}
+
+	size_t MappedFile::getPageSize()
+	{
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+		return (size_t)info.dwPageSize;
+	}
+
+} // namespace Rio
+
+#endif // RIO_PLATFORM_WINDOWS
@@ -5,14 +5,17 @@
 
 namespace Rio
 {
-	void OsFile::open(const char* path, FileOpenMode mode)
+	void OsFile::open(const char* path, FileOpenMode mode, uint32_t flags)
 	{
+		isDirect = (flags & OsFileFlags::DIRECT) != 0;
+		isEndOfFile = false;
 		file = CreateFile(path,
 			(mode == FileOpenMode::Read) ? GENERIC_READ : GENERIC_WRITE,
-			0,
+			// Allow concurrent readers of the same file
+			(mode == FileOpenMode::Read) ? FILE_SHARE_READ : 0,
 			NULL,
 			OPEN_ALWAYS,
-			FILE_ATTRIBUTE_NORMAL,
+			FILE_ATTRIBUTE_NORMAL | (isDirect ? FILE_FLAG_NO_BUFFERING : 0),
 			NULL);
 		RIO_ASSERT(file != INVALID_HANDLE_VALUE, "CreateFile: GetLastError = %d", GetLastError());
 	}
@@ -99,6 +102,48 @@ namespace Rio
 		return GetFileSize(file, NULL);
 	}
 
+	bool OsFile::getIsDirect() const
+	{
+		return isDirect;
+	}
+
+	size_t OsFile::readAt(void* data, size_t size, size_t offset) const
+	{
+		RIO_ASSERT(data != NULL, "Data must be != NULL");
+		RIO_ASSERT(!isDirect || (offset % DIRECT_ALIGNMENT == 0 && size % DIRECT_ALIGNMENT == 0 && (uintptr_t)data % DIRECT_ALIGNMENT == 0), "Unaligned direct read");
+
+		// The offset comes from the OVERLAPPED, the handle is synchronous so ReadFile() still moves the file pointer
+		OVERLAPPED overlapped = {};
+		overlapped.Offset = DWORD(uint64_t(offset) & 0xffffffff);
+		overlapped.OffsetHigh = DWORD(uint64_t(offset) >> 32);
+		DWORD bytesRead = 0;
+		BOOL result = ReadFile(file, data, DWORD(size), &bytesRead, &overlapped);
+		RIO_ASSERT(result == TRUE || GetLastError() == ERROR_HANDLE_EOF, "ReadFile: GetLastError = %d", GetLastError());
+		RIO_UNUSED(result);
+		return bytesRead;
+	}
+
+	size_t OsFile::writeAt(const void* data, size_t size, size_t offset)
+	{
+		RIO_ASSERT(data != NULL, "Data must be != NULL");
+
+		OVERLAPPED overlapped = {};
+		overlapped.Offset = DWORD(uint64_t(offset) & 0xffffffff);
+		overlapped.OffsetHigh = DWORD(uint64_t(offset) >> 32);
+		DWORD bytesWritten = 0;
+		WriteFile(file, data, DWORD(size), &bytesWritten, &overlapped);
+		RIO_ASSERT(size == bytesWritten, "WriteFile: GetLastError = %d", GetLastError());
+		return bytesWritten;
+	}
+
+	void OsFile::advise(FileAccessPattern::Enum pattern, size_t offset, size_t length)
+	{
+		// Windows only takes access hints when the file is opened
+		RIO_UNUSED(pattern);
+		RIO_UNUSED(offset);
+		RIO_UNUSED(length);
+	}
+
 } // namespace Rio
 
 #endif // RIO_PLATFORM_WINDOWS
\ No newline at end of file
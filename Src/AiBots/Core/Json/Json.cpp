@@ -1,6 +1,7 @@
 // Copyright (c) 2015 Volodymyr Syvochka
 #include "Core/Json/Json.h"
 #include "Core/Strings/StringUtils.h"
+#include "Core/Strings/NumberParser.h"
 #include "Core/Memory/TempAllocator.h"
 #include "Core/Containers/Map.h"
 
@@ -119,49 +120,11 @@ namespace Rio
 		{
 			RIO_ASSERT_NOT_NULL(json);
 
-			TempAllocator512 alloc;
-			Array<char> number(alloc);
-
-			if (*json == '-')
-			{
-				ArrayFn::pushBack(number, '-');
-				json = getNext(json, '-');
-			}
-			while (isdigit(*json))
-			{
-				ArrayFn::pushBack(number, *json);
-				json = getNext(json);
-			}
-
-			if (*json == '.')
-			{
-				ArrayFn::pushBack(number, '.');
-				while ((*(json = getNext(json))) && isdigit(*json))
-				{
-					ArrayFn::pushBack(number, *json);
-				}
-			}
-
-			if (*json == 'e' || *json == 'E')
-			{
-				ArrayFn::pushBack(number, *json);
-				json = getNext(json);
-
-				if (*json == '-' || *json == '+')
-				{
-					ArrayFn::pushBack(number, *json);
-					json = getNext(json);
-				}
-				while (isdigit(*json))
-				{
-					ArrayFn::pushBack(number, *json);
-					json = getNext(json);
-				}
-			}
-
-			// Ensure null terminated
-			ArrayFn::pushBack(number, '\0');
-			return parseDouble(ArrayFn::begin(number));
+			double value = 0.0;
+			const char* end = NumberParserFn::parseDouble(json, value);
+			RIO_ASSERT(end != nullptr, "Bad number");
+			RIO_UNUSED(end);
+			return value;
 		}
 
 		bool parseBool(const char* json)
@@ -197,12 +160,24 @@ namespace Rio
 
 		int32_t parseInt(const char* json)
 		{
-			return (int32_t)parseDouble(json);
+			RIO_ASSERT_NOT_NULL(json);
+
+			int32_t value = 0;
+			const char* end = NumberParserFn::parseInt(json, value);
+			RIO_ASSERT(end != nullptr, "Bad number");
+			RIO_UNUSED(end);
+			return value;
 		}
 
 		float parseFloat(const char* json)
 		{
-			return (float)parseDouble(json);
+			RIO_ASSERT_NOT_NULL(json);
+
+			float value = 0.0f;
+			const char* end = NumberParserFn::parseFloat(json, value);
+			RIO_ASSERT(end != nullptr, "Bad number");
+			RIO_UNUSED(end);
+			return value;
 		}
 
 		void parseArray(const char* json, JsonArray& array)
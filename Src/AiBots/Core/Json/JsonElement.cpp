@@ -62,23 +62,38 @@ namespace Rio
 
 	JsonElement JsonElement::getValueByKey(const char* k)
 	{
-		Map<DynamicString, const char*> object(getDefaultAllocator());
-		Rjson::parseObject(jsonCurrentPos, object);
+		const char* value = Rjson::findValue(jsonCurrentPos, StringId32(k));
+		RIO_ASSERT(value != nullptr, "Key not found: '%s'", k);
+
+		return JsonElement(value);
+	}
+
+	JsonElement JsonElement::getValueByKey(StringId32 k)
+	{
+		const char* value = Rjson::findValue(jsonCurrentPos, k);
+		RIO_ASSERT(value != nullptr, "Key not found: '%.8x'", k.getId());
+
+		return JsonElement(value);
+	}
 
-		const char* value = MapFn::get(object, DynamicString(k), (const char*)NULL);
-		RIO_ASSERT(value != NULL, "Key not found: '%s'", k);
+	JsonElement JsonElement::getValueByKey(StringView k)
+	{
+		const char* value = Rjson::findValue(jsonCurrentPos, StringId32(k));
+		RIO_ASSERT(value != nullptr, "Key not found: '%.*s'", int(k.getLength()), k.getData());
 
 		return JsonElement(value);
 	}
 
 	JsonElement JsonElement::tryGetValueByKey(const char* k)
+	{
+		return tryGetValueByKey(StringId32(k));
+	}
+
+	JsonElement JsonElement::tryGetValueByKey(StringId32 k)
 	{
 		if (jsonCurrentPos != nullptr)
 		{
-			Map<DynamicString, const char*> object(getDefaultAllocator());
-			Rjson::parseObject(jsonCurrentPos, object);
-
-			const char* value = MapFn::get(object, DynamicString(k), (const char*)NULL);
+			const char* value = Rjson::findValue(jsonCurrentPos, k);
 
 			if (value != nullptr)
 			{
@@ -88,11 +103,24 @@ namespace Rio
 		return JsonElement();
 	}
 
+	JsonElement JsonElement::tryGetValueByKey(StringView k)
+	{
+		return tryGetValueByKey(StringId32(k));
+	}
+
 	bool JsonElement::hasKey(const char* k) const
 	{
-		Map<DynamicString, const char*> object(getDefaultAllocator());
-		Rjson::parseObject(jsonCurrentPos, object);
-		return MapFn::has(object, DynamicString(k));
+		return hasKey(StringId32(k));
+	}
+
+	bool JsonElement::hasKey(StringId32 k) const
+	{
+		return Rjson::findValue(jsonCurrentPos, k) != nullptr;
+	}
+
+	bool JsonElement::hasKey(StringView k) const
+	{
+		return hasKey(StringId32(k));
 	}
 
 	bool JsonElement::toBool(bool def) const
@@ -129,73 +157,27 @@ namespace Rio
 
 	Vector2 JsonElement::toVector2(const Vector2& def) const
 	{
-		if (isNil())
-			return def;
-
-		TempAllocator64 alloc;
-		Array<const char*> array(alloc);
-		Rjson::parseArray(jsonCurrentPos, array);
-
-		return Vector2(Rjson::parseFloat(array[0]), Rjson::parseFloat(array[1]));
+		return isNil() ? def : Rjson::parseVector2(jsonCurrentPos);
 	}
 
 	Vector3 JsonElement::toVector3(const Vector3& def) const
 	{
-		if (isNil())
-			return def;
-
-		TempAllocator64 alloc;
-		Array<const char*> array(alloc);
-		Rjson::parseArray(jsonCurrentPos, array);
-
-		return Vector3(Rjson::parseFloat(array[0]),
-			Rjson::parseFloat(array[1]),
-			Rjson::parseFloat(array[2]));
+		return isNil() ? def : Rjson::parseVector3(jsonCurrentPos);
 	}
 
 	Vector4 JsonElement::toVector4(const Vector4& def) const
 	{
-		if (isNil())
-			return def;
-
-		TempAllocator64 alloc;
-		Array<const char*> array(alloc);
-		Rjson::parseArray(jsonCurrentPos, array);
-
-		return Vector4(Rjson::parseFloat(array[0]),
-			Rjson::parseFloat(array[1]),
-			Rjson::parseFloat(array[2]),
-			Rjson::parseFloat(array[3]));
+		return isNil() ? def : Rjson::parseVector4(jsonCurrentPos);
 	}
 
 	Quaternion JsonElement::toQuaternion(const Quaternion& def) const
 	{
-		if (isNil())
-			return def;
-
-		TempAllocator64 alloc;
-		Array<const char*> array(alloc);
-		Rjson::parseArray(jsonCurrentPos, array);
-
-		const Vector3 axis = Vector3(Rjson::parseFloat(array[0])
-			, Rjson::parseFloat(array[1])
-			, Rjson::parseFloat(array[2])
-			);
-		const float angle = Rjson::parseFloat(array[3]);
-
-		return Quaternion(axis, angle);
+		return isNil() ? def : Rjson::parseQuaternion(jsonCurrentPos);
 	}
 
 	Matrix4x4 JsonElement::toMatrix4x4(const Matrix4x4& def) const
 	{
-		if (isNil())
-			return def;
-
-		TempAllocator128 alloc;
-		Array<float> array(alloc);
-		toArray(array);
-
-		return Matrix4x4(ArrayFn::begin(array));
+		return isNil() ? def : Rjson::parseMatrix4x4(jsonCurrentPos);
 	}
 
 	StringId32 JsonElement::toStringId32(const StringId32 def) const
@@ -248,32 +230,17 @@ namespace Rio
 
 	void JsonElement::toArray(Array<int32_t>& array) const
 	{
-		Array<const char*> temp(getDefaultAllocator());
-		Rjson::parseArray(jsonCurrentPos, temp);
-		for (size_t i = 0; i < ArrayFn::getCount(temp); i++)
-		{
-			ArrayFn::pushBack(array, (int32_t)Rjson::parseInt(temp[i]));
-		}
+		Rjson::parseIntArray(jsonCurrentPos, array);
 	}
 
 	void JsonElement::toArray(Array<uint32_t>& array) const
 	{
-		Array<const char*> temp(getDefaultAllocator());
-		Rjson::parseArray(jsonCurrentPos, temp);
-		for (size_t i = 0; i < ArrayFn::getCount(temp); i++)
-		{
-			ArrayFn::pushBack(array, (uint32_t)Rjson::parseInt(temp[i]));
-		}
+		Rjson::parseUintArray(jsonCurrentPos, array);
 	}
 
 	void JsonElement::toArray(Array<float>& array) const
 	{
-		Array<const char*> temp(getDefaultAllocator());
-		Rjson::parseArray(jsonCurrentPos, temp);
-		for (size_t i = 0; i < ArrayFn::getCount(temp); i++)
-		{
-			ArrayFn::pushBack(array, Rjson::parseFloat(temp[i]));
-		}
+		Rjson::parseFloatArray(jsonCurrentPos, array);
 	}
 
 	void JsonElement::toArray(Vector<DynamicString>& array) const
@@ -301,6 +268,11 @@ namespace Rio
 		}
 	}
 
+	void JsonElement::getKeyIndex(JsonObjectIndex& object) const
+	{
+		Rjson::parseObject(jsonCurrentPos, object);
+	}
+
 	bool JsonElement::isNil() const
 	{
 		if (jsonCurrentPos != NULL)
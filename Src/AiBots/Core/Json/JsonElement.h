@@ -8,8 +8,11 @@
 #include "Core/Strings/StringId32.h"
 #include "Core/Strings/StringId64.h"
 #include "Core/Strings/DynamicString.h"
+#include "Core/Strings/StringView.h"
 #include "Core/Containers/Vector.h"
 
+#include "Core/Json/JsonTypes.h"
+
 #include "Core/Math/Vector2.h"
 #include "Core/Math/Vector3.h"
 #include "Core/Math/Vector4.h"
@@ -41,10 +44,17 @@ namespace Rio
 		// Returns the element corresponding to key of the current object.
 		// If the key is not unique in the object scope, the last key in order of appearance will be selected.
 		JsonElement getValueByKey(const char* k);
+		// Same as above with the key hashed to murmur32(), avoids hashing k on every call.
+		JsonElement getValueByKey(StringId32 k);
+		JsonElement getValueByKey(StringView k);
 		// Returns the element corresponding to key of the current object, or nil if the key does not exist.
 		JsonElement tryGetValueByKey(const char* k);
+		JsonElement tryGetValueByKey(StringId32 k);
+		JsonElement tryGetValueByKey(StringView k);
 		// Returns whether the element has the key.
 		bool hasKey(const char* k) const;
+		bool hasKey(StringId32 k) const;
+		bool hasKey(StringView k) const;
 		// Returns true whether the element is the JSON nil special value.
 		bool isNil() const;
 		// Returns true whether the element is a JSON boolean (true or false).
@@ -95,6 +105,9 @@ namespace Rio
 		void toArray(Vector<DynamicString>& array) const;
 		// Returns all the keys of the element.
 		void getAllKeys(Vector<DynamicString>& keys) const;
+		// Returns the map from StringId32 of the keys to the values of the element.
+		// Use it when the same object is queried many times, every lookup becomes a single hash probe.
+		void getKeyIndex(JsonObjectIndex& object) const;
 	private:
 		const char* jsonCurrentPos;
 		friend class JsonParser;
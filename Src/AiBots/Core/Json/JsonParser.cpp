@@ -5,6 +5,9 @@
 #include "Core/Memory/TempAllocator.h"
 #include "Core/Strings/StringUtils.h"
 #include "Core/FileSystem/File.h"
+#include "Core/FileSystem/MappedFile.h"
+
+#include <cstring> // memcpy
 
 namespace Rio
 {
@@ -21,11 +24,30 @@ namespace Rio
 		, jsonDocument(NULL)
 	{
 		const size_t size = f.getFileSize();
-		char* doc = (char*)getDefaultAllocator().allocate(size);
-		f.read(doc, size);
+		char* doc = (char*)getDefaultAllocator().allocate(size + 1);
+		const size_t bytesRead = f.read(doc, size);
+		doc[bytesRead] = '\0';
 		jsonDocument = doc;
 	}
 
+	JsonParser::JsonParser(MappedFile& f)
+		: isFromFile(false)
+		, jsonDocument(f.getData())
+	{
+		RIO_ASSERT(f.isValid(), "File is not mapped");
+
+		if (!f.getIsNulTerminated())
+		{
+			// The file ends exactly at a page boundary
+			const size_t size = f.getSize();
+			char* doc = (char*)getDefaultAllocator().allocate(size + 1);
+			memcpy(doc, f.getData(), size);
+			doc[size] = '\0';
+			isFromFile = true;
+			jsonDocument = doc;
+		}
+	}
+
 	JsonParser::~JsonParser()
 	{
 		if (isFromFile)
@@ -10,6 +10,7 @@ namespace Rio
 {
 
 	class File;
+	class MappedFile;
 
 	// Parses JSON documents.
 	class JsonParser
@@ -18,7 +19,11 @@ namespace Rio
 		// Reads the JSON document contained in the C non-null string.
 		// The string has to remain valid for the whole parser's existence scope.
 		JsonParser(const char* s);
+		// Reads the whole file into memory.
 		JsonParser(File& f);
+		// Parses the mapping in place when it is NUL-terminated, copies it otherwise.
+		// The file has to remain mapped for the whole parser's existence scope.
+		JsonParser(MappedFile& f);
 		~JsonParser();
 		JsonElement getJsonRoot();
 	private:
@@ -0,0 +1,689 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/Json/JsonStreamParser.h"
+
+#include "Core/Strings/StringUtils.h"
+#include "Core/Strings/NumberParser.h"
+#include "Core/FileSystem/File.h"
+
+namespace Rio
+{
+	namespace
+	{
+		inline bool isWordCharacter(char c)
+		{
+			return isAlphaNumeric(c) || c == '_';
+		}
+
+		inline bool isNumberCharacter(char c)
+		{
+			return isDigit(c) || c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-';
+		}
+
+		inline int32_t getHexDigitValue(char c)
+		{
+			if (c >= '0' && c <= '9') return c - '0';
+			if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+			if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+			return -1;
+		}
+	} // namespace (anonymous)
+
+	JsonStreamParser::JsonStreamParser(Allocator& a, uint32_t maxTokenLength, uint32_t maxDepth)
+		: tokenBuffer(a)
+		, containerStack(a)
+		, maxTokenLength(maxTokenLength)
+		, maxDepth(maxDepth)
+	{
+	}
+
+	void JsonStreamParser::feed(const char* data, size_t size)
+	{
+		RIO_ASSERT(data != nullptr || size == 0, "Data must be != NULL");
+		RIO_ASSERT(chunkCurrent == chunkEnd, "The previous chunk has not been consumed yet");
+		RIO_ASSERT(!isInputFinished, "The input is already finished");
+
+		chunkCurrent = data;
+		chunkEnd = data + size;
+	}
+
+	void JsonStreamParser::finish()
+	{
+		isInputFinished = true;
+	}
+
+	void JsonStreamParser::reset()
+	{
+		ArrayFn::clear(tokenBuffer);
+		ArrayFn::clear(containerStack);
+		chunkCurrent = nullptr;
+		chunkEnd = nullptr;
+		errorMessage = nullptr;
+		consumedBytes = 0;
+		unicodeValue = 0;
+		unicodeDigitsCount = 0;
+		highSurrogate = 0;
+		tokenState = TokenState::NONE;
+		rootTokenState = TokenState::NONE;
+		isTokenKey = false;
+		hasImplicitRoot = false;
+		isRootComplete = false;
+		isInputFinished = false;
+	}
+
+	const char* JsonStreamParser::getError() const
+	{
+		return errorMessage;
+	}
+
+	size_t JsonStreamParser::getOffset() const
+	{
+		return consumedBytes;
+	}
+
+	JsonStreamResult::Enum JsonStreamParser::next(JsonStreamEvent& event)
+	{
+		if (errorMessage != nullptr)
+		{
+			return JsonStreamResult::ERROR;
+		}
+
+		while (chunkCurrent != chunkEnd)
+		{
+			const char c = *chunkCurrent;
+
+			switch (tokenState)
+			{
+			case TokenState::NONE:
+			{
+				if (isSpace(c) || c == ',')
+				{
+					break;
+				}
+
+				if (c == '/')
+				{
+					tokenState = TokenState::COMMENT_START;
+					break;
+				}
+
+				if (rootTokenState != TokenState::NONE)
+				{
+					// The character is not consumed, it follows the root token
+					return completeRootToken(c == ':' || c == '=', event);
+				}
+
+				if (isRootComplete)
+				{
+					return fail("Unexpected data after the root value");
+				}
+
+				if (c == ':' || c == '=')
+				{
+					if (ArrayFn::getIsEmpty(containerStack) || ArrayFn::back(containerStack) != ContainerState::OBJECT_SEPARATOR)
+					{
+						return fail("Unexpected key separator");
+					}
+					ArrayFn::back(containerStack) = ContainerState::OBJECT_VALUE;
+					break;
+				}
+
+				if (c == '}')
+				{
+					if (ArrayFn::getIsEmpty(containerStack)
+						|| ArrayFn::back(containerStack) != ContainerState::OBJECT_KEY
+						|| (hasImplicitRoot && ArrayFn::getCount(containerStack) == 1))
+					{
+						return fail("Unexpected '}'");
+					}
+					++chunkCurrent;
+					++consumedBytes;
+					return popContainer(JsonStreamEventType::OBJECT_END, event);
+				}
+
+				if (c == ']')
+				{
+					if (ArrayFn::getIsEmpty(containerStack) || ArrayFn::back(containerStack) != ContainerState::ARRAY)
+					{
+						return fail("Unexpected ']'");
+					}
+					++chunkCurrent;
+					++consumedBytes;
+					return popContainer(JsonStreamEventType::ARRAY_END, event);
+				}
+
+				isTokenKey = isKeyExpected();
+				if (!isTokenKey && !canBeginValue())
+				{
+					return fail("Expected a key separator");
+				}
+
+				if (c == '"')
+				{
+					ArrayFn::clear(tokenBuffer);
+					tokenState = TokenState::STRING;
+					break;
+				}
+
+				if (isWordCharacter(c) && (isTokenKey || !isDigit(c)))
+				{
+					ArrayFn::clear(tokenBuffer);
+					tokenState = TokenState::WORD;
+					continue;
+				}
+
+				if (isTokenKey)
+				{
+					return fail("Expected a key");
+				}
+
+				if (c == '{')
+				{
+					++chunkCurrent;
+					++consumedBytes;
+					return pushContainer(ContainerState::OBJECT_KEY, JsonStreamEventType::OBJECT_BEGIN, event);
+				}
+
+				if (c == '[')
+				{
+					++chunkCurrent;
+					++consumedBytes;
+					return pushContainer(ContainerState::ARRAY, JsonStreamEventType::ARRAY_BEGIN, event);
+				}
+
+				if (c == '-' || isDigit(c))
+				{
+					ArrayFn::clear(tokenBuffer);
+					tokenState = TokenState::NUMBER;
+					continue;
+				}
+
+				return fail("Unexpected character");
+			}
+			case TokenState::STRING:
+			{
+				if (c == '"')
+				{
+					++chunkCurrent;
+					++consumedBytes;
+					return completeToken(event);
+				}
+
+				if (c == '\\')
+				{
+					tokenState = TokenState::STRING_ESCAPE;
+					break;
+				}
+
+				if (!flushHighSurrogate() || !appendToken(c))
+				{
+					return fail("Token too long");
+				}
+				break;
+			}
+			case TokenState::STRING_ESCAPE:
+			{
+				char unescaped = 0;
+				switch (c)
+				{
+				case '"': unescaped = '"'; break;
+				case '\\': unescaped = '\\'; break;
+				case '/': unescaped = '/'; break;
+				case 'b': unescaped = '\b'; break;
+				case 'f': unescaped = '\f'; break;
+				case 'n': unescaped = '\n'; break;
+				case 'r': unescaped = '\r'; break;
+				case 't': unescaped = '\t'; break;
+				case 'u':
+				{
+					unicodeValue = 0;
+					unicodeDigitsCount = 0;
+					tokenState = TokenState::STRING_UNICODE;
+					break;
+				}
+				default:
+				{
+					return fail("Bad escape character");
+				}
+				}
+
+				if (tokenState == TokenState::STRING_ESCAPE)
+				{
+					if (!flushHighSurrogate() || !appendToken(unescaped))
+					{
+						return fail("Token too long");
+					}
+					tokenState = TokenState::STRING;
+				}
+				break;
+			}
+			case TokenState::STRING_UNICODE:
+			{
+				const int32_t digit = getHexDigitValue(c);
+				if (digit < 0)
+				{
+					return fail("Bad unicode escape");
+				}
+
+				unicodeValue = (unicodeValue << 4) | uint32_t(digit);
+				if (++unicodeDigitsCount == 4)
+				{
+					if (!appendCodePoint(unicodeValue))
+					{
+						return fail("Token too long");
+					}
+					tokenState = TokenState::STRING;
+				}
+				break;
+			}
+			case TokenState::NUMBER:
+			case TokenState::WORD:
+			{
+				const bool isTokenCharacter = tokenState == TokenState::NUMBER ? isNumberCharacter(c) : isWordCharacter(c);
+				if (!isTokenCharacter)
+				{
+					// The delimiter is not consumed, it belongs to the next token
+					return completeToken(event);
+				}
+
+				if (!appendToken(c))
+				{
+					return fail("Token too long");
+				}
+				break;
+			}
+			case TokenState::COMMENT_START:
+			{
+				if (c == '/')
+				{
+					tokenState = TokenState::LINE_COMMENT;
+				}
+				else if (c == '*')
+				{
+					tokenState = TokenState::BLOCK_COMMENT;
+				}
+				else
+				{
+					return fail("Bad comment");
+				}
+				break;
+			}
+			case TokenState::LINE_COMMENT:
+			{
+				if (c == '\n')
+				{
+					tokenState = TokenState::NONE;
+				}
+				break;
+			}
+			case TokenState::BLOCK_COMMENT:
+			{
+				if (c == '*')
+				{
+					tokenState = TokenState::BLOCK_COMMENT_STAR;
+				}
+				break;
+			}
+			case TokenState::BLOCK_COMMENT_STAR:
+			{
+				if (c == '/')
+				{
+					tokenState = TokenState::NONE;
+				}
+				else if (c != '*')
+				{
+					tokenState = TokenState::BLOCK_COMMENT;
+				}
+				break;
+			}
+			}
+
+			++chunkCurrent;
+			++consumedBytes;
+		}
+
+		if (!isInputFinished)
+		{
+			return JsonStreamResult::NEED_INPUT;
+		}
+
+		return completeInput(event);
+	}
+
+	JsonStreamResult::Enum JsonStreamParser::fail(const char* message)
+	{
+		errorMessage = message;
+		return JsonStreamResult::ERROR;
+	}
+
+	JsonStreamResult::Enum JsonStreamParser::pushContainer(ContainerState::Enum state, JsonStreamEventType::Enum type, JsonStreamEvent& event)
+	{
+		if (ArrayFn::getCount(containerStack) >= maxDepth)
+		{
+			return fail("Maximum nesting depth exceeded");
+		}
+
+		ArrayFn::pushBack(containerStack, uint8_t(state));
+		return emit(type, event);
+	}
+
+	JsonStreamResult::Enum JsonStreamParser::popContainer(JsonStreamEventType::Enum type, JsonStreamEvent& event)
+	{
+		// The end event has the same depth as the begin event
+		emit(type, event);
+		ArrayFn::popBack(containerStack);
+		completeValue();
+		return JsonStreamResult::EVENT;
+	}
+
+	JsonStreamResult::Enum JsonStreamParser::completeToken(JsonStreamEvent& event)
+	{
+		const TokenState::Enum completedState = tokenState;
+		tokenState = TokenState::NONE;
+
+		// Unpaired high surrogate at the end of the string
+		if (!flushHighSurrogate())
+		{
+			return fail("Token too long");
+		}
+
+		// tokenBuffer is never longer than maxTokenLength
+		ArrayFn::pushBack(tokenBuffer, '\0');
+
+		if (isTokenKey)
+		{
+			return emitKey(event);
+		}
+
+		if (ArrayFn::getIsEmpty(containerStack) && completedState != TokenState::NUMBER)
+		{
+			// Kept in tokenBuffer until the next character tells a key from a value
+			rootTokenState = completedState;
+			return next(event);
+		}
+
+		return emitValue(completedState, event);
+	}
+
+	JsonStreamResult::Enum JsonStreamParser::completeRootToken(bool isKey, JsonStreamEvent& event)
+	{
+		if (!isKey)
+		{
+			const TokenState::Enum completedState = rootTokenState;
+			rootTokenState = TokenState::NONE;
+			return emitValue(completedState, event);
+		}
+
+		if (!hasImplicitRoot)
+		{
+			hasImplicitRoot = true;
+			// The key is emitted on the next call
+			return pushContainer(ContainerState::OBJECT_KEY, JsonStreamEventType::OBJECT_BEGIN, event);
+		}
+
+		rootTokenState = TokenState::NONE;
+		return emitKey(event);
+	}
+
+	JsonStreamResult::Enum JsonStreamParser::emitKey(JsonStreamEvent& event)
+	{
+		event.string = ArrayFn::begin(tokenBuffer);
+		event.length = uint32_t(ArrayFn::getCount(tokenBuffer) - 1);
+		ArrayFn::back(containerStack) = ContainerState::OBJECT_SEPARATOR;
+		return emit(JsonStreamEventType::KEY, event);
+	}
+
+	JsonStreamResult::Enum JsonStreamParser::emitValue(TokenState::Enum completedState, JsonStreamEvent& event)
+	{
+		event.string = ArrayFn::begin(tokenBuffer);
+		event.length = uint32_t(ArrayFn::getCount(tokenBuffer) - 1);
+
+		if (completedState == TokenState::STRING)
+		{
+			completeValue();
+			return emit(JsonStreamEventType::STRING, event);
+		}
+
+		if (completedState == TokenState::NUMBER)
+		{
+			double number = 0.0;
+			const char* end = NumberParserFn::parseDouble(event.string, number);
+			if (end != event.string + event.length)
+			{
+				return fail("Bad number");
+			}
+
+			event.number = number;
+			completeValue();
+			return emit(JsonStreamEventType::NUMBER, event);
+		}
+
+		if (strCmp(event.string, "true") == 0 || strCmp(event.string, "false") == 0)
+		{
+			event.boolean = event.string[0] == 't';
+			completeValue();
+			return emit(JsonStreamEventType::BOOL, event);
+		}
+
+		if (strCmp(event.string, "null") == 0)
+		{
+			completeValue();
+			return emit(JsonStreamEventType::NIL, event);
+		}
+
+		return fail("Unexpected word");
+	}
+
+	JsonStreamResult::Enum JsonStreamParser::completeInput(JsonStreamEvent& event)
+	{
+		switch (tokenState)
+		{
+		case TokenState::NUMBER:
+		case TokenState::WORD:
+		{
+			return completeToken(event);
+		}
+		case TokenState::NONE:
+		case TokenState::LINE_COMMENT:
+		{
+			break;
+		}
+		default:
+		{
+			return fail("Unexpected end of input");
+		}
+		}
+		tokenState = TokenState::NONE;
+
+		if (rootTokenState != TokenState::NONE)
+		{
+			// Nothing follows, a root string or word
+			return completeRootToken(false, event);
+		}
+
+		if (hasImplicitRoot && ArrayFn::getCount(containerStack) == 1)
+		{
+			if (ArrayFn::back(containerStack) != ContainerState::OBJECT_KEY)
+			{
+				return fail("Missing value");
+			}
+			hasImplicitRoot = false;
+			return popContainer(JsonStreamEventType::OBJECT_END, event);
+		}
+
+		if (!ArrayFn::getIsEmpty(containerStack))
+		{
+			return fail("Unexpected end of input");
+		}
+
+		return JsonStreamResult::END;
+	}
+
+	JsonStreamResult::Enum JsonStreamParser::emit(JsonStreamEventType::Enum type, JsonStreamEvent& event)
+	{
+		event.type = type;
+		event.depth = uint32_t(ArrayFn::getCount(containerStack));
+		return JsonStreamResult::EVENT;
+	}
+
+	bool JsonStreamParser::appendToken(char c)
+	{
+		if (ArrayFn::getCount(tokenBuffer) >= maxTokenLength)
+		{
+			return false;
+		}
+
+		ArrayFn::pushBack(tokenBuffer, c);
+		return true;
+	}
+
+	bool JsonStreamParser::appendCodePoint(uint32_t codePoint)
+	{
+		if (codePoint >= 0xD800 && codePoint <= 0xDBFF)
+		{
+			if (!flushHighSurrogate())
+			{
+				return false;
+			}
+			highSurrogate = codePoint;
+			return true;
+		}
+
+		if (codePoint >= 0xDC00 && codePoint <= 0xDFFF)
+		{
+			if (highSurrogate == 0)
+			{
+				codePoint = 0xFFFD;
+			}
+			else
+			{
+				codePoint = 0x10000 + ((highSurrogate - 0xD800) << 10) + (codePoint - 0xDC00);
+				highSurrogate = 0;
+			}
+		}
+		else if (!flushHighSurrogate())
+		{
+			return false;
+		}
+
+		// UTF-8 encoding
+		if (codePoint < 0x80)
+		{
+			return appendToken(char(codePoint));
+		}
+		if (codePoint < 0x800)
+		{
+			return appendToken(char(0xC0 | (codePoint >> 6)))
+				&& appendToken(char(0x80 | (codePoint & 0x3F)));
+		}
+		if (codePoint < 0x10000)
+		{
+			return appendToken(char(0xE0 | (codePoint >> 12)))
+				&& appendToken(char(0x80 | ((codePoint >> 6) & 0x3F)))
+				&& appendToken(char(0x80 | (codePoint & 0x3F)));
+		}
+		return appendToken(char(0xF0 | (codePoint >> 18)))
+			&& appendToken(char(0x80 | ((codePoint >> 12) & 0x3F)))
+			&& appendToken(char(0x80 | ((codePoint >> 6) & 0x3F)))
+			&& appendToken(char(0x80 | (codePoint & 0x3F)));
+	}
+
+	bool JsonStreamParser::flushHighSurrogate()
+	{
+		if (highSurrogate == 0)
+		{
+			return true;
+		}
+		highSurrogate = 0;
+		return appendCodePoint(0xFFFD);
+	}
+
+	bool JsonStreamParser::isKeyExpected() const
+	{
+		return !ArrayFn::getIsEmpty(containerStack) && ArrayFn::back(containerStack) == ContainerState::OBJECT_KEY;
+	}
+
+	bool JsonStreamParser::canBeginValue() const
+	{
+		return ArrayFn::getIsEmpty(containerStack)
+			|| ArrayFn::back(containerStack) == ContainerState::ARRAY
+			|| ArrayFn::back(containerStack) == ContainerState::OBJECT_VALUE;
+	}
+
+	void JsonStreamParser::completeValue()
+	{
+		if (ArrayFn::getIsEmpty(containerStack))
+		{
+			isRootComplete = true;
+		}
+		else if (ArrayFn::back(containerStack) == ContainerState::OBJECT_VALUE)
+		{
+			ArrayFn::back(containerStack) = ContainerState::OBJECT_KEY;
+		}
+	}
+
+	JsonFileStreamReader::JsonFileStreamReader(File& file, Allocator& a, size_t chunkSize)
+		: file(file)
+		, allocator(a)
+		, chunk(nullptr)
+		, chunkSize(chunkSize)
+		, parser(a)
+	{
+		RIO_ASSERT(chunkSize > 0, "Chunk size must be > 0");
+		chunk = (char*)allocator.allocate(chunkSize);
+	}
+
+	JsonFileStreamReader::~JsonFileStreamReader()
+	{
+		allocator.deallocate(chunk);
+	}
+
+	JsonStreamResult::Enum JsonFileStreamReader::next(JsonStreamEvent& event)
+	{
+		while (true)
+		{
+			const JsonStreamResult::Enum result = parser.next(event);
+			if (result != JsonStreamResult::NEED_INPUT)
+			{
+				return result;
+			}
+
+			const size_t bytesRead = file.read(chunk, chunkSize);
+			if (bytesRead == 0)
+			{
+				parser.finish();
+			}
+			else
+			{
+				parser.feed(chunk, bytesRead);
+			}
+		}
+	}
+
+	bool JsonFileStreamReader::parse(JsonStreamHandler& handler)
+	{
+		JsonStreamEvent event;
+		while (true)
+		{
+			switch (next(event))
+			{
+			case JsonStreamResult::EVENT:
+			{
+				if (!handler.onEvent(event))
+				{
+					return false;
+				}
+				break;
+			}
+			case JsonStreamResult::END:
+			{
+				return true;
+			}
+			default:
+			{
+				return false;
+			}
+			}
+		}
+	}
+
+} // namespace Rio
@@ -0,0 +1,197 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#pragma once
+
+#include "Core/Base/Config.h"
+#include "Core/Base/Types.h"
+
+#include "Core/Memory/Memory.h"
+#include "Core/Containers/Array.h"
+
+namespace Rio
+{
+	class File;
+
+	struct JsonStreamEventType
+	{
+		enum Enum
+		{
+			OBJECT_BEGIN,
+			OBJECT_END,
+			ARRAY_BEGIN,
+			ARRAY_END,
+			KEY,
+			STRING,
+			NUMBER,
+			BOOL,
+			NIL
+		};
+	};
+
+	struct JsonStreamEvent
+	{
+		JsonStreamEventType::Enum type;
+		// Nesting depth, the items of the root object or array have depth 1
+		uint32_t depth;
+		// KEY and STRING: unescaped NUL-terminated text
+		// Valid until the next call to JsonStreamParser::next()
+		const char* string;
+		uint32_t length;
+		double number;
+		bool boolean;
+	};
+
+	struct JsonStreamResult
+	{
+		enum Enum
+		{
+			// An event has been returned
+			EVENT,
+			// The current chunk is consumed, call feed() or finish()
+			NEED_INPUT,
+			// The document has been parsed completely
+			END,
+			// The document is malformed, see getError()
+			ERROR
+		};
+	};
+
+	// Incremental pull parser for JSON and RJSON documents.
+	// The input is provided in chunks of any size, tokens spanning
+	// several chunks are reassembled in an internal buffer.
+	// Memory usage is bounded by maxTokenLength and maxDepth
+	// regardless of the document size.
+	//
+	// RJSON extensions: unquoted keys, '=' as key separator, optional commas,
+	// comments and a root object without braces (recognized when the
+	// document starts with a string or a word followed by ':' or '=').
+	class JsonStreamParser
+	{
+	public:
+		JsonStreamParser(Allocator& a = getDefaultAllocator(), uint32_t maxTokenLength = 64 * 1024, uint32_t maxDepth = 256);
+		// Provides the next chunk of the document.
+		// The chunk must remain valid until next() returns NEED_INPUT.
+		void feed(const char* data, size_t size);
+		// Marks the end of the document, no more chunks will be fed.
+		void finish();
+		// Parses the next event
+		JsonStreamResult::Enum next(JsonStreamEvent& event);
+		// Restarts parsing from scratch, keeps the allocated memory
+		void reset();
+		// Returns the description of the error or nullptr
+		const char* getError() const;
+		// Returns the number of bytes consumed since the beginning of the document
+		size_t getOffset() const;
+	private:
+		struct TokenState
+		{
+			enum Enum
+			{
+				NONE,
+				STRING,
+				STRING_ESCAPE,
+				STRING_UNICODE,
+				NUMBER,
+				WORD,
+				COMMENT_START,
+				LINE_COMMENT,
+				BLOCK_COMMENT,
+				BLOCK_COMMENT_STAR
+			};
+		};
+
+		struct ContainerState
+		{
+			enum Enum
+			{
+				ARRAY,
+				// Object waiting for a key
+				OBJECT_KEY,
+				// Object waiting for ':' or '=' after a key
+				OBJECT_SEPARATOR,
+				// Object waiting for the value of a key
+				OBJECT_VALUE
+			};
+		};
+
+		JsonStreamResult::Enum fail(const char* message);
+		JsonStreamResult::Enum pushContainer(ContainerState::Enum state, JsonStreamEventType::Enum type, JsonStreamEvent& event);
+		JsonStreamResult::Enum popContainer(JsonStreamEventType::Enum type, JsonStreamEvent& event);
+		JsonStreamResult::Enum completeToken(JsonStreamEvent& event);
+		// Emits the string or word which began the document as the first key of the root object without braces
+		// or as the root value
+		JsonStreamResult::Enum completeRootToken(bool isKey, JsonStreamEvent& event);
+		JsonStreamResult::Enum emitKey(JsonStreamEvent& event);
+		JsonStreamResult::Enum emitValue(TokenState::Enum completedState, JsonStreamEvent& event);
+		JsonStreamResult::Enum completeInput(JsonStreamEvent& event);
+		JsonStreamResult::Enum emit(JsonStreamEventType::Enum type, JsonStreamEvent& event);
+		bool appendToken(char c);
+		bool appendCodePoint(uint32_t codePoint);
+		// Appends U+FFFD for a high surrogate which is not followed by a low one
+		bool flushHighSurrogate();
+		bool isKeyExpected() const;
+		bool canBeginValue() const;
+		void completeValue();
+	private:
+		Array<char> tokenBuffer;
+		Array<uint8_t> containerStack;
+		const char* chunkCurrent = nullptr;
+		const char* chunkEnd = nullptr;
+		const char* errorMessage = nullptr;
+		size_t consumedBytes = 0;
+		uint32_t maxTokenLength;
+		uint32_t maxDepth;
+		uint32_t unicodeValue = 0;
+		uint32_t unicodeDigitsCount = 0;
+		uint32_t highSurrogate = 0;
+		TokenState::Enum tokenState = TokenState::NONE;
+		// STRING or WORD while the token which began the document waits for the next character, NONE otherwise
+		TokenState::Enum rootTokenState = TokenState::NONE;
+		bool isTokenKey = false;
+		bool hasImplicitRoot = false;
+		bool isRootComplete = false;
+		bool isInputFinished = false;
+	private:
+		// Disable copying
+		JsonStreamParser(const JsonStreamParser&);
+		JsonStreamParser& operator=(const JsonStreamParser&);
+	};
+
+	// Receives the events of JsonFileStreamReader::parse()
+	class JsonStreamHandler
+	{
+	public:
+		virtual ~JsonStreamHandler()
+		{}
+		// Returns false to stop parsing
+		virtual bool onEvent(const JsonStreamEvent& event) = 0;
+	};
+
+	// Parses a JSON document read from a File in chunks of chunkSize bytes.
+	// Only one chunk is kept in memory at a time.
+	class JsonFileStreamReader
+	{
+	public:
+		JsonFileStreamReader(File& file, Allocator& a = getDefaultAllocator(), size_t chunkSize = 64 * 1024);
+		~JsonFileStreamReader();
+		// Pull interface, never returns NEED_INPUT
+		JsonStreamResult::Enum next(JsonStreamEvent& event);
+		// Push interface, delivers every event to handler.
+		// Returns true if the whole document has been parsed.
+		bool parse(JsonStreamHandler& handler);
+		const JsonStreamParser& getParser() const
+		{
+			return parser;
+		}
+	private:
+		File& file;
+		Allocator& allocator;
+		char* chunk;
+		size_t chunkSize;
+		JsonStreamParser parser;
+	private:
+		// Disable copying
+		JsonFileStreamReader(const JsonFileStreamReader&);
+		JsonFileStreamReader& operator=(const JsonFileStreamReader&);
+	};
+
+} // namespace Rio
@@ -5,6 +5,7 @@
 
 #include "Core/Containers/Array.h"
 #include "Core/Containers/Map.h"
+#include "Core/Containers/HashMap.h"
 #include "Core/Strings/FixedString.h"
 
 namespace Rio
@@ -28,4 +29,8 @@ namespace Rio
 	// Map from key to pointers to json-encoded strings.
 	using JsonObject = Map<FixedString, const char*>;
 
+	// Hash map from StringId32 of the key to pointers to json-encoded strings.
+	// Lookups are a single hash probe with a precomputed StringId32, use Hash32Fn to access it.
+	using JsonObjectIndex = HashMap<const char*>;
+
 } // namespace Rio
@@ -1,6 +1,7 @@
 // Copyright (c) 2015 Volodymyr Syvochka
 #include "Core/Json/Rjson.h"
 #include "Core/Strings/StringUtils.h"
+#include "Core/Strings/NumberParser.h"
 #include "Core/Memory/TempAllocator.h"
 #include "Core/Containers/Map.h"
 
@@ -195,53 +196,170 @@ namespace Rio
 			RIO_FATAL("Bad key");
 		}
 
-		double parseDouble(const char* json)
+		// Skips the key and returns its StringId32 and its text as in the original json string
+		static const char* parseKeyId(const char* json, StringId32& id, FixedString& key)
 		{
 			RIO_ASSERT_NOT_NULL(json);
 
-			TempAllocator512 alloc;
-			Array<char> number(alloc);
-
-			if (*json == '-')
+			if (*json == '"')
 			{
-				ArrayFn::pushBack(number, '-');
-				json = getNext(json, '-');
+				const char* keyBegin = json + 1;
+				const char* keyEnd = keyBegin;
+				bool hasEscape = false;
+
+				for (; *keyEnd != '"'; ++keyEnd)
+				{
+					RIO_ASSERT(*keyEnd != '\0', "Bad key");
+					if (*keyEnd == '\\')
+					{
+						hasEscape = true;
+						++keyEnd;
+					}
+				}
+
+				key = FixedString(keyBegin, uint32_t(keyEnd - keyBegin));
+
+				if (hasEscape)
+				{
+					TempAllocator256 ta;
+					DynamicString unescaped(ta);
+					parseString(json, unescaped);
+					id = StringId32(unescaped.toCStr(), uint32_t(unescaped.getLength()));
+				}
+				else
+				{
+					id = StringId32(key.getData(), key.getLength());
+				}
+
+				return keyEnd + 1;
 			}
-			while (isDigit(*json))
+			else if (isAlpha(*json))
 			{
-				ArrayFn::pushBack(number, *json);
-				json = getNext(json);
+				const char* keyEnd = json;
+				while (*keyEnd != '\0' && !isSpace(*keyEnd) && *keyEnd != '=')
+				{
+					++keyEnd;
+				}
+
+				key = FixedString(json, uint32_t(keyEnd - json));
+				id = StringId32(key.getData(), key.getLength());
+				return keyEnd;
 			}
 
-			if (*json == '.')
+			RIO_FATAL("Bad key");
+			return json;
+		}
+
+		// Calls visitor(id, key, value) for every key of the RJSON object
+		template <typename Visitor>
+		static void visitObject(const char* json, Visitor& visitor)
+		{
+			RIO_ASSERT_NOT_NULL(json);
+
+			if (*json == '{')
 			{
-				ArrayFn::pushBack(number, '.');
-				while ((*(json = getNext(json))) && ::isdigit(*json)) // TODO replace for internal string function
+				json = getNext(json, '{');
+
+				json = skipSpaces(json);
+
+				if (*json == '}')
 				{
-					ArrayFn::pushBack(number, *json);
+					getNext(json, '}');
+					return;
+				}
+
+				while (*json)
+				{
+					StringId32 id;
+					FixedString key;
+					json = parseKeyId(json, id, key);
+
+					json = skipSpaces(json);
+					json = getNext(json, '=');
+					json = skipSpaces(json);
+
+					visitor(id, key, json);
+
+					json = skipValue(json);
+					json = skipSpaces(json);
+
+					if (*json == '}')
+					{
+						getNext(json, '}');
+						return;
+					}
+
+					json = skipSpaces(json);
 				}
 			}
 
-			if (*json == 'e' || *json == 'E')
+			RIO_FATAL("Bad object");
+		}
+
+		namespace
+		{
+		// Puts the values into the hash map, checks for StringId32 collisions in debug builds
+		struct ObjectIndexBuilder
+		{
+			JsonObjectIndex& object;
+#if RIO_DEBUG
+			HashMap<FixedString> keys;
+#endif // RIO_DEBUG
+
+			ObjectIndexBuilder(JsonObjectIndex& object, Allocator& a)
+				: object(object)
+#if RIO_DEBUG
+				, keys(a)
+#endif // RIO_DEBUG
 			{
-				ArrayFn::pushBack(number, *json);
-				json = getNext(json);
+				RIO_UNUSED(a);
+			}
 
-				if (*json == '-' || *json == '+')
+			void operator()(StringId32 id, const FixedString& key, const char* value)
+			{
+#if RIO_DEBUG
+				if (Hash32Fn::has(keys, id.getId()))
 				{
-					ArrayFn::pushBack(number, *json);
-					json = getNext(json);
+					const FixedString& other = Hash32Fn::get(keys, id.getId(), key);
+					RIO_ASSERT(other == key, "StringId32 collision between keys '%.*s' and '%.*s'"
+						, int(other.getLength()), other.getData(), int(key.getLength()), key.getData());
 				}
-				while (::isdigit(*json)) // TODO replace for internal string function
+				Hash32Fn::set(keys, id.getId(), key);
+#endif // RIO_DEBUG
+				RIO_UNUSED(key);
+				Hash32Fn::set(object, id.getId(), value);
+			}
+		};
+
+		// Looks for the last value of the key, checks for StringId32 collisions in debug builds
+		struct ObjectValueFinder
+		{
+			StringId32 id;
+			const char* value;
+			FixedString key;
+
+			void operator()(StringId32 otherId, const FixedString& otherKey, const char* otherValue)
+			{
+				if (otherId == id)
 				{
-					ArrayFn::pushBack(number, *json);
-					json = getNext(json);
+					RIO_ASSERT(value == nullptr || otherKey == key, "StringId32 collision between keys '%.*s' and '%.*s'"
+						, int(key.getLength()), key.getData(), int(otherKey.getLength()), otherKey.getData());
+					value = otherValue;
+					key = otherKey;
 				}
 			}
+		};
+		} // namespace (anonymous)
 
-			// Ensure null terminated
-			ArrayFn::pushBack(number, '\0');
-			return Rio::parseDouble(ArrayFn::begin(number));
+		double parseDouble(const char* json)
+		{
+			RIO_ASSERT_NOT_NULL(json);
+
+			double value = 0.0;
+			const char* end = NumberParserFn::parseDouble(json, value);
+			RIO_ASSERT(end != nullptr, "Bad number");
+			RIO_UNUSED(end);
+			return value;
 		}
 
 		bool parseBool(const char* json)
@@ -277,17 +395,35 @@ namespace Rio
 
 		int32_t parseInt(const char* json)
 		{
-			return (int32_t)parseDouble(json);
+			RIO_ASSERT_NOT_NULL(json);
+
+			int32_t value = 0;
+			const char* end = NumberParserFn::parseInt(json, value);
+			RIO_ASSERT(end != nullptr, "Bad number");
+			RIO_UNUSED(end);
+			return value;
 		}
 
 		uint32_t parseUint(const char* json)
 		{
-			return (uint32_t)parseDouble(json);
+			RIO_ASSERT_NOT_NULL(json);
+
+			uint32_t value = 0;
+			const char* end = NumberParserFn::parseUint(json, value);
+			RIO_ASSERT(end != nullptr, "Bad number");
+			RIO_UNUSED(end);
+			return value;
 		}
 
 		float parseFloat(const char* json)
 		{
-			return (float)parseDouble(json);
+			RIO_ASSERT_NOT_NULL(json);
+
+			float value = 0.0f;
+			const char* end = NumberParserFn::parseFloat(json, value);
+			RIO_ASSERT(end != nullptr, "Bad number");
+			RIO_UNUSED(end);
+			return value;
 		}
 
 		void parseArray(const char* json, JsonArray& array)
@@ -325,6 +461,143 @@ namespace Rio
 			RIO_FATAL("Bad array");
 		}
 
+		namespace
+		{
+		// Array items converted by the jobs of convertArrayParallel()
+		struct ArrayItemRange
+		{
+			ArrayItemFunction function;
+			void* userData;
+			const char* const* items;
+
+			static void convert(uint32_t first, uint32_t last, void* data)
+			{
+				const ArrayItemRange* range = (const ArrayItemRange*)data;
+				for (uint32_t i = first; i < last; ++i)
+				{
+					range->function(range->items[i], i, range->userData);
+				}
+			}
+		};
+		} // namespace (anonymous)
+
+		void convertArrayParallel(JobSystem& jobSystem, const JsonArray& array, ArrayItemFunction function, void* userData, uint32_t minItemsPerJob)
+		{
+			RIO_ASSERT(function != nullptr, "Function must be != NULL");
+
+			const size_t itemsCount = ArrayFn::getCount(array);
+			RIO_ASSERT(itemsCount <= UINT32_MAX, "Too many items");
+
+			ArrayItemRange range;
+			range.function = function;
+			range.userData = userData;
+			range.items = ArrayFn::begin(array);
+
+			minItemsPerJob = minItemsPerJob > 0 ? minItemsPerJob : 1;
+			if (jobSystem.getThreadsCount() < 2 || itemsCount < 2 * size_t(minItemsPerJob))
+			{
+				ArrayItemRange::convert(0, uint32_t(itemsCount), &range);
+				return;
+			}
+
+			// A few ranges per thread like parallelFor() picks, but not smaller than minItemsPerJob
+			uint32_t rangeSize = uint32_t(itemsCount / (jobSystem.getThreadsCount() * 4));
+			rangeSize = rangeSize > minItemsPerJob ? rangeSize : minItemsPerJob;
+			jobSystem.wait(jobSystem.parallelFor(uint32_t(itemsCount), ArrayItemRange::convert, &range, rangeSize));
+		}
+
+		namespace
+		{
+		// Appends the parsed items to the array
+		template <typename T>
+		struct NumberArraySink
+		{
+			Array<T>& array;
+
+			bool operator()(const T& item)
+			{
+				ArrayFn::pushBack(array, item);
+				return true;
+			}
+		};
+
+		// Stores the parsed items into a fixed-size buffer and stops when the buffer is full
+		template <typename T>
+		struct NumberBufferSink
+		{
+			T* items;
+			size_t capacity;
+			size_t count;
+
+			bool operator()(const T& item)
+			{
+				items[count++] = item;
+				return count < capacity;
+			}
+		};
+		} // namespace (anonymous)
+
+		// Parses the RJSON array of numbers in a single pass, without looking
+		// for the item boundaries first, and hands every item over to sink
+		template <typename T, typename Sink>
+		static void parseNumberArray(const char* json, const char* (*parseNumber)(const char*, T&), Sink& sink)
+		{
+			RIO_ASSERT_NOT_NULL(json);
+
+			json = getNext(json, '[');
+			json = skipSpaces(json);
+
+			while (*json != ']')
+			{
+				T item;
+				json = parseNumber(json, item);
+				if (json == nullptr)
+				{
+					RIO_FATAL("Bad number");
+					return;
+				}
+
+				if (!sink(item))
+				{
+					return;
+				}
+
+				json = skipSpaces(json);
+			}
+		}
+
+		void parseFloatArray(const char* json, Array<float>& array)
+		{
+			NumberArraySink<float> sink = { array };
+			parseNumberArray(json, NumberParserFn::parseFloat, sink);
+		}
+
+		void parseIntArray(const char* json, Array<int32_t>& array)
+		{
+			NumberArraySink<int32_t> sink = { array };
+			parseNumberArray(json, NumberParserFn::parseInt, sink);
+		}
+
+		void parseUintArray(const char* json, Array<uint32_t>& array)
+		{
+			NumberArraySink<uint32_t> sink = { array };
+			parseNumberArray(json, NumberParserFn::parseUint, sink);
+		}
+
+		size_t parseFloatArray(const char* json, float* items, size_t count)
+		{
+			RIO_ASSERT_NOT_NULL(items);
+
+			if (count == 0)
+			{
+				return 0;
+			}
+
+			NumberBufferSink<float> sink = { items, count, 0 };
+			parseNumberArray(json, NumberParserFn::parseFloat, sink);
+			return sink.count;
+		}
+
 		void parseRootObject(const char* json, Map<DynamicString, const char*>& object)
 		{
 			RIO_ASSERT_NOT_NULL(json);
@@ -479,6 +752,22 @@ namespace Rio
 			RIO_FATAL("Bad object");
 		}
 
+		void parseObject(const char* json, JsonObjectIndex& object)
+		{
+			TempAllocator1024 ta;
+			ObjectIndexBuilder builder(object, ta);
+			visitObject(json, builder);
+		}
+
+		const char* findValue(const char* json, StringId32 key)
+		{
+			ObjectValueFinder finder;
+			finder.id = key;
+			finder.value = nullptr;
+			visitObject(json, finder);
+			return finder.value;
+		}
+
 		void parse(const char* json, JsonObject& object)
 		{
 			RIO_ASSERT_NOT_NULL(json);
@@ -504,86 +793,53 @@ namespace Rio
 
 		Vector2 parseVector2(const char* json)
 		{
-			TempAllocator64 ta;
-			JsonArray array(ta);
-			Rjson::parseArray(json, array);
+			float items[2];
+			const size_t count = parseFloatArray(json, items, 2);
+			RIO_ASSERT(count == 2, "Bad Vector2");
+			RIO_UNUSED(count);
 
-			Vector2 v;
-			v.x = Rjson::parseFloat(array[0]);
-			v.y = Rjson::parseFloat(array[1]);
-			return v;
+			return Vector2(items[0], items[1]);
 		}
 
 		Vector3 parseVector3(const char* json)
 		{
-			TempAllocator64 ta;
-			JsonArray array(ta);
-			Rjson::parseArray(json, array);
+			float items[3];
+			const size_t count = parseFloatArray(json, items, 3);
+			RIO_ASSERT(count == 3, "Bad Vector3");
+			RIO_UNUSED(count);
 
-			Vector3 v;
-			v.x = Rjson::parseFloat(array[0]);
-			v.y = Rjson::parseFloat(array[1]);
-			v.z = Rjson::parseFloat(array[2]);
-			return v;
+			return Vector3(items[0], items[1], items[2]);
 		}
 
 		Vector4 parseVector4(const char* json)
 		{
-			TempAllocator64 ta;
-			JsonArray array(ta);
-			Rjson::parseArray(json, array);
+			float items[4];
+			const size_t count = parseFloatArray(json, items, 4);
+			RIO_ASSERT(count == 4, "Bad Vector4");
+			RIO_UNUSED(count);
 
-			Vector4 v;
-			v.x = Rjson::parseFloat(array[0]);
-			v.y = Rjson::parseFloat(array[1]);
-			v.z = Rjson::parseFloat(array[2]);
-			v.w = Rjson::parseFloat(array[3]);
-			return v;
+			return Vector4(items[0], items[1], items[2], items[3]);
 		}
 
 		Quaternion parseQuaternion(const char* json)
 		{
-			TempAllocator64 ta;
-			JsonArray array(ta);
-			Rjson::parseArray(json, array);
-
-			Vector3 axis;
-			axis.x = Rjson::parseFloat(array[0]);
-			axis.y = Rjson::parseFloat(array[1]);
-			axis.z = Rjson::parseFloat(array[2]);
+			float items[4];
+			const size_t count = parseFloatArray(json, items, 4);
+			RIO_ASSERT(count == 4, "Bad Quaternion");
+			RIO_UNUSED(count);
 
-			float angle = Rjson::parseFloat(array[3]);
-
-			return Quaternion(axis, angle);
+			const Vector3 axis(items[0], items[1], items[2]);
+			return Quaternion(axis, items[3]);
 		}
 
 		Matrix4x4 parseMatrix4x4(const char* json)
 		{
-			TempAllocator128 ta;
-			JsonArray array(ta);
-			Rjson::parseArray(json, array);
-
-			Matrix4x4 m;
-			m.x.x = Rjson::parseFloat(array[0]);
-			m.x.y = Rjson::parseFloat(array[1]);
-			m.x.z = Rjson::parseFloat(array[2]);
-			m.x.w = Rjson::parseFloat(array[3]);
-
-			m.y.x = Rjson::parseFloat(array[4]);
-			m.y.y = Rjson::parseFloat(array[5]);
-			m.y.z = Rjson::parseFloat(array[6]);
-			m.y.w = Rjson::parseFloat(array[7]);
-
-			m.z.x = Rjson::parseFloat(array[8]);
-			m.z.y = Rjson::parseFloat(array[9]);
-			m.z.z = Rjson::parseFloat(array[10]);
-			m.z.w = Rjson::parseFloat(array[11]);
-
-			m.t.x = Rjson::parseFloat(array[12]);
-			m.t.y = Rjson::parseFloat(array[13]);
-			m.t.z = Rjson::parseFloat(array[14]);
-			m.t.w = Rjson::parseFloat(array[15]);
-			return m;
+			float items[16];
+			const size_t count = parseFloatArray(json, items, 16);
+			RIO_ASSERT(count == 16, "Bad Matrix4x4");
+			RIO_UNUSED(count);
+
+			return Matrix4x4(items);
 		}
 
 		StringId32 parseStringId(const char* json)
@@ -4,10 +4,12 @@
 #include "Core/Base/Config.h"
 
 #include "Core/Strings/DynamicString.h"
+#include "Core/Strings/StringId32.h"
 #include "Core/Strings/StringId64.h"
 #include "Core/Containers/Map.h"
 
 #include "Core/Json/JsonTypes.h"
+#include "Core/Thread/JobSystem.h"
 
 #include "Core/Math/Vector2.h"
 #include "Core/Math/Vector3.h"
@@ -33,6 +35,32 @@ namespace Rio
 		// Parses the RJSON array and puts it into array as pointers to
 		// the corresponding items into the original json string.
 		void parseArray(const char* json, JsonArray& array);
+
+		// Called by convertArrayParallel() for every item of the array.
+		// index is the position of the item in the array.
+		typedef void (*ArrayItemFunction)(const char* json, size_t index, void* userData);
+
+		// Calls function on every item of the array found by parseArray().
+		// The items are split into contiguous ranges of at least minItemsPerJob items run as jobs
+		// of jobSystem, the calling thread runs jobs until they are done and must be one of its threads.
+		// Arrays with fewer than 2 * minItemsPerJob items are converted on the calling thread only.
+		// function must only write the output of its own index.
+		void convertArrayParallel(JobSystem& jobSystem, const JsonArray& array, ArrayItemFunction function, void* userData, uint32_t minItemsPerJob = 256);
+
+		// Parses the RJSON array and converts every item with convert() into items.
+		// items[i] is the i-th item of the array regardless of the number of threads.
+		template <typename T>
+		void parseArrayParallel(JobSystem& jobSystem, const char* json, Array<T>& items, void (*convert)(const char* json, T& item), uint32_t minItemsPerJob = 256);
+
+		// Parses the RJSON array of numbers in a single pass and appends the items to array.
+		// It is faster than parseArray() followed by parseFloat() on every item.
+		void parseFloatArray(const char* json, Array<float>& array);
+		void parseIntArray(const char* json, Array<int32_t>& array);
+		void parseUintArray(const char* json, Array<uint32_t>& array);
+
+		// Parses at most count numbers of the RJSON array into items
+		// and returns the number of items parsed.
+		size_t parseFloatArray(const char* json, float* items, size_t count);
 		
 		// Parses the RJSON object and puts it into object as map from
 		// key to pointer to the corresponding value into the original string json.
@@ -42,6 +70,18 @@ namespace Rio
 		// key to pointer to the corresponding value into the original json string
 		void parseObject(const char* json, JsonObject& object);
 
+		// Parses the RJSON object and puts it into object as map from
+		// StringId32 of the key to pointer to the corresponding value into the original json string.
+		// Keys are hashed once, keys without escape sequences are hashed in place.
+		// If the key is not unique, the last one in order of appearance is kept.
+		void parseObject(const char* json, JsonObjectIndex& object);
+
+		// Returns the pointer to the value of key into the original json string
+		// or nullptr if the RJSON object has no such key.
+		// If the key is not unique, the last one in order of appearance is returned.
+		// Does not allocate memory for keys without escape sequences.
+		const char* findValue(const char* json, StringId32 key);
+
 		// Parses the RJSON-encoded json.
 		void parse(const char* json, JsonObject& object);
 
@@ -71,4 +111,34 @@ namespace Rio
 
 	} // namespace Rjson
 
+	namespace Rjson
+	{
+		template <typename T>
+		inline void parseArrayParallel(JobSystem& jobSystem, const char* json, Array<T>& items, void (*convert)(const char* json, T& item), uint32_t minItemsPerJob)
+		{
+			struct Context
+			{
+				T* items;
+				void (*convert)(const char* json, T& item);
+
+				static void convertItem(const char* json, size_t index, void* userData)
+				{
+					Context* context = (Context*)userData;
+					context->convert(json, context->items[index]);
+				}
+			};
+
+			JsonArray array(*items.allocator);
+			parseArray(json, array);
+
+			const size_t first = ArrayFn::getCount(items);
+			ArrayFn::resize(items, first + ArrayFn::getCount(array));
+
+			Context context;
+			context.items = ArrayFn::begin(items) + first;
+			context.convert = convert;
+			convertArrayParallel(jobSystem, array, Context::convertItem, &context, minItemsPerJob);
+		}
+	} // namespace Rjson
+
 } // namespace Rio
@@ -8,6 +8,7 @@ namespace Rio
 	void TcpSocket::open()
 	{
 		socket = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+		isBlocking = true;
 		RIO_ASSERT(socket >= 0, "socket: errno = %d", errno);
 	}
 
@@ -70,7 +71,10 @@ namespace Rio
 		int err = ::accept(socket, NULL, NULL);
 
 		if (err >= 0)
+		{
 			c.socket = err;
+			c.isBlocking = true;
+		}
 		else if (err == -1 && errno == EBADF)
 			ar.error = AcceptResult::BAD_SOCKET;
 		else if (err == -1 && (errno == EAGAIN || errno == EWOULDBLOCK))
@@ -168,6 +172,7 @@ namespace Rio
 	{
 		int flags = fcntl(socket, F_GETFL, 0);
 		fcntl(socket, F_SETFL, blocking ? (flags & ~O_NONBLOCK) : O_NONBLOCK);
+		isBlocking = blocking;
 	}
 
 	void TcpSocket::setReuseAddress(bool reuse)
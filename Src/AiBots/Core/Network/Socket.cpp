@@ -0,0 +1,33 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/Network/Socket.h"
+
+#include "Core/Thread/JobSystem.h"
+
+namespace Rio
+{
+	ReadResult TcpSocket::readAsync(JobSystem& jobSystem, void* data, size_t size)
+	{
+		AsyncRead asyncRead;
+		asyncRead.socket = this;
+		asyncRead.data = (char*)data;
+		asyncRead.size = size;
+		asyncRead.result.error = ReadResult::NO_ERROR;
+		asyncRead.result.bytesRead = 0;
+		const bool wasBlocking = isBlocking;
+		setBlocking(false);
+		jobSystem.waitUntil(pollRead, &asyncRead);
+		setBlocking(wasBlocking);
+		return asyncRead.result;
+	}
+
+	bool TcpSocket::pollRead(void* data)
+	{
+		AsyncRead& asyncRead = *(AsyncRead*)data;
+		const ReadResult result = asyncRead.socket->readInternal(asyncRead.data + asyncRead.result.bytesRead
+			, asyncRead.size - asyncRead.result.bytesRead);
+		asyncRead.result.bytesRead += result.bytesRead;
+		asyncRead.result.error = result.error;
+		return result.error != ReadResult::NO_ERROR || asyncRead.result.bytesRead == asyncRead.size;
+	}
+
+} // namespace Rio
@@ -29,6 +29,8 @@
 
 namespace Rio
 {
+	class JobSystem;
+
 	struct ConnectResult
 	{
 		enum
@@ -95,6 +97,10 @@ namespace Rio
 			return readInternal(data, size);
 		}
 
+		// Reads size bytes like read() but suspends the calling job instead of blocking its thread,
+		// see JobSystem::waitUntil(). The socket is left in the mode it was in.
+		ReadResult readAsync(JobSystem& jobSystem, void* data, size_t size);
+
 		WriteResult writeInternal(const void* data, size_t size);
 
 		WriteResult writeNonBlocking(const void* data, size_t size)
@@ -113,12 +119,25 @@ namespace Rio
 		void setReuseAddress(bool reuse);
 		void setTimeout(uint32_t seconds);
 	private:
+		struct AsyncRead
+		{
+			TcpSocket* socket;
+			char* data;
+			size_t size;
+			ReadResult result;
+		};
+
+		// Reads what has arrived, returns whether the read is done
+		static bool pollRead(void* data);
 
 #if RIO_PLATFORM_POSIX
 		int socket = 0;
 #elif RIO_PLATFORM_WINDOWS
 		SOCKET socket = INVALID_SOCKET;
 #endif
+		// Mode set by setBlocking(), sockets are created blocking.
+		// Windows cannot query it back.
+		bool isBlocking = true;
 	};
 
 } // namespace Rio
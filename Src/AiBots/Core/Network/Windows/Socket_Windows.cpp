@@ -8,6 +8,7 @@ namespace Rio
 	void TcpSocket::open()
 	{
 		socket = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+		isBlocking = true;
 		RIO_ASSERT(socket >= 0, "socket: WSAGetLastError = %d", WSAGetLastError());
 	}
 
@@ -73,6 +74,8 @@ namespace Rio
 		if (err != INVALID_SOCKET)
 		{
 			c.socket = err;
+			// Inherited from the listening socket on Windows
+			c.isBlocking = isBlocking;
 			return ar;
 		}
 
@@ -174,6 +177,7 @@ namespace Rio
 		//Warning! http://www.sockets.com/winsock.htm#IoctlSocket
 		u_long nonBlocking = blocking ? 0 : 1;
 		ioctlsocket(socket, FIONBIO, &nonBlocking);
+		isBlocking = blocking;
 	}
 
 	void TcpSocket::setReuseAddress(bool reuse)
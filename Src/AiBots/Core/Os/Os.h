@@ -19,6 +19,8 @@ namespace Os
 	bool isDirectory(const char* path);
 	// Returns whether the path is a regular file.
 	bool isFile(const char* path);
+	// Returns the time of the last modification in nanoseconds since 1970-01-01 UTC, 0 if path does not exist
+	uint64_t getLastModifiedTime(const char* path);
 	// Creates a regular file.
 	void createFile(const char* path);
 	// Deletes a regular file.
@@ -0,0 +1,164 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/Os/Os.h"
+
+#if RIO_PLATFORM_POSIX
+#include <dirent.h> // opendir, readdir
+#include <dlfcn.h> // dlopen, dlclose, dlsym
+#include <errno.h>
+#include <fcntl.h> // open
+#include <stdio.h> // puts, fflush
+#include <sys/stat.h> // stat, mkdir
+#include <sys/wait.h> // waitpid
+#include <time.h> // clock_gettime
+#include <unistd.h> // access, unlink, rmdir, getcwd, fork, execv
+#endif // RIO_PLATFORM_POSIX
+
+namespace Rio
+{
+	namespace Os
+	{
+#if RIO_PLATFORM_POSIX
+		void log(const char* msg)
+		{
+			puts(msg);
+			fflush(stdout);
+		}
+
+		bool exists(const char* path)
+		{
+			return access(path, F_OK) != -1;
+		}
+
+		bool isDirectory(const char* path)
+		{
+			struct stat info;
+			return stat(path, &info) != -1 && S_ISDIR(info.st_mode);
+		}
+
+		bool isFile(const char* path)
+		{
+			struct stat info;
+			return stat(path, &info) != -1 && S_ISREG(info.st_mode);
+		}
+
+		uint64_t getLastModifiedTime(const char* path)
+		{
+			struct stat info;
+			if (stat(path, &info) == -1)
+			{
+				return 0;
+			}
+#if RIO_PLATFORM_OSX || RIO_PLATFORM_IOS
+			return uint64_t(info.st_mtimespec.tv_sec) * 1000000000 + uint64_t(info.st_mtimespec.tv_nsec);
+#else
+			return uint64_t(info.st_mtim.tv_sec) * 1000000000 + uint64_t(info.st_mtim.tv_nsec);
+#endif // RIO_PLATFORM_OSX || RIO_PLATFORM_IOS
+		}
+
+		void createFile(const char* path)
+		{
+			int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+			RIO_ASSERT(fd != -1, "open: errno = %d", errno);
+			::close(fd);
+		}
+
+		void deleteFile(const char* path)
+		{
+			int err = unlink(path);
+			RIO_ASSERT(err == 0, "unlink: errno = %d", errno);
+			RIO_UNUSED(err);
+		}
+
+		void createDirectory(const char* path)
+		{
+			int err = mkdir(path, 0755);
+			RIO_ASSERT(err == 0, "mkdir: errno = %d", errno);
+			RIO_UNUSED(err);
+		}
+
+		void deleteDirectory(const char* path)
+		{
+			int err = rmdir(path);
+			RIO_ASSERT(err == 0, "rmdir: errno = %d", errno);
+			RIO_UNUSED(err);
+		}
+
+		void getFileList(const char* path, Vector<DynamicString>& files)
+		{
+			DIR* dir = opendir(path);
+			RIO_ASSERT(dir != nullptr, "opendir: errno = %d", errno);
+			if (dir == nullptr)
+			{
+				return;
+			}
+
+			while (struct dirent* entry = readdir(dir))
+			{
+				if ((strCmp(entry->d_name, ".") == 0) || (strCmp(entry->d_name, "..") == 0))
+				{
+					continue;
+				}
+
+				DynamicString filename(getDefaultAllocator());
+
+				filename = entry->d_name;
+				VectorFn::pushBack(files, filename);
+			}
+
+			closedir(dir);
+		}
+
+		const char* getCurrentDirName(char* buf, size_t size)
+		{
+			return getcwd(buf, size);
+		}
+
+		int64_t getClockTime()
+		{
+			// Not moved by changes of the wall clock
+			timespec now;
+			clock_gettime(CLOCK_MONOTONIC, &now);
+			return int64_t(now.tv_sec) * 1000000000 + int64_t(now.tv_nsec);
+		}
+
+		int64_t getClockFrequency()
+		{
+			// getClockTime() is in nanoseconds
+			return 1000000000;
+		}
+
+		void* openLibrary(const char* path)
+		{
+			return dlopen(path, RTLD_LAZY);
+		}
+
+		void closeLibrary(void* library)
+		{
+			dlclose(library);
+		}
+
+		void* lookupLibrarySymbol(void* library, const char* name)
+		{
+			return dlsym(library, name);
+		}
+
+		int executeProcess(const char* args[])
+		{
+			pid_t pid = fork();
+			RIO_ASSERT(pid != -1, "fork: errno = %d", errno);
+			if (pid == 0)
+			{
+				execv(args[0], (char* const*)args);
+				// Only reached when execv() failed
+				_exit(127);
+			}
+
+			int status = 0;
+			while (waitpid(pid, &status, 0) == -1 && errno == EINTR)
+			{
+			}
+			return WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+		}
+#endif // RIO_PLATFORM_POSIX
+	} // namespace Os
+} // namespace Rio
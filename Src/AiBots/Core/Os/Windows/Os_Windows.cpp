@@ -34,6 +34,18 @@ namespace Rio
 			return (fAttr != INVALID_FILE_ATTRIBUTES && (fAttr & FILE_ATTRIBUTE_DIRECTORY) == 0);
 		}
 
+		uint64_t getLastModifiedTime(const char* path)
+		{
+			WIN32_FILE_ATTRIBUTE_DATA data;
+			if (GetFileAttributesEx(path, GetFileExInfoStandard, &data) == 0)
+			{
+				return 0;
+			}
+			// FILETIME counts 100 ns intervals since 1601-01-01 UTC
+			const uint64_t intervals = (uint64_t(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime;
+			return (intervals - 116444736000000000ull) * 100;
+		}
+
 		void createFile(const char* path)
 		{
 			HANDLE hFile = CreateFile(path, GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
@@ -11,6 +11,14 @@ namespace Rio
 		return out;
 	}
 
+	char* DynamicStringFn::copyToCString(const char* s, size_t length, Allocator& a)
+	{
+		char* out = (char*)a.allocate(length + 1);
+		memcpy(out, s, length);
+		out[length] = '\0';
+		return out;
+	}
+
 	DynamicString DynamicStringFn::join(const Array<char*>& a, const DynamicString& sep)
 	{
 		const int64_t aLen = ArrayFn::getCount(a);
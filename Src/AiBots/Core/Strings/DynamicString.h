@@ -7,6 +7,8 @@
 #include "Core/Memory/Memory.h"
 #include "Core/Strings/StringUtils.h"
 #include "Core/Strings/StringId32.h"
+#include "Core/Strings/StringSearch.h"
+#include "Core/Strings/StringView.h"
 #include "Core/Containers/Array.h"
 
 #include <algorithm>
@@ -19,13 +21,16 @@ namespace Rio
 	namespace DynamicStringFn
 	{
 		char* copyDynamicStringToCString(const DynamicString& s, Allocator& a);
+		// Returns a NUL-terminated copy of the length first characters of s
+		char* copyToCString(const char* s, size_t length, Allocator& a);
 		// concatenates the elements of the array to create a single string
 		// The separator string sep is placed between elements in the resulting string
 		DynamicString join(const Array<char*>& array, const DynamicString& sep);
 	}
 
 	// dynamic string
-	// Array is used as internal container
+	// Strings of up to INLINE_CAPACITY characters are stored inside the object,
+	// longer ones are allocated from the allocator
 	class DynamicString
 	{
 	public:
@@ -33,15 +38,21 @@ namespace Rio
 		DynamicString(const char* s, Allocator& allocator = getDefaultAllocator());
 		DynamicString(char c, Allocator& a = getDefaultAllocator());
 		DynamicString(const char* s, size_t length, Allocator& a = getDefaultAllocator());
+		explicit DynamicString(StringView s, Allocator& a = getDefaultAllocator());
 		DynamicString(const DynamicString& s);
+		// Steals the allocated buffer of s, s is left empty
+		DynamicString(DynamicString&& s);
 
-		~DynamicString() = default;
+		~DynamicString();
 
 		DynamicString& operator+=(const DynamicString& s);
 		DynamicString& operator+=(const char* s);
 		DynamicString& operator+=(const char c);
+		DynamicString& operator+=(StringView s);
 
 		DynamicString& operator=(const DynamicString& s);
+		// Steals the allocated buffer of s if both use the same allocator, copies otherwise
+		DynamicString& operator=(DynamicString&& s);
 		DynamicString& operator=(const char* s);
 		DynamicString& operator=(const char c);
 
@@ -84,6 +95,7 @@ namespace Rio
 
 		bool operator==(const DynamicString& s) const;
 		bool operator==(const char* s) const;
+		bool operator==(StringView s) const;
 		inline bool operator!=(const DynamicString& rhs)
 		{
 			return !operator==(rhs);
@@ -96,16 +108,19 @@ namespace Rio
 
 		inline char& operator[](size_t index)
 		{
-			return stringData[index];
+			RIO_ASSERT(index <= length, "Index out of bounds");
+			return getBuffer()[index];
 		}
 		inline const char& operator[](size_t index) const
 		{
-			return stringData[index];
+			RIO_ASSERT(index <= length, "Index out of bounds");
+			return getBuffer()[index];
 		}
 
 		size_t append(char c);
 		size_t append(const char* cStr);
 		size_t append(const DynamicString& other);
+		size_t append(StringView other);
 
 		size_t getLength() const;
 		size_t getCapacity() const;
@@ -122,55 +137,46 @@ namespace Rio
 		bool endsWith(const char* s) const;
 		StringId32 toStringId32() const;
 		const char* toCStr() const;
+		// The view is valid until the string is modified
+		StringView toStringView() const;
+		operator StringView() const
+		{
+			return toStringView();
+		}
 		
 		inline char* begin()
 		{
-			return ArrayFn::begin(stringData);
+			return getBuffer();
 		}
 		
 		inline char* end()
 		{
-			return ArrayFn::end(stringData);
+			return getBuffer() + length;
 		}
 		
 		inline char& front()
 		{
-			return ArrayFn::front(stringData);
+			RIO_ASSERT(length > 0, "String is empty");
+			return getBuffer()[0];
 		}
 		
 		inline char& back()
 		{
-			return ArrayFn::back(stringData);
+			RIO_ASSERT(length > 0, "String is empty");
+			return getBuffer()[length - 1];
 		}
 		
 		inline void clear()
 		{
-			ArrayFn::clear(stringData);
+			setLength(0);
 		}
 		
-		inline void shrinkToFit()
-		{
-			ArrayFn::condense(stringData);
-			if (back() != '\0')
-			{
-				ArrayFn::pushBack(stringData, '\0');
-			}
-		}
-
-		inline void resize(size_t length)
-		{
-			ArrayFn::resize(stringData, length);
-			ArrayFn::condense(stringData);
-			if (back() != '\0')
-			{
-				ArrayFn::pushBack(stringData, '\0');
-			}
-		}
-
-		inline void reserve(size_t capacity)
-		{
-			ArrayFn::reserve(stringData, capacity);
-		}
+		// Releases the unused memory, moves the string back to the inline storage if it fits
+		void shrinkToFit();
+		// New characters are set to '\0'
+		void resize(size_t length);
+		// Makes room for at least capacity characters plus the terminating '\0'
+		void reserve(size_t capacity);
 
 		inline DynamicString substring(size_t begin, size_t end)
 		{
@@ -178,186 +184,328 @@ namespace Rio
 			{
 				end = this->getLength();
 			}
+			RIO_ASSERT(begin <= end, "Begin must be <= end");
 
-			DynamicString out(*(stringData.allocator));
-			size_t l = end - begin;
-			out.reserve(l);
-
-			for (size_t i = begin; i < end; i++)
-			{
-				out.append(this[i]);
-			}
-			return out;
+			return DynamicString(getBuffer() + begin, end - begin, *allocator);
 		}
 
 		// returns the index of the first instance of sep in s, or -1 if sep is not present
-		size_t findFirst(const DynamicString& sep);
+		size_t findFirst(StringView sep) const;
 		// returns the index of the first instance of any character from
 		// chars in the string, or -1 if no character from chars is present
-		size_t findFirstFromSet(const DynamicString& chars);
+		size_t findFirstFromSet(StringView chars) const;
 		// counts the number of non-overlapping instances of sep
-		size_t getOccurencesCount(const DynamicString& sep);
+		size_t getOccurencesCount(StringView sep) const;
 		// returns the index of the last instance of sep in s, or -1 if sep is not present in the string
-		size_t findLast(const DynamicString& sep);
+		size_t findLast(StringView sep) const;
 		// returns the index of the last instance of any character from
 		// chars in the string, or -1 if no character from chars is present
-		size_t findLastFromSet(const DynamicString& chars);
+		size_t findLastFromSet(StringView chars) const;
 		// returns a new string consisting of count copies of the string
 		DynamicString getRepeated(size_t count);
 		// returns true if substr is within
-		bool contains(const DynamicString& substr);
+		bool contains(StringView substr) const;
 		// returns true if any character in chars is within
-		bool containsAny(const DynamicString& chars);
+		bool containsAny(StringView chars) const;
 		// tests whether the string begins with prefix
-		bool hasPrefix(const DynamicString& prefix);
+		bool hasPrefix(StringView prefix) const;
 		// tests whether the string ends with suffix
-		bool hasSuffix(const DynamicString& suffix);
+		bool hasSuffix(StringView suffix) const;
 		DynamicString toLower();
 		DynamicString toTitle();
 		DynamicString toUpper();
-		DynamicString trimLeft(const DynamicString& cutset);
-		DynamicString trimRight(const DynamicString& cutset);
+		// Same as above without allocating a new string
+		void toLowerInPlace();
+		void toUpperInPlace();
+		DynamicString trimLeft(StringView cutset);
+		DynamicString trimRight(StringView cutset);
 		// trim(s, cutset) is equivalent to trimLeft(trimRight(s, cutset), cutset)
-		DynamicString trim(const DynamicString& cutset);
+		DynamicString trim(StringView cutset);
 		DynamicString trimSpace();
+		// Same as above, the returned views point into this string
+		// and are valid until the string is modified
+		StringView trimLeftView(StringView cutset) const;
+		StringView trimRightView(StringView cutset) const;
+		StringView trimView(StringView cutset) const;
+		StringView trimSpaceView() const;
 		// splits the string into all substrings separated by sep and sets the out
 		// array to the substrings between those separators
-		void split(const DynamicString& sep, Array<char*>& out);
+		void split(StringView sep, Array<char*>& out);
+		// Same as above, the substrings point into this string
+		// and are valid until the string is modified
+		void split(StringView sep, Array<StringView>& out) const;
 		DynamicString stringFormat(const char* fmt, ...);
 	private:
+		// Number of characters stored without allocating, '\0' excluded.
+		// Fills the 24 bytes of the union below.
+		static const uint32_t INLINE_CAPACITY = 23;
+
+		bool getIsInline() const
+		{
+			return capacity == INLINE_CAPACITY;
+		}
+
+		char* getBuffer()
+		{
+			return getIsInline() ? inlineData : heapData;
+		}
+
+		const char* getBuffer() const
+		{
+			return getIsInline() ? inlineData : heapData;
+		}
+
+		void setLength(size_t newLength)
+		{
+			RIO_ASSERT(newLength <= capacity, "Length out of bounds");
+			length = uint32_t(newLength);
+			getBuffer()[length] = '\0';
+		}
+
+		void initialize(Allocator& a);
+		void release();
+		// Replaces the characters, s may point into this string
+		void assign(const char* s, size_t count);
+		void appendChars(const char* s, size_t count);
+		// Moves the characters to a buffer of exactly newCapacity characters plus '\0'
+		void reallocate(size_t newCapacity);
+
 		// how string is represented:
 		// "abc"
 		// [0] == "a"; [1] == "b"; [2] == "c"; [3] == "\0"
-		Array<char> stringData;
+		// length == 3, capacity is INLINE_CAPACITY while the characters are in inlineData
+		Allocator* allocator;
+		uint32_t length;
+		uint32_t capacity;
+		union
+		{
+			char* heapData;
+			char inlineData[INLINE_CAPACITY + 1];
+		};
 	};
 
-	// Aux functions
-	namespace
+	inline DynamicString::DynamicString(Allocator& allocator)
 	{
-		const static uint32_t PrimeRK = 16777619;
-	} // namespace (anonymous)
+		initialize(allocator);
+	}
 
-	// returns the hash and the appropriate multiplicative factor for use in the Rabin-Karp algorithm
-	static void hashStr(const DynamicString& sep, uint32_t& hash, uint32_t& power)
+	inline DynamicString::DynamicString(const char* s, Allocator& allocator)
 	{
-		hash = 0;
-
-		const size_t lsep = sep.getLength();
-		for (size_t i = 0; i < lsep; i++)
+		initialize(allocator);
+		if (s != nullptr)
 		{
-			hash = hash * PrimeRK + (uint32_t)sep[i];
+			appendChars(s, strLen(s));
 		}
+	}
+
+	inline DynamicString::DynamicString(char c, Allocator& allocator)
+	{
+		initialize(allocator);
+		append(c);
+	}
+
+	inline DynamicString::DynamicString(const char* s, size_t length, Allocator& allocator)
+	{
+		initialize(allocator);
+		appendChars(s, length);
+	}
 
-		power = 1;
+	inline DynamicString::DynamicString(StringView s, Allocator& allocator)
+	{
+		initialize(allocator);
+		appendChars(s.getData(), s.getLength());
+	}
+
+	inline DynamicString::DynamicString(const DynamicString& s)
+	{
+		initialize(*s.allocator);
+		appendChars(s.toCStr(), s.getLength());
+	}
 
-		uint32_t sq = PrimeRK;
-		for (size_t i = lsep; i > 0; i >>= 1)
+	inline DynamicString::DynamicString(DynamicString&& s)
+		: allocator(s.allocator)
+		, length(s.length)
+		, capacity(s.capacity)
+	{
+		if (s.getIsInline())
 		{
-			if ((i & 1) != 0)
-			{
-				power *= sq;
-			}
-			sq *= sq;
+			memcpy(inlineData, s.inlineData, length + 1);
+		}
+		else
+		{
+			heapData = s.heapData;
 		}
+		s.initialize(*s.allocator);
 	}
 
-	// returns the hash of the reverse of sep and the appropriate
-	// multiplicative factor for use in Rabin-Karp algorithm.
-	static void hashStrRev(const DynamicString& sep, uint32_t& hash, uint32_t& power)
+	inline DynamicString::~DynamicString()
 	{
-		hash = 0;
+		release();
+	}
+
+	inline void DynamicString::initialize(Allocator& a)
+	{
+		allocator = &a;
+		length = 0;
+		capacity = INLINE_CAPACITY;
+		inlineData[0] = '\0';
+	}
 
-		const size_t lsep = sep.getLength();
-		for (size_t i = lsep - 1; i >= 0; i--)
-			hash = hash * PrimeRK + (uint32_t)sep[i];
+	inline void DynamicString::release()
+	{
+		if (!getIsInline())
+		{
+			allocator->deallocate(heapData);
+		}
+	}
 
-		power = 1;
+	inline void DynamicString::reallocate(size_t newCapacity)
+	{
+		RIO_ASSERT(newCapacity >= length, "Capacity must be >= length");
+		char* oldData = getBuffer();
 
-		uint32_t sq = PrimeRK;
-		for (size_t i = lsep; i > 0; i >>= 1)
+		if (newCapacity <= INLINE_CAPACITY)
 		{
-			if ((i & 1) != 0)
-				power *= sq;
-			sq *= sq;
+			if (!getIsInline())
+			{
+				memcpy(inlineData, oldData, length + 1);
+				allocator->deallocate(oldData);
+				capacity = INLINE_CAPACITY;
+			}
+			return;
 		}
+
+		char* newData = (char*)allocator->allocate(newCapacity + 1, RIO_ALIGNOF(char));
+		memcpy(newData, oldData, length + 1);
+		release();
+		heapData = newData;
+		capacity = uint32_t(newCapacity);
 	}
 
-	inline DynamicString::DynamicString(Allocator& allocator)
-		: stringData(allocator)
+	inline void DynamicString::reserve(size_t newCapacity)
 	{
-		ArrayFn::pushBack(stringData, '\0');
+		if (newCapacity > capacity)
+		{
+			// Grow geometrically so that appending one character at a time stays linear
+			const size_t grownCapacity = size_t(capacity) * 2;
+			reallocate(newCapacity > grownCapacity ? newCapacity : grownCapacity);
+		}
 	}
 
-	inline DynamicString::DynamicString(const char* s, Allocator& allocator)
-		: stringData(allocator)
+	inline void DynamicString::shrinkToFit()
 	{
-		if (s != nullptr)
+		if (!getIsInline() && capacity > length)
 		{
-			ArrayFn::push(stringData, s, strLen(s));
+			reallocate(length);
 		}
-		ArrayFn::pushBack(stringData, '\0');
 	}
 
-	inline DynamicString::DynamicString(char c, Allocator& allocator)
-		: stringData(allocator)
+	inline void DynamicString::resize(size_t newLength)
 	{
-		append(c);
+		reserve(newLength);
+		if (newLength > length)
+		{
+			memset(getBuffer() + length, '\0', newLength - length);
+		}
+		setLength(newLength);
 	}
 
-	inline DynamicString::DynamicString(const char* s, size_t length, Allocator& allocator)
-		: stringData(allocator)
+	inline void DynamicString::assign(const char* s, size_t count)
 	{
-		ArrayFn::push(stringData, s, length);
-		ArrayFn::pushBack(stringData, '\0');
+		char* buffer = getBuffer();
+		if (s >= buffer && s <= buffer + length)
+		{
+			// Assigning a part of itself, it fits in place
+			memmove(buffer, s, count);
+		}
+		else
+		{
+			setLength(0);
+			reserve(count);
+			memcpy(getBuffer(), s, count);
+		}
+		setLength(count);
 	}
 
-	inline DynamicString::DynamicString(const DynamicString& s)
-		: stringData(s.stringData)
+	inline void DynamicString::appendChars(const char* s, size_t count)
 	{
+		const char* buffer = getBuffer();
+		if (s >= buffer && s <= buffer + length)
+		{
+			// Appending a part of itself, the buffer may move
+			const size_t offset = size_t(s - buffer);
+			reserve(length + count);
+			s = getBuffer() + offset;
+		}
+		else
+		{
+			reserve(length + count);
+		}
+		memcpy(getBuffer() + length, s, count);
+		setLength(length + count);
 	}
 
 	inline DynamicString& DynamicString::operator+=(const DynamicString& s)
 	{
-		return *this += s.toCStr();
+		append(s);
+		return *this;
 	}
 
 	inline DynamicString& DynamicString::operator+=(const char* s)
 	{
-		RIO_ASSERT_NOT_NULL(s);
-		ArrayFn::popBack(stringData);
-		ArrayFn::push(stringData, s, strLen(s));
-		ArrayFn::pushBack(stringData, '\0');
+		append(s);
 		return *this;
 	}
 
 	inline DynamicString& DynamicString::operator+=(const char c)
 	{
-		ArrayFn::popBack(stringData);
-		ArrayFn::pushBack(stringData, c);
-		ArrayFn::pushBack(stringData, '\0');
+		append(c);
+		return *this;
+	}
+
+	inline DynamicString& DynamicString::operator+=(StringView s)
+	{
+		append(s);
 		return *this;
 	}
 
 	inline DynamicString& DynamicString::operator=(const DynamicString& s)
 	{
-		stringData = s.stringData;
+		assign(s.toCStr(), s.getLength());
+		return *this;
+	}
+
+	inline DynamicString& DynamicString::operator=(DynamicString&& s)
+	{
+		if (this == &s)
+		{
+			return *this;
+		}
+
+		if (allocator != s.allocator || s.getIsInline())
+		{
+			assign(s.toCStr(), s.getLength());
+			return *this;
+		}
+
+		release();
+		heapData = s.heapData;
+		length = s.length;
+		capacity = s.capacity;
+		s.initialize(*s.allocator);
 		return *this;
 	}
 
 	inline DynamicString& DynamicString::operator=(const char* s)
 	{
 		RIO_ASSERT_NOT_NULL(s);
-		ArrayFn::clear(stringData);
-		ArrayFn::push(stringData, s, strLen(s));
-		ArrayFn::pushBack(stringData, '\0');
+		assign(s, strLen(s));
 		return *this;
 	}
 
 	inline DynamicString& DynamicString::operator=(const char c)
 	{
-		ArrayFn::clear(stringData);
-		ArrayFn::pushBack(stringData, c);
-
+		assign(&c, 1);
 		return *this;
 	}
 
@@ -377,38 +525,44 @@ namespace Rio
 		return strCmp(this->toCStr(), s) == 0;
 	}
 
+	inline bool DynamicString::operator==(StringView s) const
+	{
+		return toStringView() == s;
+	}
+
 	inline size_t DynamicString::append(char c)
 	{
-		ArrayFn::popBack(this->stringData);
-		ArrayFn::pushBack(this->stringData, c);
-		ArrayFn::pushBack(this->stringData, '\0');
+		appendChars(&c, 1);
 		return getLength();
 	}
 
 	inline size_t DynamicString::append(const char* cStr)
 	{
-		ArrayFn::popBack(this->stringData);
-		ArrayFn::push(this->stringData, cStr, strLen(cStr));
-		ArrayFn::pushBack(stringData, '\0');
+		RIO_ASSERT_NOT_NULL(cStr);
+		appendChars(cStr, strLen(cStr));
 		return getLength();
 	}
 
 	inline size_t DynamicString::append(const DynamicString& other)
 	{
-		ArrayFn::popBack(this->stringData);
-		ArrayFn::push(this->stringData, &other.stringData[0], other.getLength());
-		ArrayFn::pushBack(stringData, '\0');
+		appendChars(other.toCStr(), other.getLength());
+		return getLength();
+	}
+
+	inline size_t DynamicString::append(StringView other)
+	{
+		appendChars(other.getData(), other.getLength());
 		return getLength();
 	}
 
 	inline size_t DynamicString::getLength() const
 	{
-		return strLen(this->toCStr());
+		return length;
 	}
 
 	inline size_t DynamicString::getCapacity() const
 	{
-		return ArrayFn::getCapacity(stringData);
+		return capacity;
 	}
 
 	inline void DynamicString::stripLeading(const char* s)
@@ -416,12 +570,8 @@ namespace Rio
 		RIO_ASSERT_NOT_NULL(s);
 		RIO_ASSERT(startsWith(s), "String does not start with %s", s);
 
-		const size_t thisLength = strLen(this->toCStr());
 		const size_t sLength = strLen(s);
-
-		memmove(ArrayFn::begin(stringData), ArrayFn::begin(stringData) + sLength, (thisLength - sLength));
-		ArrayFn::resize(stringData, thisLength - sLength);
-		ArrayFn::pushBack(stringData, '\0');
+		assign(getBuffer() + sLength, length - sLength);
 	}
 
 	inline void DynamicString::stripTrailing(const char* s)
@@ -429,10 +579,7 @@ namespace Rio
 		RIO_ASSERT_NOT_NULL(s);
 		RIO_ASSERT(endsWith(s), "String does not end with %s", s);
 
-		const size_t thisLength = strLen(this->toCStr());
-		const size_t sLength = strLen(s);
-		ArrayFn::resize(stringData, thisLength - sLength);
-		ArrayFn::pushBack(stringData, '\0');
+		setLength(length - strLen(s));
 	}
 
 	inline bool DynamicString::startsWith(const char* s) const
@@ -445,12 +592,11 @@ namespace Rio
 	{
 		RIO_ASSERT_NOT_NULL(s);
 
-		const size_t thisLength = strLen(this->toCStr());
 		const size_t sLength = strLen(s);
 
-		if (thisLength >= sLength)
+		if (length >= sLength)
 		{
-			return strnCmp(ArrayFn::begin(stringData) + (thisLength - sLength), s, sLength) == 0;
+			return strnCmp(getBuffer() + (length - sLength), s, sLength) == 0;
 		}
 
 		return false;
@@ -463,213 +609,41 @@ namespace Rio
 
 	inline const char* DynamicString::toCStr() const
 	{
-		return ArrayFn::begin(stringData);
+		return getBuffer();
 	}
 
-	inline size_t DynamicString::findFirst(const DynamicString& sep)
+	inline StringView DynamicString::toStringView() const
 	{
-		const size_t n = sep.getLength();
-		const size_t sl = this->getLength();
-
-		if (n == 0)
-			return 0;
-		if (n == 1)
-		{
-			const char c = sep[0];
-			for (size_t i = 0; i < sl; i++)
-			{
-				if ((*this)[i] == c)
-				{
-					return (size_t)i;
-				}
-			}
-			return -1;
-		}
-		if (n == sl)
-		{
-			if (sep == *this)
-			{
-				return 0;
-			}
-			return -1;
-		}
-		if (n > sl)
-		{
-			return -1;
-		}
-
-		// Search using Rabin-Karp
-		uint32_t hashsep, power;
-		hashStr(sep, hashsep, power);
-		uint32_t h = 0;
-		for (size_t i = 0; i < n; i++)
-		{
-			h = h * PrimeRK + (uint32_t)(*this)[i];
-		}
-		if (h == hashsep && this->substring(0, n) == sep)
-		{
-			return 0;
-		}
-		for (size_t i = n; i < sl;)
-		{
-			h *= PrimeRK;
-			h += (uint32_t)(*this)[i];
-			h -= power * (uint32_t)(*this)[i - n];
-			i++;
-			if (h == hashsep && this->substring(i - n, i) == sep)
-			{
-				return i - n;
-			}
-		}
-
-		return -1;
+		return StringView(toCStr(), getLength());
 	}
 
-	inline size_t DynamicString::findFirstFromSet(const DynamicString& chars)
+	inline size_t DynamicString::findFirst(StringView sep) const
 	{
-		const size_t cLen = chars.getLength();
-		const size_t sLen = this->getLength();
-
-		if (cLen > 0)
-		{
-			for (size_t i = 0; i < sLen; i++)
-			{
-				for (size_t j = 0; j < cLen; j++)
-				{
-					if ((*this)[i] == chars[j])
-						return (int64_t)i;
-				}
-			}
-		}
-
-		return -1;
+		return StringSearchFn::find(toCStr(), getLength(), sep.getData(), sep.getLength());
 	}
 
-	inline size_t DynamicString::getOccurencesCount(const DynamicString& sep)
+	inline size_t DynamicString::findFirstFromSet(StringView chars) const
 	{
-		size_t n = 0;
-
-		const size_t ls = this->getLength();
-		const size_t lsep = sep.getLength();
-
-		if (lsep == 0)
-			return ls + 1;
-		if (lsep == 1)
-		{
-			char c = sep[0];
-			for (size_t i = 0; i < ls; i++)
-			{
-				if ((*this)[i] == c)
-					n++;
-			}
-
-			return n;
-		}
-		if (lsep > ls)
-			return 0;
-		if (lsep == ls)
-		{
-			if (sep == *this)
-				return 1;
-			return 0;
-		}
-
-		// Rabin-Karp search
-		uint32_t hashsep, power;
-		hashStr(sep, hashsep, power);
-
-		uint32_t h = 0;
-		for (size_t i = 0; i < lsep; i++)
-			h = h * PrimeRK + (uint32_t)(*this)[i];
-
-		size_t lastMatch = 0;
-		DynamicString sepMod = sep; // a copy
-		if (h == hashsep && sep == sepMod.substring(0, lsep))
-		{
-			n++;
-			lastMatch = lsep;
-		}
-
-		for (size_t i = lsep; i < ls; /**/)
-		{
-			h *= PrimeRK;
-			h += (uint32_t)(*this)[i];
-			h -= power * (uint32_t)(*this)[i - lsep];
-			i++;
-			if (h == hashsep && lastMatch <= i - lsep &&
-				substring(i - lsep, i) == sep)
-			{
-				n++;
-				lastMatch = i;
-			}
-		}
-
-		return n;
+		CharSet set;
+		StringSearchFn::makeCharSet(chars.getData(), chars.getLength(), set);
+		return StringSearchFn::findFirstOf(toCStr(), getLength(), set);
 	}
 
-	inline size_t DynamicString::findLast(const DynamicString& sep)
+	inline size_t DynamicString::getOccurencesCount(StringView sep) const
 	{
-		size_t n = sep.getLength();
-
-		if (n == 0)
-			return this->getLength();
-		if (n == 1)
-		{
-			char c = sep[0];
-			for (size_t i = this->getLength() - 1; i >= 0; i--)
-			{
-				if ((*this)[i] == c)
-					return i;
-			}
-			return -1;
-		}
-		if (n == this->getLength())
-		{
-			if (sep == *this)
-				return 0;
-			return -1;
-		}
-		if (n > this->getLength())
-			return -1;
-
-		uint32_t hashsep, power;
-		hashStrRev(sep, hashsep, power);
-		size_t last = this->getLength() - n;
-
-		uint32_t h = 0;
-		for (size_t i = this->getLength() - 1; i >= last; i--)
-			h = h * PrimeRK + (uint32_t)(*this)[i];
-
-		if (h == hashsep && substring(last, this->getLength()) == sep)
-			return last;
-
-		for (size_t i = last - 1; i >= 0; i--)
-		{
-			h *= PrimeRK;
-			h += (uint32_t)(*this)[i];
-			h -= power * (uint32_t)(*this)[i + n];
-			if (h == hashsep && substring(i, i + n) == sep)
-				return i;
-		}
-
-		return -1;
+		return StringSearchFn::count(toCStr(), getLength(), sep.getData(), sep.getLength());
 	}
 
-	inline size_t DynamicString::findLastFromSet(const DynamicString& chars)
+	inline size_t DynamicString::findLast(StringView sep) const
 	{
-		if (chars.getLength() > 0)
-		{
-			for (size_t i = this->getLength() - 1; i >= 0; i--)
-			{
-				for (size_t j = 0; j < chars.getLength(); j++)
-				{
-					if ((*this)[i] == chars[j])
-						return i;
-				}
-			}
-		}
+		return StringSearchFn::findLast(toCStr(), getLength(), sep.getData(), sep.getLength());
+	}
 
-		return -1;
+	inline size_t DynamicString::findLastFromSet(StringView chars) const
+	{
+		CharSet set;
+		StringSearchFn::makeCharSet(chars.getData(), chars.getLength(), set);
+		return StringSearchFn::findLastOf(toCStr(), getLength(), set);
 	}
 
 	inline DynamicString DynamicString::getRepeated(size_t count)
@@ -683,38 +657,41 @@ namespace Rio
 		return out;
 	}
 
-	inline bool DynamicString::contains(const DynamicString& substr)
+	inline bool DynamicString::contains(StringView substr) const
 	{
-		return findFirst(substr) >= 0;
+		return findFirst(substr) != StringSearchFn::NOT_FOUND;
 	}
 
-	inline bool DynamicString::containsAny(const DynamicString& chars)
+	inline bool DynamicString::containsAny(StringView chars) const
 	{
-		return findFirstFromSet(chars) >= 0;
+		return findFirstFromSet(chars) != StringSearchFn::NOT_FOUND;
 	}
 
-	inline bool DynamicString::hasPrefix(const DynamicString& prefix)
+	inline bool DynamicString::hasPrefix(StringView prefix) const
 	{
-		return this->getLength() >= prefix.getLength() && substring(0, prefix.getLength()) == prefix;
+		const size_t prefixLength = prefix.getLength();
+		return getLength() >= prefixLength && memcmp(toCStr(), prefix.getData(), prefixLength) == 0;
 	}
 
-	inline bool DynamicString::hasSuffix(const DynamicString& suffix)
+	inline bool DynamicString::hasSuffix(StringView suffix) const
 	{
-		return this->getLength() >= suffix.getLength() &&
-			substring(this->getLength() - suffix.getLength(), this->getLength()) == suffix;
+		const size_t length = getLength();
+		const size_t suffixLength = suffix.getLength();
+		return length >= suffixLength && memcmp(toCStr() + length - suffixLength, suffix.getData(), suffixLength) == 0;
 	}
 
 	inline DynamicString DynamicString::toLower()
 	{
 		DynamicString out = *this;
-
-		const size_t ls = this->getLength();
-		for (size_t i = 0; i < ls; i++)
-			out[i] = Rio::toLower((*this)[i]);
-
+		out.toLowerInPlace();
 		return out;
 	}
 
+	inline void DynamicString::toLowerInPlace()
+	{
+		StringSearchFn::toLower(getBuffer(), length);
+	}
+
 	inline DynamicString DynamicString::toTitle()
 	{
 		const size_t ls = this->getLength();
@@ -743,124 +720,129 @@ namespace Rio
 	inline DynamicString DynamicString::toUpper()
 	{
 		DynamicString out = *this;
+		out.toUpperInPlace();
+		return out;
+	}
 
-		const size_t ls = this->getLength();
-		for (size_t i = 0; i < ls; i++)
-			out[i] = Rio::toUpper((*this)[i]);
+	inline void DynamicString::toUpperInPlace()
+	{
+		StringSearchFn::toUpper(getBuffer(), length);
+	}
 
-		return out;
+	inline DynamicString DynamicString::trimLeft(StringView cutset)
+	{
+		const StringView view = trimLeftView(cutset);
+		return DynamicString(view.getData(), view.getLength(), *allocator);
 	}
 
-	inline DynamicString DynamicString::trimLeft(const DynamicString& cutset)
+	inline DynamicString DynamicString::trimRight(StringView cutset)
 	{
-		const size_t slen = this->getLength();
-		const size_t clen = cutset.getLength();
-		if (this->getLength() == 0)
-			return *this;
-		int64_t pos = -1;
-		bool t = false;
+		const StringView view = trimRightView(cutset);
+		return DynamicString(view.getData(), view.getLength(), *allocator);
+	}
 
-		for (size_t i = 0; i < slen; i++)
-		{
-			for (size_t j = 0; j < clen; j++)
-			{
-				if ((*this)[i] == cutset[j])
-				{
-					t = true;
-					pos = i;
-				}
-			}
-			if (!t)
-				break;
-			t = false;
-		}
+	inline DynamicString DynamicString::trim(StringView cutset)
+	{
+		const StringView view = trimView(cutset);
+		return DynamicString(view.getData(), view.getLength(), *allocator);
+	}
 
-		if (pos != -1)
-			return substring(pos + 1, slen);
-		return *this;
+	inline DynamicString DynamicString::trimSpace()
+	{
+		return trim(" \t\n\v\f\r");
 	}
 
-	inline DynamicString DynamicString::trimRight(const DynamicString& cutset)
+	inline StringView DynamicString::trimLeftView(StringView cutset) const
 	{
-		const size_t slen = this->getLength();
-		const size_t clen = cutset.getLength();
-		if (slen == 0)
-			return *this;
-		int64_t pos = -1;
-		bool t = false;
+		CharSet set;
+		StringSearchFn::makeCharSet(cutset.getData(), cutset.getLength(), set);
 
-		for (size_t i = slen - 1; i >= 0; i--)
+		const size_t length = getLength();
+		size_t begin = StringSearchFn::findFirstNotOf(toCStr(), length, set);
+		if (begin == StringSearchFn::NOT_FOUND)
 		{
-			for (size_t j = 0; j < clen; j++)
-			{
-				if ((*this)[i] == cutset[j])
-				{
-					t = true;
-					pos = i;
-				}
-			}
-			if (!t)
-				break;
-			t = false;
+			begin = length;
 		}
+		return StringView(toCStr() + begin, length - begin);
+	}
 
-		if (pos != -1)
-			return substring(0, pos);
-		return *this;
+	inline StringView DynamicString::trimRightView(StringView cutset) const
+	{
+		CharSet set;
+		StringSearchFn::makeCharSet(cutset.getData(), cutset.getLength(), set);
+
+		const size_t last = StringSearchFn::findLastNotOf(toCStr(), getLength(), set);
+		const size_t end = last == StringSearchFn::NOT_FOUND ? 0 : last + 1;
+		return StringView(toCStr(), end);
 	}
 
-	inline DynamicString DynamicString::trim(const DynamicString& cutset)
+	inline StringView DynamicString::trimView(StringView cutset) const
 	{
-		return trimRight(cutset).trimLeft(cutset);
+		CharSet set;
+		StringSearchFn::makeCharSet(cutset.getData(), cutset.getLength(), set);
+
+		const char* str = toCStr();
+		const size_t begin = StringSearchFn::findFirstNotOf(str, getLength(), set);
+		if (begin == StringSearchFn::NOT_FOUND)
+		{
+			return StringView(str + getLength(), 0);
+		}
+		const size_t end = StringSearchFn::findLastNotOf(str, getLength(), set) + 1;
+		return StringView(str + begin, end - begin);
 	}
 
-	inline DynamicString DynamicString::trimSpace()
+	inline StringView DynamicString::trimSpaceView() const
 	{
-		return trim(" \t\n\v\f\r");
+		return trimView(" \t\n\v\f\r");
 	}
 
-	inline void DynamicString::split(const DynamicString& sep, Array<char*>& out)
+	inline void DynamicString::split(StringView sep, Array<char*>& out)
 	{
 		Allocator& a = *(out.allocator);
 
-		if (sep == "")
+		Array<StringView> parts(a);
+		split(sep, parts);
+
+		const size_t n = ArrayFn::getCount(parts);
+		ArrayFn::resize(out, n);
+
+		for (size_t i = 0; i < n; i++)
 		{
-			const size_t n = this->getLength();
+			out[i] = DynamicStringFn::copyToCString(parts[i].getData(), parts[i].getLength(), a);
+		}
+	}
 
-			ArrayFn::resize(out, n);
+	inline void DynamicString::split(StringView sep, Array<StringView>& out) const
+	{
+		const char* str = toCStr();
+		const size_t length = getLength();
+		const size_t sepLength = sep.getLength();
+
+		ArrayFn::clear(out);
 
-			for (size_t i = 0; i < n; i++)
+		// Every character is a substring
+		if (sepLength == 0)
+		{
+			ArrayFn::resize(out, length);
+			for (size_t i = 0; i < length; i++)
 			{
-				out[i] = DynamicStringFn::copyDynamicStringToCString((*this)[i], a);
+				out[i] = StringView(str + i, 1);
 			}
-
 			return;
 		}
 
-		const size_t n = getOccurencesCount(sep) + 1;
-		const char c = sep[0];
-
-		size_t start = 0;
-		size_t na = 0;
-		ArrayFn::resize(out, n);
-
-		const size_t lsep = sep.getLength();
-		const size_t ls = this->getLength();
-
-		for (size_t i = 0; i + lsep <= ls && na + 1 < n; i++)
+		size_t begin = 0;
+		while (true)
 		{
-			if ((*this)[i] == c && (lsep == 1 || substring(i, i + lsep) == sep))
+			const size_t found = StringSearchFn::find(str + begin, length - begin, sep.getData(), sepLength);
+			if (found == StringSearchFn::NOT_FOUND)
 			{
-				out[na] = DynamicStringFn::copyDynamicStringToCString(substring(start, i), a);
-				na++;
-				start = i + lsep;
-				i += lsep - 1;
+				ArrayFn::pushBack(out, StringView(str + begin, length - begin));
+				return;
 			}
+			ArrayFn::pushBack(out, StringView(str + begin, found));
+			begin += found + sepLength;
 		}
-
-		out[na] = DynamicStringFn::copyDynamicStringToCString(substring(start, ls), a);
-
-		ArrayFn::resize(out, na + 1);
 	}
 
 	// Cross-platform version of sprintf that uses a local persist buffer
@@ -56,6 +56,17 @@ namespace Rio
 			return strnCmp(data, b.data, len) < 0;
 		}
 
+		// The string is not NUL-terminated
+		const char* getData() const
+		{
+			return data;
+		}
+
+		uint32_t getLength() const
+		{
+			return length;
+		}
+
 	private:
 		uint32_t length = 0;
 		const char* data = nullptr;
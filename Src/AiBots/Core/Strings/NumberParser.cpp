@@ -0,0 +1,401 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/Strings/NumberParser.h"
+#include "Core/Strings/StringUtils.h"
+
+#include <cfloat> // FLT_EVAL_METHOD
+#include <cstdlib> // strtod_l, strtof_l
+#include <locale.h> // newlocale, _create_locale
+#if RIO_PLATFORM_OSX || RIO_PLATFORM_IOS
+#include <xlocale.h> // strtod_l, strtof_l
+#endif // RIO_PLATFORM_OSX || RIO_PLATFORM_IOS
+
+namespace Rio
+{
+	namespace NumberParserFn
+	{
+		namespace
+		{
+			// Decimal number split as mantissa * 10^exponent
+			struct DecimalNumber
+			{
+				// First character of the number, sign included
+				const char* begin;
+				// First character after the number
+				const char* end;
+				// At most maxMantissaDigits significant digits
+				uint64_t mantissa;
+				int32_t exponent;
+				bool isNegative;
+				// True if some non-zero digits did not fit into the mantissa
+				bool isTruncated;
+				// True if the number has neither fractional part nor exponent
+				bool isInteger;
+			};
+
+			// 10^19 is the largest power of ten that fits into uint64_t
+			const int32_t maxMantissaDigits = 19;
+			// Exponents beyond this limit overflow or underflow any floating-point type
+			const int32_t maxExponent = 100000;
+
+			const uint64_t maxDoubleMantissa = uint64_t(1) << 53;
+			const int32_t maxDoubleExponent = 22;
+			const uint64_t maxFloatMantissa = uint64_t(1) << 24;
+			const int32_t maxFloatExponent = 10;
+
+			// Powers of ten which are exactly representable as double
+			const double doublePowersOfTen[] =
+			{
+				1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+				1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+			};
+
+			// Powers of ten which are exactly representable as float
+			const float floatPowersOfTen[] =
+			{
+				1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+			};
+
+			const uint64_t integerPowersOfTen[] =
+			{
+				1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull,
+				100000000ull, 1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull,
+				10000000000000ull, 100000000000000ull, 1000000000000000ull
+			};
+
+			// The fast paths rely on every operation being rounded once to the
+			// target precision, which is not the case with x87 extended precision
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD != 0
+			const bool canUseFastPath = false;
+#else
+			const bool canUseFastPath = true;
+#endif // FLT_EVAL_METHOD
+
+#if RIO_PLATFORM_WINDOWS
+			typedef _locale_t CLocale;
+#else
+			typedef locale_t CLocale;
+#endif // RIO_PLATFORM_WINDOWS
+
+			// The slow paths must not follow LC_NUMERIC, which may use ',' as decimal separator.
+			// Created on first use and never freed.
+			CLocale getCLocale()
+			{
+#if RIO_PLATFORM_WINDOWS
+				static const CLocale cLocale = _create_locale(LC_ALL, "C");
+#else
+				static const CLocale cLocale = newlocale(LC_ALL_MASK, "C", (locale_t)0);
+#endif // RIO_PLATFORM_WINDOWS
+				return cLocale;
+			}
+
+			double strToDouble(const char* str, char** end)
+			{
+#if RIO_PLATFORM_WINDOWS
+				return _strtod_l(str, end, getCLocale());
+#else
+				return strtod_l(str, end, getCLocale());
+#endif // RIO_PLATFORM_WINDOWS
+			}
+
+			float strToFloat(const char* str, char** end)
+			{
+#if RIO_PLATFORM_WINDOWS
+				return _strtof_l(str, end, getCLocale());
+#else
+				return strtof_l(str, end, getCLocale());
+#endif // RIO_PLATFORM_WINDOWS
+			}
+
+			inline void appendDigit(DecimalNumber& number, int32_t& digitsCount, char c, bool isFraction)
+			{
+				if (digitsCount < maxMantissaDigits)
+				{
+					number.mantissa = number.mantissa * 10 + uint64_t(c - '0');
+					// Leading zeros are not significant
+					if (number.mantissa != 0)
+					{
+						++digitsCount;
+					}
+					if (isFraction)
+					{
+						--number.exponent;
+					}
+				}
+				else
+				{
+					if (c != '0')
+					{
+						number.isTruncated = true;
+					}
+					if (!isFraction)
+					{
+						++number.exponent;
+					}
+				}
+			}
+
+			// Splits the number at str into its decimal components in a single pass
+			bool scanDecimal(const char* str, DecimalNumber& number)
+			{
+				const char* ch = str;
+
+				number.begin = str;
+				number.end = str;
+				number.mantissa = 0;
+				number.exponent = 0;
+				number.isNegative = false;
+				number.isTruncated = false;
+				number.isInteger = true;
+
+				if (*ch == '-')
+				{
+					number.isNegative = true;
+					++ch;
+				}
+
+				int32_t digitsCount = 0;
+
+				const char* integerBegin = ch;
+				while (isDigit(*ch))
+				{
+					appendDigit(number, digitsCount, *ch, false);
+					++ch;
+				}
+				const bool hasIntegerDigits = ch != integerBegin;
+				bool hasFractionDigits = false;
+
+				if (*ch == '.' && (hasIntegerDigits || isDigit(ch[1])))
+				{
+					number.isInteger = false;
+					++ch;
+
+					const char* fractionBegin = ch;
+					while (isDigit(*ch))
+					{
+						appendDigit(number, digitsCount, *ch, true);
+						++ch;
+					}
+					hasFractionDigits = ch != fractionBegin;
+				}
+
+				if (!hasIntegerDigits && !hasFractionDigits)
+				{
+					return false;
+				}
+
+				if (*ch == 'e' || *ch == 'E')
+				{
+					const char* exponentBegin = ch + 1;
+					bool isExponentNegative = false;
+
+					if (*exponentBegin == '-' || *exponentBegin == '+')
+					{
+						isExponentNegative = *exponentBegin == '-';
+						++exponentBegin;
+					}
+
+					// An exponent without digits is not a part of the number
+					if (isDigit(*exponentBegin))
+					{
+						number.isInteger = false;
+						ch = exponentBegin;
+
+						int32_t exponent = 0;
+						while (isDigit(*ch))
+						{
+							if (exponent < maxExponent)
+							{
+								exponent = exponent * 10 + (*ch - '0');
+							}
+							++ch;
+						}
+
+						number.exponent += isExponentNegative ? -exponent : exponent;
+					}
+				}
+
+				number.end = ch;
+				return true;
+			}
+
+			// Returns true and sets value if the number can be converted exactly with a single operation
+			bool convertDoubleFast(const DecimalNumber& number, double& value)
+			{
+				if (number.isTruncated)
+				{
+					return false;
+				}
+
+				if (number.mantissa == 0)
+				{
+					value = 0.0;
+					return true;
+				}
+
+				if (!canUseFastPath || number.mantissa > maxDoubleMantissa)
+				{
+					return false;
+				}
+
+				if (number.exponent >= 0 && number.exponent <= maxDoubleExponent)
+				{
+					value = double(number.mantissa) * doublePowersOfTen[number.exponent];
+					return true;
+				}
+
+				if (number.exponent < 0 && number.exponent >= -maxDoubleExponent)
+				{
+					value = double(number.mantissa) / doublePowersOfTen[-number.exponent];
+					return true;
+				}
+
+				// Moves the exceeding powers of ten into the mantissa while it stays exact
+				// e.g. 12e30 == 12000000000e22
+				if (number.exponent > maxDoubleExponent && number.exponent - maxDoubleExponent <= 15)
+				{
+					const uint64_t power = integerPowersOfTen[number.exponent - maxDoubleExponent];
+					if (number.mantissa <= maxDoubleMantissa / power)
+					{
+						value = double(number.mantissa * power) * doublePowersOfTen[maxDoubleExponent];
+						return true;
+					}
+				}
+
+				return false;
+			}
+
+			bool convertFloatFast(const DecimalNumber& number, float& value)
+			{
+				if (number.isTruncated)
+				{
+					return false;
+				}
+
+				if (number.mantissa == 0)
+				{
+					value = 0.0f;
+					return true;
+				}
+
+				if (!canUseFastPath || number.mantissa > maxFloatMantissa)
+				{
+					return false;
+				}
+
+				if (number.exponent >= 0 && number.exponent <= maxFloatExponent)
+				{
+					value = float(number.mantissa) * floatPowersOfTen[number.exponent];
+					return true;
+				}
+
+				if (number.exponent < 0 && number.exponent >= -maxFloatExponent)
+				{
+					value = float(number.mantissa) / floatPowersOfTen[-number.exponent];
+					return true;
+				}
+
+				return false;
+			}
+		} // namespace (anonymous)
+
+		const char* parseDouble(const char* str, double& value)
+		{
+			RIO_ASSERT_NOT_NULL(str);
+
+			DecimalNumber number;
+			if (!scanDecimal(str, number))
+			{
+				return nullptr;
+			}
+
+			double result;
+			if (convertDoubleFast(number, result))
+			{
+				value = number.isNegative ? -result : result;
+				return number.end;
+			}
+
+			// Slow path, correctly rounded by the C library
+			char* end = nullptr;
+			value = strToDouble(number.begin, &end);
+			RIO_ASSERT(end == number.end, "strtod() disagrees on the number length: %s", str);
+			return number.end;
+		}
+
+		const char* parseFloat(const char* str, float& value)
+		{
+			RIO_ASSERT_NOT_NULL(str);
+
+			DecimalNumber number;
+			if (!scanDecimal(str, number))
+			{
+				return nullptr;
+			}
+
+			float result;
+			if (convertFloatFast(number, result))
+			{
+				value = number.isNegative ? -result : result;
+				return number.end;
+			}
+
+			// Slow path, correctly rounded by the C library.
+			// Rounding to double first and then to float would be incorrect in halfway cases
+			char* end = nullptr;
+			value = strToFloat(number.begin, &end);
+			RIO_ASSERT(end == number.end, "strtof() disagrees on the number length: %s", str);
+			return number.end;
+		}
+
+		const char* parseInt(const char* str, int32_t& value)
+		{
+			RIO_ASSERT_NOT_NULL(str);
+
+			DecimalNumber number;
+			if (!scanDecimal(str, number))
+			{
+				return nullptr;
+			}
+
+			if (!number.isInteger)
+			{
+				double result = 0.0;
+				parseDouble(str, result);
+				value = (int32_t)result;
+				return number.end;
+			}
+
+			const uint64_t limit = number.isNegative ? uint64_t(INT32_MAX) + 1 : uint64_t(INT32_MAX);
+			RIO_ASSERT(!number.isTruncated && number.exponent == 0 && number.mantissa <= limit, "Integer out of range: %s", str);
+			RIO_UNUSED(limit);
+
+			value = number.isNegative ? (int32_t)(0 - number.mantissa) : (int32_t)number.mantissa;
+			return number.end;
+		}
+
+		const char* parseUint(const char* str, uint32_t& value)
+		{
+			RIO_ASSERT_NOT_NULL(str);
+
+			DecimalNumber number;
+			if (!scanDecimal(str, number))
+			{
+				return nullptr;
+			}
+
+			if (!number.isInteger || number.isNegative)
+			{
+				double result = 0.0;
+				parseDouble(str, result);
+				value = (uint32_t)result;
+				return number.end;
+			}
+
+			RIO_ASSERT(!number.isTruncated && number.exponent == 0 && number.mantissa <= UINT32_MAX, "Integer out of range: %s", str);
+
+			value = (uint32_t)number.mantissa;
+			return number.end;
+		}
+	} // namespace NumberParserFn
+
+} // namespace Rio
@@ -0,0 +1,30 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#pragma once
+
+#include "Core/Base/Config.h"
+#include "Core/Base/Types.h"
+
+namespace Rio
+{
+	// Locale-independent parsing of decimal numbers
+	// Numbers follow the JSON grammar: [-]digits[.digits][(e|E)[+|-]digits]
+	// Every function parses the number at the beginning of str, stores it in value
+	// and returns a pointer to the first character after the number,
+	// or nullptr if str does not begin with a number (value is left untouched).
+	namespace NumberParserFn
+	{
+		// The result is correctly rounded.
+		// Mantissas up to 2^53 with decimal exponents up to 10^22 are converted exactly
+		// with a single floating-point operation, other numbers fall back to strtod() in the "C" locale.
+		const char* parseDouble(const char* str, double& value);
+		// The result is correctly rounded.
+		// Mantissas up to 2^24 with decimal exponents up to 10^10 are converted exactly
+		// with a single floating-point operation, other numbers fall back to strtof() in the "C" locale.
+		const char* parseFloat(const char* str, float& value);
+		// Numbers with a fractional part or an exponent are truncated towards zero.
+		const char* parseInt(const char* str, int32_t& value);
+		// Numbers with a fractional part or an exponent are truncated towards zero.
+		const char* parseUint(const char* str, uint32_t& value);
+	} // namespace NumberParserFn
+
+} // namespace Rio
@@ -198,6 +198,79 @@ namespace Rio
 				substring(begin(path), end(path), str, len);
 			}
 		}
+
+		bool isAbsolutePath(StringView path)
+		{
+#if RIO_PLATFORM_POSIX
+			return path.getLength() > 0 && path[0] == SEPARATOR;
+#elif RIO_PLATFORM_WINDOWS
+			return path.getLength() > 2 && isalpha(path[0]) && path[1] == ':' && path[2] == SEPARATOR;
+#endif
+		}
+
+		void joinPaths(StringView a, StringView b, DynamicString& path)
+		{
+			path.reserve(path.getLength() + a.getLength() + b.getLength() + 1);
+			path += a;
+			path += SEPARATOR;
+			path += b;
+		}
+
+		StringView getPathName(StringView path)
+		{
+			const size_t lastSeparator = path.findLastChar('/');
+
+			if (lastSeparator == StringView::NOT_FOUND)
+			{
+				return StringView();
+			}
+			// Keep the root separator
+			return path.getSubstring(0, lastSeparator == 0 ? 1 : lastSeparator);
+		}
+
+		StringView getFileName(StringView path)
+		{
+			const size_t lastSeparator = path.findLastChar('/');
+
+			if (lastSeparator == StringView::NOT_FOUND)
+			{
+				return path;
+			}
+			return path.getSubstring(lastSeparator + 1);
+		}
+
+		StringView getExtension(StringView path)
+		{
+			const StringView fileName = getFileName(path);
+			const size_t lastDot = fileName.findLastChar('.');
+
+			if (lastDot == StringView::NOT_FOUND)
+			{
+				return StringView();
+			}
+			return fileName.getSubstring(lastDot + 1);
+		}
+
+		StringView getFileNameWithoutExtension(StringView path)
+		{
+			const StringView extension = getExtension(path);
+
+			if (extension.getIsEmpty() && !path.endsWith("."))
+			{
+				return path;
+			}
+			// Remove the extension and the dot
+			return path.getSubstring(0, path.getLength() - extension.getLength() - 1);
+		}
+
+		StringView stripTrailingSeparator(StringView path)
+		{
+			if (path.endsWith("/"))
+			{
+				path.removeSuffix(1);
+			}
+			return path;
+		}
 	} // namespace PathFn
 
 } // namespace Rio
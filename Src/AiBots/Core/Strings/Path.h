@@ -5,6 +5,7 @@
 #include "Core/Base/Platform.h"
 
 #include "Core/Strings/DynamicString.h"
+#include "Core/Strings/StringView.h"
 
 namespace Rio
 {
@@ -78,6 +79,27 @@ namespace Rio
 		// "/home/project/shader.hlsl" -> "/home/project/shader.hlsl"
 		// The path must be valid.
 		void stripTrailingSeparator(const char* path, char* ret, size_t len);
+
+		// Same as above on views, the results point into path and nothing is copied.
+		// The path does not need to be NUL-terminated.
+		bool isAbsolutePath(StringView path);
+		void joinPaths(StringView a, StringView b, DynamicString& path);
+		// "/home/project/shader.hlsl" -> "/home/project"
+		// "/home" -> "/"
+		// "home" -> ""
+		StringView getPathName(StringView path);
+		// "/home/project/shader.hlsl" -> "shader.hlsl"
+		// "home" -> "home"
+		// "/" -> ""
+		StringView getFileName(StringView path);
+		// "/home/project/shader.hlsl" -> "hlsl"
+		// "/home/project.x/shader" -> ""
+		StringView getExtension(StringView path);
+		// "/home/project/shader.hlsl" -> "/home/project/shader"
+		// "/home/project.x/shader" -> "/home/project.x/shader"
+		StringView getFileNameWithoutExtension(StringView path);
+		// "/home/project/shader.hlsl/" -> "/home/project/shader.hlsl"
+		StringView stripTrailingSeparator(StringView path);
 	} // namespace PathFn
 
 } // namespace Rio
@@ -2,6 +2,8 @@
 #include "Core/Strings/StringId32.h"
 #include "Core/Base/Murmur.h"
 #include "Core/Strings/StringUtils.h"
+#include "Core/Strings/StringIdDebug.h"
+#include "Core/Strings/StringView.h"
 #include <inttypes.h> // PRIx64
 
 namespace Rio
@@ -10,11 +12,25 @@ namespace Rio
 	StringId32::StringId32(const char* str)
 		: id(murmur32(str, strLen32(str)))
 	{
+#if RIO_STRINGID_DEBUG
+		StringIdDebugFn::add(*this, str, strLen32(str));
+#endif // RIO_STRINGID_DEBUG
 	}
 
 	StringId32::StringId32(const char* str, uint32_t len)
 		: id(murmur32(str, len))
 	{
+#if RIO_STRINGID_DEBUG
+		StringIdDebugFn::add(*this, str, len);
+#endif // RIO_STRINGID_DEBUG
+	}
+
+	StringId32::StringId32(StringView str)
+		: id(murmur32(str.getData(), uint32_t(str.getLength())))
+	{
+#if RIO_STRINGID_DEBUG
+		StringIdDebugFn::add(*this, str.getData(), uint32_t(str.getLength()));
+#endif // RIO_STRINGID_DEBUG
 	}
 
 	const char* StringId32::toString(char* buf)
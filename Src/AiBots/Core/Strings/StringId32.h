@@ -3,22 +3,25 @@
 
 #include "Core/Base/Config.h"
 #include "Core/Base/Types.h"
+#include "Core/Base/Murmur.h"
 
 namespace Rio
 {
+	class StringView;
 
 	struct StringId32
 	{
 		uint32_t id;
 
-		StringId32() 
+		constexpr StringId32() 
 			: id(0) 
 		{}
-		explicit StringId32(uint32_t id)
+		constexpr explicit StringId32(uint32_t id)
 			: id(id)
 		{}
 		explicit StringId32(const char* str);
 		StringId32(const char* str, uint32_t len);
+		explicit StringId32(StringView str);
 		StringId32 operator=(StringId32 a)
 		{
 			id = a.id; return *this;
@@ -35,7 +38,7 @@ namespace Rio
 		{
 			return id < a.id;
 		}
-		uint32_t getId() const
+		constexpr uint32_t getId() const
 		{
 			return id;
 		}
@@ -44,4 +47,11 @@ namespace Rio
 		static const uint32_t STRING_LENGTH = 32;
 	};
 
+	// Hashes the string literal at compile time, the id is the same as StringId32(str)
+	// e.g. "position"_id32
+	constexpr StringId32 operator"" _id32(const char* str, size_t len)
+	{
+		return StringId32(murmur32Const(str, len));
+	}
+
 } //namespace Rio
\ No newline at end of file
@@ -2,6 +2,8 @@
 #include "Core/Strings/StringId64.h"
 #include "Core/Base/Murmur.h"
 #include "Core/Strings/StringUtils.h"
+#include "Core/Strings/StringIdDebug.h"
+#include "Core/Strings/StringView.h"
 #include <inttypes.h> // PRIx64
 
 namespace Rio
@@ -9,11 +11,25 @@ namespace Rio
 	StringId64::StringId64(const char* str)
 		: id(murmur64(str, strLen32(str)))
 	{
+#if RIO_STRINGID_DEBUG
+		StringIdDebugFn::add(*this, str, strLen32(str));
+#endif // RIO_STRINGID_DEBUG
 	}
 
 	StringId64::StringId64(const char* str, uint32_t len)
 		: id(murmur64(str, len))
 	{
+#if RIO_STRINGID_DEBUG
+		StringIdDebugFn::add(*this, str, len);
+#endif // RIO_STRINGID_DEBUG
+	}
+
+	StringId64::StringId64(StringView str)
+		: id(murmur64(str.getData(), uint32_t(str.getLength())))
+	{
+#if RIO_STRINGID_DEBUG
+		StringIdDebugFn::add(*this, str.getData(), uint32_t(str.getLength()));
+#endif // RIO_STRINGID_DEBUG
 	}
 
 	const char* StringId64::toString(char* buf)
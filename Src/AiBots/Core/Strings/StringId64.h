@@ -3,21 +3,24 @@
 
 #include "Core/Base/Config.h"
 #include "Core/Base/Types.h"
+#include "Core/Base/Murmur.h"
 
 namespace Rio
 {
+	class StringView;
 	struct StringId64
 	{
 		uint64_t id;
 
-		StringId64()
+		constexpr StringId64()
 			: id(0)
 		{}
-		explicit StringId64(uint64_t id)
+		constexpr explicit StringId64(uint64_t id)
 			: id(id)
 		{}
 		explicit StringId64(const char* str);
 		StringId64(const char* str, uint32_t len);
+		explicit StringId64(StringView str);
 		StringId64 operator=(StringId64 a)
 		{
 			id = a.id; return *this;
@@ -38,7 +41,7 @@ namespace Rio
 			return id < a.id;
 		}
 
-		uint64_t getId() const
+		constexpr uint64_t getId() const
 		{
 			return id;
 		}
@@ -47,5 +50,12 @@ namespace Rio
 		static const uint32_t STRING_LENGTH = 32;
 	};
 
+	// Hashes the string literal at compile time, the id is the same as StringId64(str)
+	// e.g. "position"_id64
+	constexpr StringId64 operator"" _id64(const char* str, size_t len)
+	{
+		return StringId64(murmur64Const(str, len));
+	}
+
 	using ResourceId = StringId64;
 } // namespace Rio
\ No newline at end of file
@@ -0,0 +1,105 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/Strings/StringIdDebug.h"
+
+#if RIO_STRINGID_DEBUG
+
+#include "Core/Memory/HeapAllocator.h"
+#include "Core/Containers/HashMap.h"
+#include "Core/Thread/ScopedMutex.h"
+
+#include <cstring> // memcpy
+
+namespace Rio
+{
+	namespace StringIdDebugFn
+	{
+		namespace
+		{
+			// Owns its allocator, string ids may be created before
+			// the memory globals are initialized or after they are shut down
+			struct StringIdTable
+			{
+				MemoryFn::HeapAllocator allocator;
+				Mutex mutex;
+				HashMap<const char*> strings32;
+				HashMap<const char*> strings64;
+
+				StringIdTable()
+					: strings32(allocator)
+					, strings64(allocator)
+				{
+				}
+
+				// The hash maps release their memory before the allocator is destroyed
+				~StringIdTable()
+				{
+					freeStrings(strings32);
+					freeStrings(strings64);
+				}
+
+				void freeStrings(HashMap<const char*>& strings)
+				{
+					const HashMap<const char*>::Entry* it = HashMapFn::begin(strings);
+					for (; it != HashMapFn::end(strings); ++it)
+					{
+						allocator.deallocate((void*)it->value);
+					}
+				}
+
+				void add(HashMap<const char*>& strings, uint64_t id, const char* str, uint32_t len)
+				{
+					ScopedMutex sm(mutex);
+
+					if (HashMapFn::has(strings, id))
+					{
+						return;
+					}
+
+					char* copy = (char*)allocator.allocate(len + 1, 1);
+					memcpy(copy, str, len);
+					copy[len] = '\0';
+					HashMapFn::set(strings, id, (const char*)copy);
+				}
+
+				const char* find(const HashMap<const char*>& strings, uint64_t id)
+				{
+					ScopedMutex sm(mutex);
+					return HashMapFn::get(strings, id, (const char*)nullptr);
+				}
+			};
+
+			StringIdTable& getTable()
+			{
+				static StringIdTable table;
+				return table;
+			}
+		} // namespace (anonymous)
+
+		void add(StringId32 id, const char* str, uint32_t len)
+		{
+			StringIdTable& table = getTable();
+			table.add(table.strings32, id.getId(), str, len);
+		}
+
+		void add(StringId64 id, const char* str, uint32_t len)
+		{
+			StringIdTable& table = getTable();
+			table.add(table.strings64, id.getId(), str, len);
+		}
+
+		const char* find(StringId32 id)
+		{
+			StringIdTable& table = getTable();
+			return table.find(table.strings32, id.getId());
+		}
+
+		const char* find(StringId64 id)
+		{
+			StringIdTable& table = getTable();
+			return table.find(table.strings64, id.getId());
+		}
+	} // namespace StringIdDebugFn
+
+} // namespace Rio
+
+#endif // RIO_STRINGID_DEBUG
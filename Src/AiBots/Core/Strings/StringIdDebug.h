@@ -0,0 +1,30 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#pragma once
+
+#include "Core/Base/Config.h"
+#include "Core/Base/Types.h"
+
+#include "Core/Strings/StringId32.h"
+#include "Core/Strings/StringId64.h"
+
+#if RIO_STRINGID_DEBUG
+
+namespace Rio
+{
+	// Reverse lookup of string ids for debugging and tooling, only when RIO_STRINGID_DEBUG is set.
+	// The table is created on first use and filled with every string hashed
+	// at runtime by StringId32 and StringId64. Ids computed at compile time
+	// with _id32 and _id64 are known once the same string has been added.
+	namespace StringIdDebugFn
+	{
+		void add(StringId32 id, const char* str, uint32_t len);
+		void add(StringId64 id, const char* str, uint32_t len);
+		// Returns the string hashed to id or nullptr if it is unknown.
+		// The string is valid until the end of the program.
+		const char* find(StringId32 id);
+		const char* find(StringId64 id);
+	} // namespace StringIdDebugFn
+
+} // namespace Rio
+
+#endif // RIO_STRINGID_DEBUG
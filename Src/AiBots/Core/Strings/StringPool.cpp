@@ -0,0 +1,383 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/Strings/StringPool.h"
+
+#include "Core/Memory/HeapAllocator.h"
+#include "Core/Thread/Atomic.h"
+#include "Core/Thread/ScopedMutex.h"
+
+#include <cstring> // memcpy, memcmp
+#include <new>
+
+namespace Rio
+{
+	namespace StringPoolFn
+	{
+		namespace
+		{
+			// handle = ((index in the shard + 1) << SHARD_BITS) | shard, 0 is the empty string
+			const uint32_t SHARD_BITS = 4;
+			const uint32_t SHARD_COUNT = 1 << SHARD_BITS;
+			// Block k of the entries holds FIRST_BLOCK_SIZE << k entries, the blocks never move
+			const uint32_t FIRST_BLOCK_SHIFT = 8;
+			const uint32_t BLOCK_COUNT = 32 - SHARD_BITS - FIRST_BLOCK_SHIFT;
+			const uint32_t INITIAL_TABLE_CAPACITY = 256;
+			// Strings are copied to chunks of this size, longer strings get their own chunk
+			const uint32_t CHUNK_SIZE = 64 * 1024;
+
+			struct Entry
+			{
+				const char* data;
+				uint32_t length;
+				uint32_t hash;
+			};
+
+			// Open addressing table with linear probing.
+			// A slot is 0 if empty or (hash << 32) | handle, written once.
+			struct Table
+			{
+				uint32_t capacity;
+				Atomic<uint64_t>* slots;
+				// Links the tables replaced by larger ones
+				Table* nextRetired;
+			};
+
+			struct Chunk
+			{
+				Chunk* next;
+			};
+
+			struct Shard
+			{
+				Mutex mutex;
+				Atomic<Table*> table;
+				Atomic<Entry*> blocks[BLOCK_COUNT];
+				uint32_t count;
+				// Tables replaced by larger ones, lookups may still be reading them
+				Table* retiredTables;
+				Chunk* chunks;
+				char* chunkPosition;
+				size_t chunkRemaining;
+				size_t stringBytes;
+			};
+
+			uint32_t getBlockIndex(uint32_t index, uint32_t& offset)
+			{
+				// Block k starts at FIRST_BLOCK_SIZE * (2^k - 1)
+				const uint32_t n = (index >> FIRST_BLOCK_SHIFT) + 1;
+				uint32_t block = 0;
+				while ((n >> (block + 1)) != 0)
+				{
+					++block;
+				}
+				offset = index - (((1u << block) - 1) << FIRST_BLOCK_SHIFT);
+				return block;
+			}
+
+			uint32_t getBlockSize(uint32_t block)
+			{
+				return (1u << FIRST_BLOCK_SHIFT) << block;
+			}
+
+			// Owns its allocator, strings may be interned before
+			// the memory globals are initialized or after they are shut down
+			struct StringPool
+			{
+				MemoryFn::HeapAllocator allocator;
+				Shard shards[SHARD_COUNT];
+
+				StringPool()
+				{
+					for (uint32_t i = 0; i < SHARD_COUNT; ++i)
+					{
+						Shard& shard = shards[i];
+						shard.table.store(createTable(INITIAL_TABLE_CAPACITY), MemoryOrder::RELAXED);
+						for (uint32_t b = 0; b < BLOCK_COUNT; ++b)
+						{
+							shard.blocks[b].store(nullptr, MemoryOrder::RELAXED);
+						}
+						shard.count = 0;
+						shard.retiredTables = nullptr;
+						shard.chunks = nullptr;
+						shard.chunkPosition = nullptr;
+						shard.chunkRemaining = 0;
+						shard.stringBytes = 0;
+					}
+				}
+
+				// Everything is released before the allocator is destroyed
+				~StringPool()
+				{
+					for (uint32_t i = 0; i < SHARD_COUNT; ++i)
+					{
+						Shard& shard = shards[i];
+						destroyTable(shard.table.load(MemoryOrder::RELAXED));
+						Table* table = shard.retiredTables;
+						while (table != nullptr)
+						{
+							Table* next = table->nextRetired;
+							destroyTable(table);
+							table = next;
+						}
+						for (uint32_t b = 0; b < BLOCK_COUNT; ++b)
+						{
+							allocator.deallocate(shard.blocks[b].load(MemoryOrder::RELAXED));
+						}
+						Chunk* chunk = shard.chunks;
+						while (chunk != nullptr)
+						{
+							Chunk* next = chunk->next;
+							allocator.deallocate(chunk);
+							chunk = next;
+						}
+					}
+				}
+
+				Table* createTable(uint32_t capacity)
+				{
+					Table* table = (Table*)allocator.allocate(sizeof(Table), RIO_ALIGNOF(Table));
+					table->capacity = capacity;
+					table->nextRetired = nullptr;
+					table->slots = (Atomic<uint64_t>*)allocator.allocate(capacity * sizeof(Atomic<uint64_t>), RIO_ALIGNOF(Atomic<uint64_t>));
+					for (uint32_t i = 0; i < capacity; ++i)
+					{
+						new (&table->slots[i]) Atomic<uint64_t>(0);
+					}
+					return table;
+				}
+
+				void destroyTable(Table* table)
+				{
+					allocator.deallocate(table->slots);
+					allocator.deallocate(table);
+				}
+
+				const Entry& getEntry(uint32_t handle) const
+				{
+					const Shard& shard = shards[handle & (SHARD_COUNT - 1)];
+					uint32_t offset;
+					const uint32_t block = getBlockIndex((handle >> SHARD_BITS) - 1, offset);
+					return shard.blocks[block].load(MemoryOrder::ACQUIRE)[offset];
+				}
+
+				// Lock-free, returns 0 if str is not in the shard
+				uint32_t find(const Shard& shard, const char* str, uint32_t length, uint32_t hash) const
+				{
+					const Table* table = shard.table.load(MemoryOrder::ACQUIRE);
+					const uint32_t mask = table->capacity - 1;
+					for (uint32_t i = hash & mask; ; i = (i + 1) & mask)
+					{
+						const uint64_t slot = table->slots[i].load(MemoryOrder::ACQUIRE);
+						if (slot == 0)
+						{
+							return 0;
+						}
+						if (uint32_t(slot >> 32) == hash)
+						{
+							const uint32_t handle = uint32_t(slot);
+							const Entry& entry = getEntry(handle);
+							if (entry.length == length && memcmp(entry.data, str, length) == 0)
+							{
+								return handle;
+							}
+						}
+					}
+				}
+
+				// Called with the shard locked
+				void insertSlot(Table* table, uint32_t hash, uint32_t handle)
+				{
+					const uint32_t mask = table->capacity - 1;
+					uint32_t i = hash & mask;
+					while (table->slots[i].load(MemoryOrder::RELAXED) != 0)
+					{
+						i = (i + 1) & mask;
+					}
+					table->slots[i].store((uint64_t(hash) << 32) | handle, MemoryOrder::RELEASE);
+				}
+
+				// Called with the shard locked, keeps the load factor under 1/2
+				void growTable(Shard& shard, uint32_t shardIndex)
+				{
+					Table* table = shard.table.load(MemoryOrder::RELAXED);
+					if ((shard.count + 1) * 2 <= table->capacity)
+					{
+						return;
+					}
+
+					Table* newTable = createTable(table->capacity * 2);
+					for (uint32_t i = 0; i < shard.count; ++i)
+					{
+						const uint32_t handle = ((i + 1) << SHARD_BITS) | shardIndex;
+						insertSlot(newTable, getEntry(handle).hash, handle);
+					}
+					shard.table.store(newTable, MemoryOrder::RELEASE);
+
+					// Lookups in progress may still probe the old table, it is kept until the pool is destroyed.
+					// Tables double in size so the retired ones take less memory than the current one.
+					table->nextRetired = shard.retiredTables;
+					shard.retiredTables = table;
+				}
+
+				const char* copyString(Shard& shard, const char* str, uint32_t length)
+				{
+					const size_t size = size_t(length) + 1;
+					char* copy;
+					if (size > CHUNK_SIZE / 4)
+					{
+						Chunk* chunk = (Chunk*)allocator.allocate(sizeof(Chunk) + size, RIO_ALIGNOF(Chunk));
+						chunk->next = shard.chunks;
+						shard.chunks = chunk;
+						copy = (char*)(chunk + 1);
+					}
+					else
+					{
+						if (size > shard.chunkRemaining)
+						{
+							Chunk* chunk = (Chunk*)allocator.allocate(sizeof(Chunk) + CHUNK_SIZE, RIO_ALIGNOF(Chunk));
+							chunk->next = shard.chunks;
+							shard.chunks = chunk;
+							shard.chunkPosition = (char*)(chunk + 1);
+							shard.chunkRemaining = CHUNK_SIZE;
+						}
+						copy = shard.chunkPosition;
+						shard.chunkPosition += size;
+						shard.chunkRemaining -= size;
+					}
+					memcpy(copy, str, length);
+					copy[length] = '\0';
+					shard.stringBytes += size;
+					return copy;
+				}
+
+				uint32_t intern(const char* str, uint32_t length, uint32_t hash)
+				{
+					const uint32_t shardIndex = hash >> (32 - SHARD_BITS);
+					Shard& shard = shards[shardIndex];
+
+					uint32_t handle = find(shard, str, length, hash);
+					if (handle != 0)
+					{
+						return handle;
+					}
+
+					ScopedMutex sm(shard.mutex);
+
+					// Another thread may have inserted it meanwhile
+					handle = find(shard, str, length, hash);
+					if (handle != 0)
+					{
+						return handle;
+					}
+
+					const uint32_t index = shard.count;
+					RIO_ASSERT(index + 1 < (1u << (32 - SHARD_BITS)), "Too many strings in the pool");
+
+					growTable(shard, shardIndex);
+
+					uint32_t offset;
+					const uint32_t block = getBlockIndex(index, offset);
+					Entry* entries = shard.blocks[block].load(MemoryOrder::RELAXED);
+					if (entries == nullptr)
+					{
+						entries = (Entry*)allocator.allocate(getBlockSize(block) * sizeof(Entry), RIO_ALIGNOF(Entry));
+						shard.blocks[block].store(entries, MemoryOrder::RELEASE);
+					}
+
+					Entry& entry = entries[offset];
+					entry.data = copyString(shard, str, length);
+					entry.length = length;
+					entry.hash = hash;
+					++shard.count;
+
+					// Publishes the entry to the lock-free lookups
+					handle = ((index + 1) << SHARD_BITS) | shardIndex;
+					insertSlot(shard.table.load(MemoryOrder::RELAXED), hash, handle);
+					return handle;
+				}
+			};
+
+			StringPool& getPool()
+			{
+				static StringPool pool;
+				return pool;
+			}
+		} // namespace (anonymous)
+
+		InternedString intern(StringView str)
+		{
+			if (str.getIsEmpty())
+			{
+				return InternedString();
+			}
+			const uint32_t length = uint32_t(str.getLength());
+			return InternedString(getPool().intern(str.getData(), length, str.getHash()));
+		}
+
+		InternedString find(StringView str)
+		{
+			if (str.getIsEmpty())
+			{
+				return InternedString();
+			}
+			StringPool& pool = getPool();
+			const uint32_t hash = str.getHash();
+			const Shard& shard = pool.shards[hash >> (32 - SHARD_BITS)];
+			return InternedString(pool.find(shard, str.getData(), uint32_t(str.getLength()), hash));
+		}
+
+		StringView getString(InternedString handle)
+		{
+			if (handle.getIsEmpty())
+			{
+				return StringView();
+			}
+			const Entry& entry = getPool().getEntry(handle.getHandle());
+			return StringView(entry.data, entry.length);
+		}
+
+		uint32_t getCount()
+		{
+			StringPool& pool = getPool();
+			uint32_t count = 0;
+			for (uint32_t i = 0; i < SHARD_COUNT; ++i)
+			{
+				ScopedMutex sm(pool.shards[i].mutex);
+				count += pool.shards[i].count;
+			}
+			return count;
+		}
+
+		size_t getStringBytes()
+		{
+			StringPool& pool = getPool();
+			size_t bytes = 0;
+			for (uint32_t i = 0; i < SHARD_COUNT; ++i)
+			{
+				ScopedMutex sm(pool.shards[i].mutex);
+				bytes += pool.shards[i].stringBytes;
+			}
+			return bytes;
+		}
+	} // namespace StringPoolFn
+
+	InternedString::InternedString(StringView str)
+		: handle(StringPoolFn::intern(str).handle)
+	{
+	}
+
+	StringView InternedString::toStringView() const
+	{
+		return StringPoolFn::getString(*this);
+	}
+
+	const char* InternedString::toCStr() const
+	{
+		// The empty StringView may have no data
+		if (getIsEmpty())
+		{
+			return "";
+		}
+		return StringPoolFn::getString(*this).getData();
+	}
+
+} // namespace Rio
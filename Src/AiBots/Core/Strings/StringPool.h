@@ -0,0 +1,89 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#pragma once
+
+#include "Core/Base/Config.h"
+#include "Core/Base/Types.h"
+
+#include "Core/Strings/StringView.h"
+
+namespace Rio
+{
+	class InternedString;
+
+	// Global pool of immutable strings.
+	// The strings are copied once to an arena and never freed, the pool is created on first use.
+	// The pool is split into shards by the hash of the string, every shard has its own lock
+	// taken only to insert new strings. Lookups of already interned strings and
+	// handle to string conversions do not lock.
+	namespace StringPoolFn
+	{
+		// Returns the handle of str, adds it to the pool if it is not there yet
+		InternedString intern(StringView str);
+		// Returns the handle of str, or the empty handle if str has not been interned
+		InternedString find(StringView str);
+		// Returns the string of handle. The characters are followed by '\0'.
+		StringView getString(InternedString handle);
+		// Returns the number of strings in the pool
+		uint32_t getCount();
+		// Returns the number of bytes used by the strings, terminators included
+		size_t getStringBytes();
+	} // namespace StringPoolFn
+
+	// Handle of a string stored once in the global string pool.
+	// Equal strings have equal handles, comparing two handles is a single integer comparison.
+	// The default handle is the empty string.
+	class InternedString
+	{
+	public:
+		InternedString()
+			: handle(0)
+		{
+		}
+
+		// Interns str, same as StringPoolFn::intern()
+		explicit InternedString(StringView str);
+
+		uint32_t getHandle() const
+		{
+			return handle;
+		}
+
+		bool getIsEmpty() const
+		{
+			return handle == 0;
+		}
+
+		// The string is valid until the end of the program
+		StringView toStringView() const;
+		// '\0'-terminated, "" for the empty handle
+		const char* toCStr() const;
+
+		bool operator==(InternedString other) const
+		{
+			return handle == other.handle;
+		}
+
+		bool operator!=(InternedString other) const
+		{
+			return handle != other.handle;
+		}
+
+		// Orders by handle, not alphabetically
+		bool operator<(InternedString other) const
+		{
+			return handle < other.handle;
+		}
+
+	private:
+		explicit InternedString(uint32_t handle)
+			: handle(handle)
+		{
+		}
+
+		uint32_t handle;
+
+		friend InternedString StringPoolFn::intern(StringView str);
+		friend InternedString StringPoolFn::find(StringView str);
+	};
+
+} // namespace Rio
@@ -0,0 +1,470 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/Strings/StringSearch.h"
+
+#include <cstring> // memchr, memcmp
+
+#if RIO_SIMD_AVX2
+	#include <immintrin.h>
+#elif RIO_SIMD_SSSE3
+	#include <tmmintrin.h>
+#elif RIO_SIMD_SSE2
+	#include <emmintrin.h>
+#endif
+
+#if RIO_COMPILER_MSVC
+	#include <intrin.h> // _BitScanForward, _BitScanReverse
+#endif
+
+namespace Rio
+{
+	namespace StringSearchFn
+	{
+		namespace
+		{
+			inline uint32_t getLowestBitIndex(uint32_t mask)
+			{
+#if RIO_COMPILER_MSVC
+				unsigned long index;
+				_BitScanForward(&index, mask);
+				return uint32_t(index);
+#else
+				return uint32_t(__builtin_ctz(mask));
+#endif
+			}
+
+			inline uint32_t getHighestBitIndex(uint32_t mask)
+			{
+#if RIO_COMPILER_MSVC
+				unsigned long index;
+				_BitScanReverse(&index, mask);
+				return uint32_t(index);
+#else
+				return uint32_t(31 - __builtin_clz(mask));
+#endif
+			}
+
+			inline uint32_t getBitsCount(uint32_t mask)
+			{
+				uint32_t count = 0;
+				for (; mask != 0; mask &= mask - 1)
+				{
+					++count;
+				}
+				return count;
+			}
+
+			inline bool isInSetScalar(const CharSet& set, uint8_t c)
+			{
+				const uint8_t high = c >> 4;
+				const uint8_t bits = high < 8 ? set.lowNibbleBits[c & 0x0F] : set.lowNibbleBitsHigh[c & 0x0F];
+				return (bits & (1 << (high & 7))) != 0;
+			}
+
+#if RIO_SIMD_AVX2
+			// 32 characters at a time
+			struct SimdBlock
+			{
+				typedef __m256i Type;
+				static const size_t SIZE = 32;
+
+				static Type load(const char* str) { return _mm256_loadu_si256((const __m256i*)str); }
+				static void store(char* str, Type a) { _mm256_storeu_si256((__m256i*)str, a); }
+				static Type set(char c) { return _mm256_set1_epi8(c); }
+				static Type loadTable(const uint8_t* table) { return _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)table)); }
+				static Type compare(Type a, Type b) { return _mm256_cmpeq_epi8(a, b); }
+				static Type isGreater(Type a, Type b) { return _mm256_cmpgt_epi8(a, b); }
+				static Type add(Type a, Type b) { return _mm256_add_epi8(a, b); }
+				static Type bitAnd(Type a, Type b) { return _mm256_and_si256(a, b); }
+				static Type bitAndNot(Type a, Type b) { return _mm256_andnot_si256(a, b); }
+				static Type bitOr(Type a, Type b) { return _mm256_or_si256(a, b); }
+				static Type bitXor(Type a, Type b) { return _mm256_xor_si256(a, b); }
+				static Type shiftRight4(Type a) { return _mm256_srli_epi16(a, 4); }
+				static Type shuffle(Type table, Type indices) { return _mm256_shuffle_epi8(table, indices); }
+				static uint32_t getMask(Type a) { return uint32_t(_mm256_movemask_epi8(a)); }
+			};
+	#define RIO_STRING_SEARCH_SIMD 1
+	#define RIO_STRING_SEARCH_SHUFFLE 1
+#elif RIO_SIMD_SSE2
+			// 16 characters at a time
+			struct SimdBlock
+			{
+				typedef __m128i Type;
+				static const size_t SIZE = 16;
+
+				static Type load(const char* str) { return _mm_loadu_si128((const __m128i*)str); }
+				static void store(char* str, Type a) { _mm_storeu_si128((__m128i*)str, a); }
+				static Type set(char c) { return _mm_set1_epi8(c); }
+				static Type loadTable(const uint8_t* table) { return _mm_loadu_si128((const __m128i*)table); }
+				static Type compare(Type a, Type b) { return _mm_cmpeq_epi8(a, b); }
+				static Type isGreater(Type a, Type b) { return _mm_cmpgt_epi8(a, b); }
+				static Type add(Type a, Type b) { return _mm_add_epi8(a, b); }
+				static Type bitAnd(Type a, Type b) { return _mm_and_si128(a, b); }
+				static Type bitAndNot(Type a, Type b) { return _mm_andnot_si128(a, b); }
+				static Type bitOr(Type a, Type b) { return _mm_or_si128(a, b); }
+				static Type bitXor(Type a, Type b) { return _mm_xor_si128(a, b); }
+				static Type shiftRight4(Type a) { return _mm_srli_epi16(a, 4); }
+	#if RIO_SIMD_SSSE3
+				static Type shuffle(Type table, Type indices) { return _mm_shuffle_epi8(table, indices); }
+	#endif // RIO_SIMD_SSSE3
+				static uint32_t getMask(Type a) { return uint32_t(_mm_movemask_epi8(a)); }
+			};
+	#define RIO_STRING_SEARCH_SIMD 1
+	#define RIO_STRING_SEARCH_SHUFFLE RIO_SIMD_SSSE3
+#else
+	#define RIO_STRING_SEARCH_SIMD 0
+	#define RIO_STRING_SEARCH_SHUFFLE 0
+#endif // RIO_SIMD_AVX2
+
+#if RIO_STRING_SEARCH_SIMD
+			// One bit per character of a block
+			const uint32_t simdBlockMask = uint32_t((uint64_t(1) << SimdBlock::SIZE) - 1);
+
+			// Bit i is set if str[i] == c
+			inline uint32_t getCharMask(const char* str, SimdBlock::Type c)
+			{
+				return SimdBlock::getMask(SimdBlock::compare(SimdBlock::load(str), c));
+			}
+
+			// Bit i is set if str[i] and str[i + subLength - 1] match the first and the last character of sub
+			inline uint32_t getCandidatesMask(const char* str, size_t subLength, SimdBlock::Type first, SimdBlock::Type last)
+			{
+				const SimdBlock::Type firstMatches = SimdBlock::compare(SimdBlock::load(str), first);
+				const SimdBlock::Type lastMatches = SimdBlock::compare(SimdBlock::load(str + subLength - 1), last);
+				return SimdBlock::getMask(SimdBlock::bitAnd(firstMatches, lastMatches));
+			}
+#endif // RIO_STRING_SEARCH_SIMD
+
+#if RIO_STRING_SEARCH_SHUFFLE
+			// Nibble lookup: two shuffles classify the characters of a whole block
+			struct CharSetTables
+			{
+				SimdBlock::Type lowNibbleBits;
+				SimdBlock::Type lowNibbleBitsHigh;
+				SimdBlock::Type highNibbleBits;
+				SimdBlock::Type nibbleMask;
+				SimdBlock::Type seven;
+
+				explicit CharSetTables(const CharSet& set)
+				{
+					static const uint8_t highNibbleBitsTable[16] =
+					{
+						1, 2, 4, 8, 16, 32, 64, 128,
+						1, 2, 4, 8, 16, 32, 64, 128
+					};
+					lowNibbleBits = SimdBlock::loadTable(set.lowNibbleBits);
+					lowNibbleBitsHigh = SimdBlock::loadTable(set.lowNibbleBitsHigh);
+					highNibbleBits = SimdBlock::loadTable(highNibbleBitsTable);
+					nibbleMask = SimdBlock::set(0x0F);
+					seven = SimdBlock::set(7);
+				}
+
+				// Bit i is set if str[i] is in the set
+				uint32_t getInSetMask(const char* str) const
+				{
+					const SimdBlock::Type block = SimdBlock::load(str);
+					const SimdBlock::Type low = SimdBlock::bitAnd(block, nibbleMask);
+					const SimdBlock::Type high = SimdBlock::bitAnd(SimdBlock::shiftRight4(block), nibbleMask);
+					const SimdBlock::Type isHigh = SimdBlock::isGreater(high, seven);
+					const SimdBlock::Type bits = SimdBlock::bitOr(
+						SimdBlock::bitAndNot(isHigh, SimdBlock::shuffle(lowNibbleBits, low)),
+						SimdBlock::bitAnd(isHigh, SimdBlock::shuffle(lowNibbleBitsHigh, low)));
+					const SimdBlock::Type isOut = SimdBlock::compare(SimdBlock::bitAnd(bits, SimdBlock::shuffle(highNibbleBits, high)), SimdBlock::set(0));
+					return ~SimdBlock::getMask(isOut) & simdBlockMask;
+				}
+			};
+#endif // RIO_STRING_SEARCH_SHUFFLE
+
+			// Shared implementation of the four set searches
+			// isInSetWanted selects findFirstOf/findLastOf or findFirstNotOf/findLastNotOf
+			size_t findInSet(const char* str, size_t length, const CharSet& set, bool isInSetWanted, bool isReverse)
+			{
+				size_t begin = 0;
+				size_t end = length;
+#if RIO_STRING_SEARCH_SHUFFLE
+				const CharSetTables tables(set);
+				const uint32_t wantedMask = isInSetWanted ? 0 : simdBlockMask;
+				if (!isReverse)
+				{
+					for (; begin + SimdBlock::SIZE <= length; begin += SimdBlock::SIZE)
+					{
+						const uint32_t mask = tables.getInSetMask(str + begin) ^ wantedMask;
+						if (mask != 0)
+						{
+							return begin + getLowestBitIndex(mask);
+						}
+					}
+				}
+				else
+				{
+					for (; end >= SimdBlock::SIZE; end -= SimdBlock::SIZE)
+					{
+						const uint32_t mask = tables.getInSetMask(str + end - SimdBlock::SIZE) ^ wantedMask;
+						if (mask != 0)
+						{
+							return end - SimdBlock::SIZE + getHighestBitIndex(mask);
+						}
+					}
+				}
+#endif // RIO_STRING_SEARCH_SHUFFLE
+				if (!isReverse)
+				{
+					for (size_t i = begin; i < end; ++i)
+					{
+						if (isInSetScalar(set, uint8_t(str[i])) == isInSetWanted)
+						{
+							return i;
+						}
+					}
+				}
+				else
+				{
+					for (size_t i = end; i > begin; --i)
+					{
+						if (isInSetScalar(set, uint8_t(str[i - 1])) == isInSetWanted)
+						{
+							return i - 1;
+						}
+					}
+				}
+				return NOT_FOUND;
+			}
+
+			// Converts the characters in [first, first + 25] by flipping bit 5
+			void convertCase(char* str, size_t length, char first)
+			{
+				size_t i = 0;
+#if RIO_STRING_SEARCH_SIMD
+				// Moves [first, first + 25] to [-128, -103] so that a single signed comparison finds it
+				const SimdBlock::Type offset = SimdBlock::set(char(-128 - first));
+				const SimdBlock::Type limit = SimdBlock::set(char(-128 + 26));
+				const SimdBlock::Type caseBit = SimdBlock::set(0x20);
+				for (; i + SimdBlock::SIZE <= length; i += SimdBlock::SIZE)
+				{
+					const SimdBlock::Type block = SimdBlock::load(str + i);
+					const SimdBlock::Type isLetter = SimdBlock::isGreater(limit, SimdBlock::add(block, offset));
+					SimdBlock::store(str + i, SimdBlock::bitXor(block, SimdBlock::bitAnd(isLetter, caseBit)));
+				}
+#endif // RIO_STRING_SEARCH_SIMD
+				for (; i < length; ++i)
+				{
+					if (str[i] >= first && str[i] <= first + 25)
+					{
+						str[i] ^= 0x20;
+					}
+				}
+			}
+		} // namespace (anonymous)
+
+		size_t findChar(const char* str, size_t length, char c)
+		{
+			const void* found = memchr(str, c, length);
+			return found != nullptr ? size_t((const char*)found - str) : NOT_FOUND;
+		}
+
+		size_t findLastChar(const char* str, size_t length, char c)
+		{
+			size_t end = length;
+#if RIO_STRING_SEARCH_SIMD
+			const SimdBlock::Type needle = SimdBlock::set(c);
+			for (; end >= SimdBlock::SIZE; end -= SimdBlock::SIZE)
+			{
+				const uint32_t mask = getCharMask(str + end - SimdBlock::SIZE, needle);
+				if (mask != 0)
+				{
+					return end - SimdBlock::SIZE + getHighestBitIndex(mask);
+				}
+			}
+#endif // RIO_STRING_SEARCH_SIMD
+			for (; end > 0; --end)
+			{
+				if (str[end - 1] == c)
+				{
+					return end - 1;
+				}
+			}
+			return NOT_FOUND;
+		}
+
+		size_t countChar(const char* str, size_t length, char c)
+		{
+			size_t result = 0;
+			size_t i = 0;
+#if RIO_STRING_SEARCH_SIMD
+			const SimdBlock::Type needle = SimdBlock::set(c);
+			for (; i + SimdBlock::SIZE <= length; i += SimdBlock::SIZE)
+			{
+				result += getBitsCount(getCharMask(str + i, needle));
+			}
+#endif // RIO_STRING_SEARCH_SIMD
+			for (; i < length; ++i)
+			{
+				if (str[i] == c)
+				{
+					++result;
+				}
+			}
+			return result;
+		}
+
+		size_t find(const char* str, size_t length, const char* sub, size_t subLength)
+		{
+			if (subLength == 0)
+			{
+				return 0;
+			}
+			if (subLength > length)
+			{
+				return NOT_FOUND;
+			}
+			if (subLength == 1)
+			{
+				return findChar(str, length, sub[0]);
+			}
+
+			// Number of positions where sub may begin
+			const size_t positionsCount = length - subLength + 1;
+			size_t i = 0;
+#if RIO_STRING_SEARCH_SIMD
+			const SimdBlock::Type first = SimdBlock::set(sub[0]);
+			const SimdBlock::Type last = SimdBlock::set(sub[subLength - 1]);
+			for (; i + SimdBlock::SIZE <= positionsCount; i += SimdBlock::SIZE)
+			{
+				for (uint32_t mask = getCandidatesMask(str + i, subLength, first, last); mask != 0; mask &= mask - 1)
+				{
+					const size_t position = i + getLowestBitIndex(mask);
+					if (memcmp(str + position + 1, sub + 1, subLength - 2) == 0)
+					{
+						return position;
+					}
+				}
+			}
+#endif // RIO_STRING_SEARCH_SIMD
+			for (; i < positionsCount; ++i)
+			{
+				if (str[i] == sub[0] && str[i + subLength - 1] == sub[subLength - 1] && memcmp(str + i + 1, sub + 1, subLength - 2) == 0)
+				{
+					return i;
+				}
+			}
+			return NOT_FOUND;
+		}
+
+		size_t findLast(const char* str, size_t length, const char* sub, size_t subLength)
+		{
+			if (subLength == 0)
+			{
+				return length;
+			}
+			if (subLength > length)
+			{
+				return NOT_FOUND;
+			}
+			if (subLength == 1)
+			{
+				return findLastChar(str, length, sub[0]);
+			}
+
+			size_t positionsCount = length - subLength + 1;
+#if RIO_STRING_SEARCH_SIMD
+			const SimdBlock::Type first = SimdBlock::set(sub[0]);
+			const SimdBlock::Type last = SimdBlock::set(sub[subLength - 1]);
+			for (; positionsCount >= SimdBlock::SIZE; positionsCount -= SimdBlock::SIZE)
+			{
+				const size_t begin = positionsCount - SimdBlock::SIZE;
+				uint32_t mask = getCandidatesMask(str + begin, subLength, first, last);
+				while (mask != 0)
+				{
+					const uint32_t bit = getHighestBitIndex(mask);
+					if (memcmp(str + begin + bit + 1, sub + 1, subLength - 2) == 0)
+					{
+						return begin + bit;
+					}
+					mask &= ~(uint32_t(1) << bit);
+				}
+			}
+#endif // RIO_STRING_SEARCH_SIMD
+			for (; positionsCount > 0; --positionsCount)
+			{
+				const size_t i = positionsCount - 1;
+				if (str[i] == sub[0] && str[i + subLength - 1] == sub[subLength - 1] && memcmp(str + i + 1, sub + 1, subLength - 2) == 0)
+				{
+					return i;
+				}
+			}
+			return NOT_FOUND;
+		}
+
+		size_t count(const char* str, size_t length, const char* sub, size_t subLength)
+		{
+			if (subLength == 0)
+			{
+				return length + 1;
+			}
+			if (subLength == 1)
+			{
+				return countChar(str, length, sub[0]);
+			}
+
+			size_t result = 0;
+			size_t begin = 0;
+			while (true)
+			{
+				const size_t found = find(str + begin, length - begin, sub, subLength);
+				if (found == NOT_FOUND)
+				{
+					return result;
+				}
+				++result;
+				begin += found + subLength;
+			}
+		}
+
+		void makeCharSet(const char* chars, size_t length, CharSet& set)
+		{
+			memset(&set, 0, sizeof(CharSet));
+			for (size_t i = 0; i < length; ++i)
+			{
+				const uint8_t c = uint8_t(chars[i]);
+				const uint8_t high = c >> 4;
+				uint8_t* bits = high < 8 ? set.lowNibbleBits : set.lowNibbleBitsHigh;
+				bits[c & 0x0F] |= uint8_t(1 << (high & 7));
+			}
+		}
+
+		bool isInSet(const CharSet& set, char c)
+		{
+			return isInSetScalar(set, uint8_t(c));
+		}
+
+		size_t findFirstOf(const char* str, size_t length, const CharSet& set)
+		{
+			return findInSet(str, length, set, true, false);
+		}
+
+		size_t findLastOf(const char* str, size_t length, const CharSet& set)
+		{
+			return findInSet(str, length, set, true, true);
+		}
+
+		size_t findFirstNotOf(const char* str, size_t length, const CharSet& set)
+		{
+			return findInSet(str, length, set, false, false);
+		}
+
+		size_t findLastNotOf(const char* str, size_t length, const CharSet& set)
+		{
+			return findInSet(str, length, set, false, true);
+		}
+
+		void toLower(char* str, size_t length)
+		{
+			convertCase(str, length, 'A');
+		}
+
+		void toUpper(char* str, size_t length)
+		{
+			convertCase(str, length, 'a');
+		}
+	} // namespace StringSearchFn
+
+} // namespace Rio
@@ -0,0 +1,55 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#pragma once
+
+#include "Core/Base/Config.h"
+#include "Core/Base/Types.h"
+
+namespace Rio
+{
+	// Set of characters for StringSearchFn::findFirstOf() and similar
+	struct CharSet
+	{
+		// Bit h of lowNibbleBits[l] is set if the character (h << 4) | l is in the set,
+		// for the high nibbles h = 0..7
+		uint8_t lowNibbleBits[16];
+		// Same as above for the high nibbles h = 8..15
+		uint8_t lowNibbleBitsHigh[16];
+	};
+
+	// Search and case conversion on character ranges, the strings do not need to be NUL-terminated.
+	// Uses SSE2, SSSE3 or AVX2 when they are enabled at compile time (see RIO_SIMD_* in Platform.h)
+	// and scalar code otherwise, the results are identical.
+	namespace StringSearchFn
+	{
+		// Returned by the find functions when nothing is found
+		const size_t NOT_FOUND = size_t(-1);
+
+		// Returns the index of the first/last character c or NOT_FOUND
+		size_t findChar(const char* str, size_t length, char c);
+		size_t findLastChar(const char* str, size_t length, char c);
+		size_t countChar(const char* str, size_t length, char c);
+
+		// Returns the index of the first/last occurrence of sub or NOT_FOUND.
+		// An empty sub is found at 0 (find) or at length (findLast).
+		// Candidates are filtered by the first and the last character of sub
+		// 16 or 32 positions at a time, then compared in full.
+		size_t find(const char* str, size_t length, const char* sub, size_t subLength);
+		size_t findLast(const char* str, size_t length, const char* sub, size_t subLength);
+		// Returns the number of non-overlapping occurrences of sub.
+		// An empty sub occurs length + 1 times.
+		size_t count(const char* str, size_t length, const char* sub, size_t subLength);
+
+		void makeCharSet(const char* chars, size_t length, CharSet& set);
+		bool isInSet(const CharSet& set, char c);
+		// Returns the index of the first/last character which is (not) in set or NOT_FOUND
+		size_t findFirstOf(const char* str, size_t length, const CharSet& set);
+		size_t findLastOf(const char* str, size_t length, const CharSet& set);
+		size_t findFirstNotOf(const char* str, size_t length, const CharSet& set);
+		size_t findLastNotOf(const char* str, size_t length, const CharSet& set);
+
+		// In-place ASCII case conversion, other characters are left untouched
+		void toLower(char* str, size_t length);
+		void toUpper(char* str, size_t length);
+	} // namespace StringSearchFn
+
+} // namespace Rio
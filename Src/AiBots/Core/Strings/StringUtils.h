@@ -89,13 +89,32 @@ namespace Rio
 		return str;
 	}
 
+	// Returns the pointer past the block delimited by a and b, str must point to a.
+	// Delimiters inside double-quoted strings are ignored.
 	inline const char* skipBlock(const char* str, char a, char b)
 	{
 		uint32_t num = 0;
 
-		for (char ch = *str++; *str != '\0'; ch = *str++)
+		for (char ch = *str++; ch != '\0'; ch = *str++)
 		{
-			if (ch == a) ++num;
+			if (ch == '"')
+			{
+				for (ch = *str++; ch != '"'; ch = *str++)
+				{
+					if (ch == '\0')
+					{
+						return nullptr;
+					}
+					if (ch == '\\' && *str != '\0')
+					{
+						++str;
+					}
+				}
+			}
+			else if (ch == a)
+			{
+				++num;
+			}
 			else if (ch == b)
 			{
 				if (--num == 0)
@@ -0,0 +1,212 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#pragma once
+
+#include "Core/Base/Config.h"
+#include "Core/Base/Types.h"
+#include "Core/Base/Murmur.h"
+
+#include "Core/Debug/Error.h"
+#include "Core/Strings/StringUtils.h"
+#include "Core/Strings/StringSearch.h"
+#include "Core/Strings/FixedString.h"
+#include "Core/Strings/StringId32.h"
+#include "Core/Strings/StringId64.h"
+
+#include <cstring> // memcmp
+
+namespace Rio
+{
+	// Non-owning view of a range of characters, not necessarily NUL-terminated.
+	// The viewed string must outlive the view.
+	// Cheap to copy, pass it by value.
+	class StringView
+	{
+	public:
+		static const size_t NOT_FOUND = StringSearchFn::NOT_FOUND;
+
+		StringView()
+			: data("")
+			, length(0)
+		{
+		}
+
+		StringView(const char* str)
+			: data(str)
+			, length(strLen(str))
+		{
+			RIO_ASSERT_NOT_NULL(str);
+		}
+
+		StringView(const char* str, size_t length)
+			: data(str)
+			, length(length)
+		{
+			RIO_ASSERT(str != nullptr || length == 0, "String is NULL");
+		}
+
+		StringView(const FixedString& str)
+			: data(str.getData())
+			, length(str.getLength())
+		{
+		}
+
+		const char* getData() const
+		{
+			return data;
+		}
+
+		size_t getLength() const
+		{
+			return length;
+		}
+
+		bool getIsEmpty() const
+		{
+			return length == 0;
+		}
+
+		char operator[](size_t index) const
+		{
+			RIO_ASSERT(index < length, "Index out of bounds");
+			return data[index];
+		}
+
+		const char* begin() const
+		{
+			return data;
+		}
+
+		const char* end() const
+		{
+			return data + length;
+		}
+
+		// Returns at most count characters starting at index
+		StringView getSubstring(size_t index, size_t count = NOT_FOUND) const
+		{
+			RIO_ASSERT(index <= length, "Index out of bounds");
+			const size_t available = length - index;
+			return StringView(data + index, count < available ? count : available);
+		}
+
+		void removePrefix(size_t count)
+		{
+			RIO_ASSERT(count <= length, "Count out of bounds");
+			data += count;
+			length -= count;
+		}
+
+		void removeSuffix(size_t count)
+		{
+			RIO_ASSERT(count <= length, "Count out of bounds");
+			length -= count;
+		}
+
+		// Returns < 0, 0 or > 0 like strcmp()
+		int32_t compare(StringView other) const
+		{
+			const size_t commonLength = length < other.length ? length : other.length;
+			const int32_t result = commonLength > 0 ? memcmp(data, other.data, commonLength) : 0;
+			if (result != 0)
+			{
+				return result;
+			}
+			return length < other.length ? -1 : (length > other.length ? 1 : 0);
+		}
+
+		bool operator==(StringView other) const
+		{
+			return length == other.length && (length == 0 || memcmp(data, other.data, length) == 0);
+		}
+
+		bool operator!=(StringView other) const
+		{
+			return !(*this == other);
+		}
+
+		bool operator<(StringView other) const
+		{
+			return compare(other) < 0;
+		}
+
+		bool startsWith(StringView prefix) const
+		{
+			return length >= prefix.length && getSubstring(0, prefix.length) == prefix;
+		}
+
+		bool endsWith(StringView suffix) const
+		{
+			return length >= suffix.length && getSubstring(length - suffix.length) == suffix;
+		}
+
+		// The find functions return the index or NOT_FOUND
+		size_t find(StringView sub) const
+		{
+			return StringSearchFn::find(data, length, sub.data, sub.length);
+		}
+
+		size_t findLast(StringView sub) const
+		{
+			return StringSearchFn::findLast(data, length, sub.data, sub.length);
+		}
+
+		size_t findChar(char c) const
+		{
+			return StringSearchFn::findChar(data, length, c);
+		}
+
+		size_t findLastChar(char c) const
+		{
+			return StringSearchFn::findLastChar(data, length, c);
+		}
+
+		size_t findFirstOf(StringView chars) const
+		{
+			CharSet set;
+			StringSearchFn::makeCharSet(chars.data, chars.length, set);
+			return StringSearchFn::findFirstOf(data, length, set);
+		}
+
+		size_t findLastOf(StringView chars) const
+		{
+			CharSet set;
+			StringSearchFn::makeCharSet(chars.data, chars.length, set);
+			return StringSearchFn::findLastOf(data, length, set);
+		}
+
+		bool contains(StringView sub) const
+		{
+			return find(sub) != NOT_FOUND;
+		}
+
+		// Same as murmur32() of the characters
+		uint32_t getHash() const
+		{
+			return murmur32(data, length);
+		}
+
+		StringId32 toStringId32() const
+		{
+			return StringId32(*this);
+		}
+
+		StringId64 toStringId64() const
+		{
+			return StringId64(*this);
+		}
+
+		// Copies at most size - 1 characters to str and appends '\0'
+		void copyTo(char* str, size_t size) const
+		{
+			RIO_ASSERT(size > 0, "Size must be > 0");
+			const size_t count = length < size - 1 ? length : size - 1;
+			memcpy(str, data, count);
+			str[count] = '\0';
+		}
+
+	private:
+		const char* data;
+		size_t length;
+	};
+
+} // namespace Rio
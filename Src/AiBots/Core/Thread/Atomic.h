@@ -0,0 +1,541 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#pragma once
+
+#include "Core/Base/Config.h"
+#include "Core/Base/Types.h"
+#include "Core/Base/Platform.h"
+
+#if RIO_COMPILER_MSVC
+	#include "Core/Os/Windows/Headers_Windows.h"
+	#include <intrin.h>
+#endif // RIO_COMPILER_MSVC
+
+namespace Rio
+{
+	// Same meaning as std::memory_order
+	struct MemoryOrder
+	{
+		enum Enum
+		{
+			RELAXED,
+			ACQUIRE,
+			RELEASE,
+			ACQUIRE_RELEASE,
+			SEQUENTIALLY_CONSISTENT
+		};
+	};
+
+	// Atomic operations on 32-bit and 64-bit integers and pointers.
+	// The pointers may point to memory shared with other processes or the kernel.
+	namespace AtomicFn
+	{
+		template <typename T> T load(const volatile T* ptr, MemoryOrder::Enum order = MemoryOrder::SEQUENTIALLY_CONSISTENT);
+		template <typename T> void store(volatile T* ptr, T value, MemoryOrder::Enum order = MemoryOrder::SEQUENTIALLY_CONSISTENT);
+		// Returns the previous value
+		template <typename T> T exchange(volatile T* ptr, T value, MemoryOrder::Enum order = MemoryOrder::SEQUENTIALLY_CONSISTENT);
+		// Stores desired if *ptr == expected and returns true, otherwise copies *ptr to expected and returns false.
+		// The weak version may fail spuriously and is cheaper in a loop on LL/SC architectures.
+		template <typename T> bool compareExchangeWeak(volatile T* ptr, T& expected, T desired, MemoryOrder::Enum success, MemoryOrder::Enum failure);
+		template <typename T> bool compareExchangeStrong(volatile T* ptr, T& expected, T desired, MemoryOrder::Enum success, MemoryOrder::Enum failure);
+		// Integers only, return the previous value
+		template <typename T> T fetchAdd(volatile T* ptr, T value, MemoryOrder::Enum order = MemoryOrder::SEQUENTIALLY_CONSISTENT);
+		template <typename T> T fetchSub(volatile T* ptr, T value, MemoryOrder::Enum order = MemoryOrder::SEQUENTIALLY_CONSISTENT);
+		template <typename T> T fetchAnd(volatile T* ptr, T value, MemoryOrder::Enum order = MemoryOrder::SEQUENTIALLY_CONSISTENT);
+		template <typename T> T fetchOr(volatile T* ptr, T value, MemoryOrder::Enum order = MemoryOrder::SEQUENTIALLY_CONSISTENT);
+		template <typename T> T fetchXor(volatile T* ptr, T value, MemoryOrder::Enum order = MemoryOrder::SEQUENTIALLY_CONSISTENT);
+		// Orders the memory accesses around it between threads
+		void threadFence(MemoryOrder::Enum order = MemoryOrder::SEQUENTIALLY_CONSISTENT);
+		// Orders the memory accesses around it for the compiler only, e.g. with a signal handler on the same thread
+		void signalFence(MemoryOrder::Enum order = MemoryOrder::SEQUENTIALLY_CONSISTENT);
+		// Returns the strongest order allowed for the failure of a compare exchange with the given success order
+		MemoryOrder::Enum getFailureOrder(MemoryOrder::Enum success);
+		// Hints the CPU that the thread is spinning, e.g. to give the core to its hyper-thread
+		void pause();
+	} // namespace AtomicFn
+
+	template <typename T>
+	class Atomic
+	{
+	public:
+		Atomic()
+			: value(0)
+		{
+		}
+
+		explicit Atomic(T value)
+			: value(value)
+		{
+		}
+
+		T load(MemoryOrder::Enum order = MemoryOrder::SEQUENTIALLY_CONSISTENT) const
+		{
+			return AtomicFn::load(&value, order);
+		}
+
+		void store(T value, MemoryOrder::Enum order = MemoryOrder::SEQUENTIALLY_CONSISTENT)
+		{
+			AtomicFn::store(&this->value, value, order);
+		}
+
+		T exchange(T value, MemoryOrder::Enum order = MemoryOrder::SEQUENTIALLY_CONSISTENT)
+		{
+			return AtomicFn::exchange(&this->value, value, order);
+		}
+
+		bool compareExchangeWeak(T& expected, T desired, MemoryOrder::Enum success, MemoryOrder::Enum failure)
+		{
+			return AtomicFn::compareExchangeWeak(&value, expected, desired, success, failure);
+		}
+
+		bool compareExchangeWeak(T& expected, T desired, MemoryOrder::Enum order = MemoryOrder::SEQUENTIALLY_CONSISTENT)
+		{
+			return AtomicFn::compareExchangeWeak(&value, expected, desired, order, AtomicFn::getFailureOrder(order));
+		}
+
+		bool compareExchangeStrong(T& expected, T desired, MemoryOrder::Enum success, MemoryOrder::Enum failure)
+		{
+			return AtomicFn::compareExchangeStrong(&value, expected, desired, success, failure);
+		}
+
+		bool compareExchangeStrong(T& expected, T desired, MemoryOrder::Enum order = MemoryOrder::SEQUENTIALLY_CONSISTENT)
+		{
+			return AtomicFn::compareExchangeStrong(&value, expected, desired, order, AtomicFn::getFailureOrder(order));
+		}
+
+		T fetchAdd(T value, MemoryOrder::Enum order = MemoryOrder::SEQUENTIALLY_CONSISTENT)
+		{
+			return AtomicFn::fetchAdd(&this->value, value, order);
+		}
+
+		T fetchSub(T value, MemoryOrder::Enum order = MemoryOrder::SEQUENTIALLY_CONSISTENT)
+		{
+			return AtomicFn::fetchSub(&this->value, value, order);
+		}
+
+		T fetchAnd(T value, MemoryOrder::Enum order = MemoryOrder::SEQUENTIALLY_CONSISTENT)
+		{
+			return AtomicFn::fetchAnd(&this->value, value, order);
+		}
+
+		T fetchOr(T value, MemoryOrder::Enum order = MemoryOrder::SEQUENTIALLY_CONSISTENT)
+		{
+			return AtomicFn::fetchOr(&this->value, value, order);
+		}
+
+		T fetchXor(T value, MemoryOrder::Enum order = MemoryOrder::SEQUENTIALLY_CONSISTENT)
+		{
+			return AtomicFn::fetchXor(&this->value, value, order);
+		}
+
+	private:
+		static_assert(sizeof(T) == 4 || sizeof(T) == 8, "Only 32-bit and 64-bit atomics are supported");
+
+		// 64-bit values are not naturally aligned on every 32-bit platform
+		alignas(sizeof(T)) volatile T value;
+	private:
+		// Disable copying
+		Atomic(const Atomic&);
+		Atomic& operator=(const Atomic&);
+	};
+
+	template <typename T>
+	class Atomic<T*>
+	{
+	public:
+		Atomic()
+			: value(nullptr)
+		{
+		}
+
+		explicit Atomic(T* value)
+			: value(value)
+		{
+		}
+
+		T* load(MemoryOrder::Enum order = MemoryOrder::SEQUENTIALLY_CONSISTENT) const
+		{
+			return AtomicFn::load(&value, order);
+		}
+
+		void store(T* value, MemoryOrder::Enum order = MemoryOrder::SEQUENTIALLY_CONSISTENT)
+		{
+			AtomicFn::store(&this->value, value, order);
+		}
+
+		T* exchange(T* value, MemoryOrder::Enum order = MemoryOrder::SEQUENTIALLY_CONSISTENT)
+		{
+			return AtomicFn::exchange(&this->value, value, order);
+		}
+
+		bool compareExchangeWeak(T*& expected, T* desired, MemoryOrder::Enum success, MemoryOrder::Enum failure)
+		{
+			return AtomicFn::compareExchangeWeak(&value, expected, desired, success, failure);
+		}
+
+		bool compareExchangeWeak(T*& expected, T* desired, MemoryOrder::Enum order = MemoryOrder::SEQUENTIALLY_CONSISTENT)
+		{
+			return AtomicFn::compareExchangeWeak(&value, expected, desired, order, AtomicFn::getFailureOrder(order));
+		}
+
+		bool compareExchangeStrong(T*& expected, T* desired, MemoryOrder::Enum success, MemoryOrder::Enum failure)
+		{
+			return AtomicFn::compareExchangeStrong(&value, expected, desired, success, failure);
+		}
+
+		bool compareExchangeStrong(T*& expected, T* desired, MemoryOrder::Enum order = MemoryOrder::SEQUENTIALLY_CONSISTENT)
+		{
+			return AtomicFn::compareExchangeStrong(&value, expected, desired, order, AtomicFn::getFailureOrder(order));
+		}
+
+		// Moves the pointer by count elements, returns the previous value
+		T* fetchAdd(ptrdiff_t count, MemoryOrder::Enum order = MemoryOrder::SEQUENTIALLY_CONSISTENT)
+		{
+			return (T*)AtomicFn::fetchAdd((volatile uintptr_t*)&value, uintptr_t(count * ptrdiff_t(sizeof(T))), order);
+		}
+
+		T* fetchSub(ptrdiff_t count, MemoryOrder::Enum order = MemoryOrder::SEQUENTIALLY_CONSISTENT)
+		{
+			return (T*)AtomicFn::fetchSub((volatile uintptr_t*)&value, uintptr_t(count * ptrdiff_t(sizeof(T))), order);
+		}
+
+	private:
+		T* volatile value;
+	private:
+		// Disable copying
+		Atomic(const Atomic&);
+		Atomic& operator=(const Atomic&);
+	};
+
+	// Atomic alone on its cache line, for the counters written by different threads
+	template <typename T>
+	class alignas(RIO_CACHE_LINE_SIZE) PaddedAtomic : public Atomic<T>
+	{
+	public:
+		PaddedAtomic()
+		{
+		}
+
+		explicit PaddedAtomic(T value)
+			: Atomic<T>(value)
+		{
+		}
+
+	private:
+		char padding[RIO_CACHE_LINE_SIZE - sizeof(Atomic<T>)];
+	};
+
+	namespace AtomicFn
+	{
+		inline MemoryOrder::Enum getFailureOrder(MemoryOrder::Enum success)
+		{
+			switch (success)
+			{
+				case MemoryOrder::RELEASE: return MemoryOrder::RELAXED;
+				case MemoryOrder::ACQUIRE_RELEASE: return MemoryOrder::ACQUIRE;
+				default: return success;
+			}
+		}
+
+		inline void pause()
+		{
+#if RIO_COMPILER_MSVC
+			YieldProcessor();
+#elif RIO_CPU_X86
+			__builtin_ia32_pause();
+#elif RIO_CPU_ARM
+			__asm__ __volatile__("yield");
+#endif // RIO_COMPILER_MSVC
+		}
+
+#if RIO_COMPILER_GCC || RIO_COMPILER_CLANG
+		inline int toBuiltinOrder(MemoryOrder::Enum order)
+		{
+			switch (order)
+			{
+				case MemoryOrder::RELAXED: return __ATOMIC_RELAXED;
+				case MemoryOrder::ACQUIRE: return __ATOMIC_ACQUIRE;
+				case MemoryOrder::RELEASE: return __ATOMIC_RELEASE;
+				case MemoryOrder::ACQUIRE_RELEASE: return __ATOMIC_ACQ_REL;
+				default: return __ATOMIC_SEQ_CST;
+			}
+		}
+
+		template <typename T>
+		inline T load(const volatile T* ptr, MemoryOrder::Enum order)
+		{
+			return __atomic_load_n(ptr, toBuiltinOrder(order));
+		}
+
+		template <typename T>
+		inline void store(volatile T* ptr, T value, MemoryOrder::Enum order)
+		{
+			__atomic_store_n(ptr, value, toBuiltinOrder(order));
+		}
+
+		template <typename T>
+		inline T exchange(volatile T* ptr, T value, MemoryOrder::Enum order)
+		{
+			return __atomic_exchange_n(ptr, value, toBuiltinOrder(order));
+		}
+
+		template <typename T>
+		inline bool compareExchangeWeak(volatile T* ptr, T& expected, T desired, MemoryOrder::Enum success, MemoryOrder::Enum failure)
+		{
+			return __atomic_compare_exchange_n(ptr, &expected, desired, true, toBuiltinOrder(success), toBuiltinOrder(failure));
+		}
+
+		template <typename T>
+		inline bool compareExchangeStrong(volatile T* ptr, T& expected, T desired, MemoryOrder::Enum success, MemoryOrder::Enum failure)
+		{
+			return __atomic_compare_exchange_n(ptr, &expected, desired, false, toBuiltinOrder(success), toBuiltinOrder(failure));
+		}
+
+		template <typename T>
+		inline T fetchAdd(volatile T* ptr, T value, MemoryOrder::Enum order)
+		{
+			return __atomic_fetch_add(ptr, value, toBuiltinOrder(order));
+		}
+
+		template <typename T>
+		inline T fetchSub(volatile T* ptr, T value, MemoryOrder::Enum order)
+		{
+			return __atomic_fetch_sub(ptr, value, toBuiltinOrder(order));
+		}
+
+		template <typename T>
+		inline T fetchAnd(volatile T* ptr, T value, MemoryOrder::Enum order)
+		{
+			return __atomic_fetch_and(ptr, value, toBuiltinOrder(order));
+		}
+
+		template <typename T>
+		inline T fetchOr(volatile T* ptr, T value, MemoryOrder::Enum order)
+		{
+			return __atomic_fetch_or(ptr, value, toBuiltinOrder(order));
+		}
+
+		template <typename T>
+		inline T fetchXor(volatile T* ptr, T value, MemoryOrder::Enum order)
+		{
+			return __atomic_fetch_xor(ptr, value, toBuiltinOrder(order));
+		}
+
+		inline void threadFence(MemoryOrder::Enum order)
+		{
+			__atomic_thread_fence(toBuiltinOrder(order));
+		}
+
+		inline void signalFence(MemoryOrder::Enum order)
+		{
+			__atomic_signal_fence(toBuiltinOrder(order));
+		}
+#elif RIO_COMPILER_MSVC
+		// The Interlocked functions are full barriers, stronger than any order.
+		// Plain loads and stores of aligned values are atomic, on x86 and x64 a load
+		// is an acquire and a store a release, only the compiler must not reorder them.
+		template <size_t SIZE>
+		struct Interlocked;
+
+		template <>
+		struct Interlocked<4>
+		{
+			typedef LONG Type;
+
+			static Type load(const volatile Type* ptr)
+			{
+				return *ptr;
+			}
+
+			static Type exchange(volatile Type* ptr, Type value)
+			{
+				return InterlockedExchange(ptr, value);
+			}
+
+			static Type compareExchange(volatile Type* ptr, Type value, Type comparand)
+			{
+				return InterlockedCompareExchange(ptr, value, comparand);
+			}
+
+			static Type fetchAdd(volatile Type* ptr, Type value)
+			{
+				return InterlockedExchangeAdd(ptr, value);
+			}
+
+			static Type fetchAnd(volatile Type* ptr, Type value)
+			{
+				return InterlockedAnd(ptr, value);
+			}
+
+			static Type fetchOr(volatile Type* ptr, Type value)
+			{
+				return InterlockedOr(ptr, value);
+			}
+
+			static Type fetchXor(volatile Type* ptr, Type value)
+			{
+				return InterlockedXor(ptr, value);
+			}
+		};
+
+		template <>
+		struct Interlocked<8>
+		{
+			typedef LONGLONG Type;
+
+			static Type load(const volatile Type* ptr)
+			{
+#if RIO_ARCH_64BIT
+				return *ptr;
+#else
+				// Two loads on 32-bit x86
+				return InterlockedCompareExchange64((volatile Type*)ptr, 0, 0);
+#endif // RIO_ARCH_64BIT
+			}
+
+			static Type exchange(volatile Type* ptr, Type value)
+			{
+				return InterlockedExchange64(ptr, value);
+			}
+
+			static Type compareExchange(volatile Type* ptr, Type value, Type comparand)
+			{
+				return InterlockedCompareExchange64(ptr, value, comparand);
+			}
+
+			static Type fetchAdd(volatile Type* ptr, Type value)
+			{
+				return InterlockedExchangeAdd64(ptr, value);
+			}
+
+			static Type fetchAnd(volatile Type* ptr, Type value)
+			{
+				return InterlockedAnd64(ptr, value);
+			}
+
+			static Type fetchOr(volatile Type* ptr, Type value)
+			{
+				return InterlockedOr64(ptr, value);
+			}
+
+			static Type fetchXor(volatile Type* ptr, Type value)
+			{
+				return InterlockedXor64(ptr, value);
+			}
+		};
+
+		template <typename T>
+		inline T load(const volatile T* ptr, MemoryOrder::Enum order)
+		{
+			typedef Interlocked<sizeof(T)> Ops;
+			RIO_UNUSED(order);
+			const T value = (T)Ops::load((const volatile typename Ops::Type*)ptr);
+			_ReadWriteBarrier();
+			return value;
+		}
+
+		template <typename T>
+		inline void store(volatile T* ptr, T value, MemoryOrder::Enum order)
+		{
+			typedef Interlocked<sizeof(T)> Ops;
+			if (order == MemoryOrder::SEQUENTIALLY_CONSISTENT || sizeof(T) > sizeof(void*))
+			{
+				// A plain store may pass a later load, and 64-bit stores are two stores on 32-bit x86
+				Ops::exchange((volatile typename Ops::Type*)ptr, (typename Ops::Type)value);
+				return;
+			}
+			_ReadWriteBarrier();
+			*ptr = value;
+		}
+
+		template <typename T>
+		inline T exchange(volatile T* ptr, T value, MemoryOrder::Enum order)
+		{
+			typedef Interlocked<sizeof(T)> Ops;
+			RIO_UNUSED(order);
+			return (T)Ops::exchange((volatile typename Ops::Type*)ptr, (typename Ops::Type)value);
+		}
+
+		template <typename T>
+		inline bool compareExchangeStrong(volatile T* ptr, T& expected, T desired, MemoryOrder::Enum success, MemoryOrder::Enum failure)
+		{
+			typedef Interlocked<sizeof(T)> Ops;
+			RIO_UNUSED(success);
+			RIO_UNUSED(failure);
+			const typename Ops::Type comparand = (typename Ops::Type)expected;
+			const typename Ops::Type previous = Ops::compareExchange((volatile typename Ops::Type*)ptr, (typename Ops::Type)desired, comparand);
+			if (previous == comparand)
+			{
+				return true;
+			}
+			expected = (T)previous;
+			return false;
+		}
+
+		template <typename T>
+		inline bool compareExchangeWeak(volatile T* ptr, T& expected, T desired, MemoryOrder::Enum success, MemoryOrder::Enum failure)
+		{
+			// cmpxchg never fails spuriously
+			return compareExchangeStrong(ptr, expected, desired, success, failure);
+		}
+
+		template <typename T>
+		inline T fetchAdd(volatile T* ptr, T value, MemoryOrder::Enum order)
+		{
+			typedef Interlocked<sizeof(T)> Ops;
+			RIO_UNUSED(order);
+			return (T)Ops::fetchAdd((volatile typename Ops::Type*)ptr, (typename Ops::Type)value);
+		}
+
+		template <typename T>
+		inline T fetchSub(volatile T* ptr, T value, MemoryOrder::Enum order)
+		{
+			typedef Interlocked<sizeof(T)> Ops;
+			RIO_UNUSED(order);
+			return (T)Ops::fetchAdd((volatile typename Ops::Type*)ptr, -(typename Ops::Type)value);
+		}
+
+		template <typename T>
+		inline T fetchAnd(volatile T* ptr, T value, MemoryOrder::Enum order)
+		{
+			typedef Interlocked<sizeof(T)> Ops;
+			RIO_UNUSED(order);
+			return (T)Ops::fetchAnd((volatile typename Ops::Type*)ptr, (typename Ops::Type)value);
+		}
+
+		template <typename T>
+		inline T fetchOr(volatile T* ptr, T value, MemoryOrder::Enum order)
+		{
+			typedef Interlocked<sizeof(T)> Ops;
+			RIO_UNUSED(order);
+			return (T)Ops::fetchOr((volatile typename Ops::Type*)ptr, (typename Ops::Type)value);
+		}
+
+		template <typename T>
+		inline T fetchXor(volatile T* ptr, T value, MemoryOrder::Enum order)
+		{
+			typedef Interlocked<sizeof(T)> Ops;
+			RIO_UNUSED(order);
+			return (T)Ops::fetchXor((volatile typename Ops::Type*)ptr, (typename Ops::Type)value);
+		}
+
+		inline void threadFence(MemoryOrder::Enum order)
+		{
+			if (order == MemoryOrder::SEQUENTIALLY_CONSISTENT)
+			{
+				MemoryBarrier();
+			}
+			else
+			{
+				_ReadWriteBarrier();
+			}
+		}
+
+		inline void signalFence(MemoryOrder::Enum order)
+		{
+			RIO_UNUSED(order);
+			_ReadWriteBarrier();
+		}
+#endif // RIO_COMPILER_GCC || RIO_COMPILER_CLANG
+	} // namespace AtomicFn
+
+} // namespace Rio
@@ -0,0 +1,154 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/Thread/CpuTopology.h"
+#include "Core/Debug/Error.h"
+
+#include <string.h> // memset
+
+namespace Rio
+{
+
+namespace CpuSetFn
+{
+	void clear(CpuSet& cpus)
+	{
+		memset(cpus.bits, 0, sizeof(cpus.bits));
+	}
+
+	void add(CpuSet& cpus, uint32_t cpu)
+	{
+		RIO_ASSERT(cpu < CpuSet::MAX_CPUS, "Index out of bounds");
+		cpus.bits[cpu / 64] |= uint64_t(1) << (cpu % 64);
+	}
+
+	void remove(CpuSet& cpus, uint32_t cpu)
+	{
+		RIO_ASSERT(cpu < CpuSet::MAX_CPUS, "Index out of bounds");
+		cpus.bits[cpu / 64] &= ~(uint64_t(1) << (cpu % 64));
+	}
+
+	bool has(const CpuSet& cpus, uint32_t cpu)
+	{
+		return cpu < CpuSet::MAX_CPUS && (cpus.bits[cpu / 64] & (uint64_t(1) << (cpu % 64))) != 0;
+	}
+
+	uint32_t getCount(const CpuSet& cpus)
+	{
+		uint32_t count = 0;
+		for (uint32_t i = 0; i < CpuSet::MAX_CPUS / 64; ++i)
+		{
+			// Clears the lowest bit until none is left
+			for (uint64_t bits = cpus.bits[i]; bits != 0; bits &= bits - 1)
+			{
+				++count;
+			}
+		}
+		return count;
+	}
+
+	bool getIsEmpty(const CpuSet& cpus)
+	{
+		return getFirst(cpus) == CpuSet::MAX_CPUS;
+	}
+
+	uint32_t getFirst(const CpuSet& cpus)
+	{
+		for (uint32_t i = 0; i < CpuSet::MAX_CPUS / 64; ++i)
+		{
+			if (cpus.bits[i] != 0)
+			{
+				uint32_t bit = 0;
+				while ((cpus.bits[i] & (uint64_t(1) << bit)) == 0)
+				{
+					++bit;
+				}
+				return i * 64 + bit;
+			}
+		}
+		return CpuSet::MAX_CPUS;
+	}
+} // namespace CpuSetFn
+
+namespace CpuTopologyFn
+{
+	const CpuTopology& get()
+	{
+		// Initialized once even if several threads get here first
+		struct Query
+		{
+			CpuTopology topology;
+			Query()
+			{
+				query(topology);
+			}
+		};
+		static Query result;
+		return result.topology;
+	}
+
+	void getNumaNodeCpus(const CpuTopology& topology, uint32_t numaNode, CpuSet& cpus)
+	{
+		CpuSetFn::clear(cpus);
+		for (uint32_t i = 0; i < CpuSet::MAX_CPUS; ++i)
+		{
+			if (CpuSetFn::has(topology.onlineCpus, i) && topology.cpus[i].numaNode == numaNode)
+			{
+				CpuSetFn::add(cpus, i);
+			}
+		}
+	}
+
+	void getPackageCpus(const CpuTopology& topology, uint32_t package, CpuSet& cpus)
+	{
+		CpuSetFn::clear(cpus);
+		for (uint32_t i = 0; i < CpuSet::MAX_CPUS; ++i)
+		{
+			if (CpuSetFn::has(topology.onlineCpus, i) && topology.cpus[i].package == package)
+			{
+				CpuSetFn::add(cpus, i);
+			}
+		}
+	}
+
+	void getCoreCpus(const CpuTopology& topology, uint32_t core, CpuSet& cpus)
+	{
+		CpuSetFn::clear(cpus);
+		for (uint32_t i = 0; i < CpuSet::MAX_CPUS; ++i)
+		{
+			if (CpuSetFn::has(topology.onlineCpus, i) && topology.cpus[i].core == core)
+			{
+				CpuSetFn::add(cpus, i);
+			}
+		}
+	}
+
+	void getPhysicalCpus(const CpuTopology& topology, CpuSet& cpus)
+	{
+		CpuSetFn::clear(cpus);
+		for (uint32_t i = 0; i < CpuSet::MAX_CPUS; ++i)
+		{
+			if (CpuSetFn::has(topology.onlineCpus, i) && topology.cpus[i].smtIndex == 0)
+			{
+				CpuSetFn::add(cpus, i);
+			}
+		}
+	}
+
+	uint32_t getCacheSize(const CpuTopology& topology, uint32_t cpu, uint32_t level)
+	{
+		uint32_t size = 0;
+		for (uint32_t i = 0; i < topology.cachesCount; ++i)
+		{
+			const CpuCache& cache = topology.caches[i];
+			if (cache.level == level
+				&& cache.type != CpuCacheType::INSTRUCTION
+				&& CpuSetFn::has(cache.cpus, cpu)
+				&& cache.size > size)
+			{
+				size = cache.size;
+			}
+		}
+		return size;
+	}
+} // namespace CpuTopologyFn
+
+} // namespace Rio
@@ -0,0 +1,98 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#pragma once
+
+#include "Core/Base/Config.h"
+#include "Core/Base/Types.h"
+
+namespace Rio
+{
+	// Set of logical processors, indexed like the OS does.
+	// On Windows the index is the processor group * 64 + the number of the processor in the group.
+	struct CpuSet
+	{
+		static const uint32_t MAX_CPUS = 256;
+		uint64_t bits[MAX_CPUS / 64];
+	};
+
+	namespace CpuSetFn
+	{
+		void clear(CpuSet& cpus);
+		void add(CpuSet& cpus, uint32_t cpu);
+		void remove(CpuSet& cpus, uint32_t cpu);
+		bool has(const CpuSet& cpus, uint32_t cpu);
+		uint32_t getCount(const CpuSet& cpus);
+		bool getIsEmpty(const CpuSet& cpus);
+		// Returns the lowest cpu in the set, CpuSet::MAX_CPUS if it is empty
+		uint32_t getFirst(const CpuSet& cpus);
+	} // namespace CpuSetFn
+
+	struct CpuCacheType
+	{
+		enum Enum
+		{
+			DATA,
+			INSTRUCTION,
+			UNIFIED
+		};
+	};
+
+	// Logical processor
+	struct Cpu
+	{
+		// Indices into the cores, packages and NUMA nodes of the CpuTopology
+		uint16_t core;
+		uint16_t package;
+		uint16_t numaNode;
+		// 0 for the first hardware thread of the core, 1 for its SMT sibling, etc.
+		uint16_t smtIndex;
+	};
+
+	// One instance of a cache, shared by the cpus of the set
+	struct CpuCache
+	{
+		uint32_t level;
+		CpuCacheType::Enum type;
+		// In bytes
+		uint32_t size;
+		uint32_t lineSize;
+		CpuSet cpus;
+	};
+
+	// Layout of the logical processors online when it was queried.
+	// Cores, packages and NUMA nodes are numbered from 0 in the order they are first seen,
+	// these are not the ids of the OS.
+	struct CpuTopology
+	{
+		static const uint32_t MAX_CACHES = 256;
+
+		// Indexed by logical processor, only the ones in onlineCpus are valid
+		Cpu cpus[CpuSet::MAX_CPUS];
+		CpuSet onlineCpus;
+		uint32_t cpusCount;
+		uint32_t coresCount;
+		uint32_t packagesCount;
+		uint32_t numaNodesCount;
+		CpuCache caches[MAX_CACHES];
+		uint32_t cachesCount;
+	};
+
+	namespace CpuTopologyFn
+	{
+		// Returns the topology of the machine, queried from the OS on the first call
+		const CpuTopology& get();
+		// Implemented per platform, see Posix/CpuTopology_Posix.cpp and Windows/CpuTopology_Windows.cpp.
+		// Falls back to one core per logical processor in a single package and NUMA node
+		// when the OS does not tell.
+		void query(CpuTopology& topology);
+
+		void getNumaNodeCpus(const CpuTopology& topology, uint32_t numaNode, CpuSet& cpus);
+		void getPackageCpus(const CpuTopology& topology, uint32_t package, CpuSet& cpus);
+		// Returns the hardware threads of the core
+		void getCoreCpus(const CpuTopology& topology, uint32_t core, CpuSet& cpus);
+		// Returns the first hardware thread of each core, threads pinned to those do not share a core
+		void getPhysicalCpus(const CpuTopology& topology, CpuSet& cpus);
+		// Returns the size of the largest data or unified cache of the level seen by the cpu, 0 if there is none
+		uint32_t getCacheSize(const CpuTopology& topology, uint32_t cpu, uint32_t level);
+	} // namespace CpuTopologyFn
+
+} // namespace Rio
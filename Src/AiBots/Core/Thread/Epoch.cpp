@@ -0,0 +1,175 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/Thread/Epoch.h"
+
+#include "Core/Debug/Error.h"
+#include "Core/Thread/Atomic.h"
+
+#include <cstring> // memmove
+
+namespace Rio
+{
+	namespace
+	{
+		struct ThreadRecord
+		{
+			// The epoch seen by enter() plus one, 0 while the thread is outside
+			PaddedAtomic<uint64_t> epoch;
+			Atomic<uint32_t> isTaken;
+		};
+
+		ThreadRecord threadRecords[EpochFn::MAX_THREADS];
+		// Records ever taken, tryAdvance() reads these only
+		Atomic<uint32_t> threadRecordsCount;
+		PaddedAtomic<uint64_t> globalEpoch;
+
+		struct ThreadEpoch
+		{
+			ThreadRecord* record;
+			uint32_t nestingCount;
+
+			// Gives the record to the next thread
+			~ThreadEpoch()
+			{
+				if (record != nullptr)
+				{
+					record->isTaken.store(0, MemoryOrder::RELEASE);
+				}
+			}
+		};
+
+		thread_local ThreadEpoch threadEpoch;
+
+		ThreadRecord* takeThreadRecord()
+		{
+			for (uint32_t i = 0; i < EpochFn::MAX_THREADS; ++i)
+			{
+				uint32_t isTaken = 0;
+				if (threadRecords[i].isTaken.compareExchangeStrong(isTaken, 1, MemoryOrder::ACQUIRE))
+				{
+					uint32_t count = threadRecordsCount.load(MemoryOrder::RELAXED);
+					while (count < i + 1 && !threadRecordsCount.compareExchangeWeak(count, i + 1, MemoryOrder::RELAXED))
+					{
+					}
+					return &threadRecords[i];
+				}
+			}
+			RIO_FATAL("Too many threads use epochs");
+			return nullptr;
+		}
+	} // namespace
+
+	namespace EpochFn
+	{
+		void enter()
+		{
+			ThreadEpoch& thread = threadEpoch;
+			if (thread.nestingCount++ != 0)
+			{
+				return;
+			}
+			if (thread.record == nullptr)
+			{
+				thread.record = takeThreadRecord();
+			}
+			thread.record->epoch.store(globalEpoch.load(MemoryOrder::RELAXED) + 1, MemoryOrder::RELAXED);
+			// The record is visible before the reads of the structure, pairs with the fence of tryAdvance()
+			AtomicFn::threadFence(MemoryOrder::SEQUENTIALLY_CONSISTENT);
+		}
+
+		void leave()
+		{
+			ThreadEpoch& thread = threadEpoch;
+			RIO_ASSERT(thread.nestingCount > 0, "leave() without enter()");
+			if (--thread.nestingCount == 0)
+			{
+				// The reads of the structure are done before the memory can be freed
+				thread.record->epoch.store(0, MemoryOrder::RELEASE);
+			}
+		}
+
+		uint64_t getEpoch()
+		{
+			return globalEpoch.load(MemoryOrder::ACQUIRE);
+		}
+
+		uint64_t tryAdvance()
+		{
+			// The unlinks retired so far are visible before the records are read
+			AtomicFn::threadFence(MemoryOrder::SEQUENTIALLY_CONSISTENT);
+			uint64_t epoch = globalEpoch.load(MemoryOrder::ACQUIRE);
+			const uint32_t count = threadRecordsCount.load(MemoryOrder::ACQUIRE);
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				const uint64_t recordEpoch = threadRecords[i].epoch.load(MemoryOrder::ACQUIRE);
+				if (recordEpoch != 0 && recordEpoch != epoch + 1)
+				{
+					return epoch;
+				}
+			}
+			// Another thread may have moved it first, either way it moved
+			if (globalEpoch.compareExchangeStrong(epoch, epoch + 1, MemoryOrder::ACQUIRE_RELEASE))
+			{
+				return epoch + 1;
+			}
+			return epoch;
+		}
+	} // namespace EpochFn
+
+	RetireList::RetireList(Allocator& a)
+		: allocator(&a)
+		, retired(a)
+		, reclaimCount(RECLAIM_COUNT)
+	{
+	}
+
+	RetireList::~RetireList()
+	{
+		for (uint32_t i = 0; i < getCount(); ++i)
+		{
+			allocator->deallocate(retired[i].memory);
+		}
+	}
+
+	void RetireList::retire(void* memory)
+	{
+		// The memory is unlinked before the epoch is read, pairs with the fence of enter()
+		AtomicFn::threadFence(MemoryOrder::SEQUENTIALLY_CONSISTENT);
+		Retired item;
+		item.memory = memory;
+		item.epoch = EpochFn::getEpoch();
+		ArrayFn::pushBack(retired, item);
+
+		if (getCount() >= reclaimCount)
+		{
+			reclaim();
+			reclaimCount = getCount() + RECLAIM_COUNT;
+		}
+	}
+
+	void RetireList::reclaim()
+	{
+		if (getCount() == 0)
+		{
+			return;
+		}
+		// Twice, without readers the memory retired in the current epoch is freed at once
+		EpochFn::tryAdvance();
+		const uint64_t epoch = EpochFn::tryAdvance();
+
+		uint32_t freedCount = 0;
+		while (freedCount < getCount() && retired[freedCount].epoch + 2 <= epoch)
+		{
+			allocator->deallocate(retired[freedCount].memory);
+			++freedCount;
+		}
+		const uint32_t remainingCount = getCount() - freedCount;
+		memmove(ArrayFn::begin(retired), ArrayFn::begin(retired) + freedCount, remainingCount * sizeof(Retired));
+		ArrayFn::resize(retired, remainingCount);
+	}
+
+	uint32_t RetireList::getCount() const
+	{
+		return uint32_t(ArrayFn::getCount(retired));
+	}
+
+} // namespace Rio
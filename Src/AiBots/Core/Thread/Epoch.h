@@ -0,0 +1,88 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#pragma once
+
+#include "Core/Base/Config.h"
+#include "Core/Base/Types.h"
+
+#include "Core/Memory/Allocator.h"
+#include "Core/Containers/Array.h"
+
+namespace Rio
+{
+	// Epoch based reclamation of the memory of lock-free structures.
+	// Readers enter() before they follow pointers into the structure and leave() after.
+	// A writer which unlinks memory retires it instead of freeing it, the memory is freed once the
+	// epoch has moved twice: by then every thread which could have read it has left.
+	//
+	// enter() and leave() write a record of the calling thread only, readers do not share cache lines.
+	// A thread must not wait for jobs between enter() and leave(), its fiber could resume on another thread.
+	namespace EpochFn
+	{
+		// Threads which entered at least once and are still alive
+		const uint32_t MAX_THREADS = 256;
+
+		// May nest, the memory retired meanwhile is not freed until the outermost leave()
+		void enter();
+		void leave();
+		uint64_t getEpoch();
+		// Moves to the next epoch if all the threads inside enter() have seen the current one.
+		// Returns the current epoch.
+		uint64_t tryAdvance();
+	} // namespace EpochFn
+
+	// RAII wrapper, like ScopedMutex
+	class ScopedEpoch
+	{
+	public:
+		ScopedEpoch()
+		{
+			EpochFn::enter();
+		}
+
+		~ScopedEpoch()
+		{
+			EpochFn::leave();
+		}
+	private:
+		// Disable copying
+		ScopedEpoch(const ScopedEpoch&);
+		ScopedEpoch& operator=(const ScopedEpoch&);
+	};
+
+	// Memory unlinked from a lock-free structure, waiting to be freed.
+	// Not thread safe, it is used under the lock of the writers.
+	class RetireList
+	{
+	public:
+		// Retired memory is freed once this many are pending
+		static const uint32_t RECLAIM_COUNT = 64;
+
+		RetireList(Allocator& a);
+		// Frees all the memory, no thread may read it anymore
+		~RetireList();
+
+		// memory was allocated by the allocator of the list, it is freed once no reader can see it
+		void retire(void* memory);
+		// Frees the memory no reader can see anymore
+		void reclaim();
+		uint32_t getCount() const;
+
+	private:
+		struct Retired
+		{
+			void* memory;
+			uint64_t epoch;
+		};
+
+		Allocator* allocator;
+		// In the order of their epoch
+		Array<Retired> retired;
+		// Count which triggers the next reclaim(), pushed back while readers hold the epoch
+		uint32_t reclaimCount;
+	private:
+		// Disable copying
+		RetireList(const RetireList&);
+		RetireList& operator=(const RetireList&);
+	};
+
+} // namespace Rio
@@ -0,0 +1,67 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/Thread/Event.h"
+
+#include "Core/Thread/Futex.h"
+
+namespace Rio
+{
+	namespace
+	{
+		const uint32_t NOT_SET = 0;
+		const uint32_t SET = 1;
+		const uint32_t NOT_SET_WITH_WAITERS = 2;
+	} // namespace (anonymous)
+
+	Event::Event(bool isSet)
+		: state(isSet ? SET : NOT_SET)
+	{
+	}
+
+	void Event::set()
+	{
+		if (state.exchange(SET, MemoryOrder::RELEASE) == NOT_SET_WITH_WAITERS)
+		{
+			FutexFn::wakeAll(state);
+		}
+	}
+
+	void Event::reset()
+	{
+		// Keeps the waiters flag if there is one
+		uint32_t expected = SET;
+		state.compareExchangeStrong(expected, NOT_SET, MemoryOrder::RELAXED);
+	}
+
+	bool Event::getIsSet() const
+	{
+		return state.load(MemoryOrder::ACQUIRE) == SET;
+	}
+
+	void Event::wait()
+	{
+		const uint32_t spinCount = FutexFn::getSpinCount();
+		for (uint32_t i = 0; i < spinCount; ++i)
+		{
+			if (state.load(MemoryOrder::ACQUIRE) == SET)
+			{
+				return;
+			}
+			AtomicFn::pause();
+		}
+
+		while (true)
+		{
+			uint32_t value = state.load(MemoryOrder::ACQUIRE);
+			if (value == SET)
+			{
+				return;
+			}
+			if (value == NOT_SET && !state.compareExchangeWeak(value, NOT_SET_WITH_WAITERS, MemoryOrder::RELAXED))
+			{
+				continue;
+			}
+			FutexFn::wait(state, NOT_SET_WITH_WAITERS);
+		}
+	}
+
+} // namespace Rio
@@ -0,0 +1,32 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#pragma once
+
+#include "Core/Base/Config.h"
+#include "Core/Base/Types.h"
+#include "Core/Thread/Atomic.h"
+
+namespace Rio
+{
+	// Manual-reset event, wait() returns as long as the event is set.
+	// set() costs a system call only if a thread is waiting.
+	class Event
+	{
+	public:
+		Event(bool isSet = false);
+
+		// Wakes all the waiting threads
+		void set();
+		void reset();
+		bool getIsSet() const;
+		// Blocks until the event is set
+		void wait();
+	private:
+		// 0 not set, 1 set, 2 not set with waiters
+		Atomic<uint32_t> state;
+	private:
+		// Disable copying
+		Event(const Event&);
+		Event& operator=(const Event&);
+	};
+
+} // namespace Rio
@@ -0,0 +1,71 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#pragma once
+
+#include "Core/Base/Config.h"
+#include "Core/Base/Platform.h"
+#include "Core/Base/Types.h"
+
+// Hand-written context switch on x86-64 Linux, ucontext on the other POSIX platforms
+#define RIO_FIBER_ASM ((RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID) && RIO_CPU_X86 && RIO_ARCH_64BIT)
+
+namespace Rio
+{
+	typedef void (*FiberFunction)(void* data);
+
+	// Execution context with its own stack, switched to explicitly on the calling thread.
+	// A suspended fiber can be resumed by any thread, except the ones made from a thread which
+	// must be resumed by that thread.
+	//
+	// thread_local variables must not be cached across a switch, the fiber may come back on another thread.
+	class Fiber
+	{
+	public:
+		static const size_t DEFAULT_STACK_SIZE = 64 * 1024;
+
+		Fiber();
+		~Fiber();
+
+		// Creates a fiber running function the first time it is switched to.
+		// function must never return, switch to another fiber instead.
+		// The stack has a guard page below it where the OS supports it.
+		void create(FiberFunction function, void* data, size_t stackSize = DEFAULT_STACK_SIZE);
+		// Makes the calling thread a fiber, it must be done before the thread switches to another fiber
+		void createFromCurrentThread();
+		// The fiber must not be running, a fiber made from a thread is destroyed by that thread
+		void destroy();
+		bool getIsCreated() const;
+
+		// Saves the context of the calling thread to from, which must be the running fiber, and resumes to
+		static void switchTo(Fiber& from, Fiber& to);
+
+	private:
+		// Implemented per platform, see Posix/Fiber_Posix.cpp and Windows/Fiber_Windows.cpp
+#if RIO_PLATFORM_POSIX
+	#if RIO_FIBER_ASM
+		static void entry(void* fiber);
+	#else
+		// Takes the fiber from a thread_local, makecontext() only passes ints
+		static void entry();
+	#endif // RIO_FIBER_ASM
+
+		void* stack;
+		size_t stackSize;
+		// The saved stack pointer with RIO_FIBER_ASM, a ucontext_t otherwise
+		void* context;
+#elif RIO_PLATFORM_WINDOWS
+		static void __stdcall entry(void* fiber);
+
+		void* fiberHandle;
+		// Converted by createFromCurrentThread(), converted back by destroy()
+		bool isThread;
+#endif // RIO_PLATFORM_POSIX
+		FiberFunction function;
+		void* data;
+		bool isCreated;
+	private:
+		// Disable copying
+		Fiber(const Fiber&);
+		Fiber& operator=(const Fiber&);
+	};
+
+} // namespace Rio
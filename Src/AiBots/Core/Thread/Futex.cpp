@@ -0,0 +1,17 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/Thread/Futex.h"
+
+#include "Core/Thread/Thread.h"
+
+namespace Rio
+{
+	namespace FutexFn
+	{
+		uint32_t getSpinCount()
+		{
+			static const uint32_t spinCount = Thread::getProcessorsCount() > 1 ? 128 : 0;
+			return spinCount;
+		}
+	} // namespace FutexFn
+
+} // namespace Rio
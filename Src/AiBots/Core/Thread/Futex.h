@@ -0,0 +1,26 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#pragma once
+
+#include "Core/Base/Config.h"
+#include "Core/Base/Types.h"
+#include "Core/Thread/Atomic.h"
+
+namespace Rio
+{
+	// Waits on the address of a 32-bit word, the building block of Mutex, Semaphore, Event, Latch and ReadWriteLock.
+	// Uses futex() on Linux and WaitOnAddress() on Windows 8 or later.
+	// Elsewhere the waiters are parked on a table of condition variables indexed by address.
+	namespace FutexFn
+	{
+		// Returns the number of spins before a primitive waits on its futex,
+		// 0 with a single processor as the owner cannot run while we spin
+		uint32_t getSpinCount();
+
+		// Blocks while word == expected, may return spuriously
+		void wait(Atomic<uint32_t>& word, uint32_t expected);
+		// Wakes up to count threads waiting on word
+		void wake(Atomic<uint32_t>& word, uint32_t count);
+		void wakeAll(Atomic<uint32_t>& word);
+	} // namespace FutexFn
+
+} // namespace Rio
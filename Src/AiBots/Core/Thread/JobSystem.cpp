@@ -0,0 +1,702 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/Thread/JobSystem.h"
+
+#include "Core/Debug/Error.h"
+#include "Core/Os/Os.h"
+#include "Core/Thread/ScopedMutex.h"
+
+#include <cstdio> // snprintf
+#include <cstring> // memcpy
+#include <new>
+
+namespace Rio
+{
+	// 128 bytes, two cache lines
+	struct Job
+	{
+		JobFunction function;
+		Job* parent;
+		void* data;
+		// The job itself and its children not done yet
+		Atomic<int32_t> unfinishedJobs;
+		Atomic<uint32_t> continuationsCount;
+		Job* continuations[JobSystem::MAX_CONTINUATIONS];
+		// Data copied by createJobWithData()
+		char storage[JobSystem::MAX_JOB_DATA_SIZE];
+	};
+
+	namespace
+	{
+		// Attempts at finding a job before an idle worker sleeps
+		const uint32_t SPIN_COUNT = 64;
+
+		struct ParallelForData
+		{
+			ParallelForFunction function;
+			void* data;
+			uint32_t first;
+			uint32_t last;
+			uint32_t rangeSize;
+		};
+
+		// Takes back one unit of count unless it reached 0, returns whether it did
+		bool tryDecrement(Atomic<int32_t>& count)
+		{
+			int32_t value = count.load(MemoryOrder::RELAXED);
+			while (value > 0)
+			{
+				if (count.compareExchangeWeak(value, value - 1, MemoryOrder::SEQUENTIALLY_CONSISTENT, MemoryOrder::RELAXED))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		bool isTimeReached(void* data)
+		{
+			return Os::getClockTime() >= *(const int64_t*)data;
+		}
+	} // namespace (anonymous)
+
+	thread_local JobSystem::Worker* JobSystem::currentWorker = nullptr;
+
+	JobSystem::JobSystem(Allocator& a, uint32_t workersCount)
+		: allocator(&a)
+		, workers(a)
+		, sleepingCount(0)
+		, isStopping(0)
+		, fibers(a)
+		, freeFibers(a)
+		, waitingFibers(a)
+		, readyFibers(a)
+		, pollingFibers(a)
+		, waitingFibersCount(0)
+		, pollingFibersCount(0)
+		, readyFibersCount(0)
+	{
+		RIO_ASSERT(currentWorker == nullptr, "The thread already belongs to a JobSystem");
+
+		if (workersCount == 0)
+		{
+			workersCount = Thread::getProcessorsCount() - 1;
+		}
+		RIO_ASSERT(workersCount < MAX_FIBERS, "Each worker needs a fiber");
+
+		ArrayFn::reserve(fibers, MAX_FIBERS);
+		ArrayFn::reserve(freeFibers, MAX_FIBERS);
+		ArrayFn::reserve(waitingFibers, MAX_FIBERS);
+		ArrayFn::reserve(readyFibers, MAX_FIBERS);
+		ArrayFn::reserve(pollingFibers, MAX_FIBERS);
+		for (uint32_t i = 0; i < MAX_FIBERS; ++i)
+		{
+			WorkerFiber* fiber = a.makeNew<WorkerFiber>();
+			fiber->jobSystem = this;
+			fiber->waitedJob = nullptr;
+			fiber->poll = nullptr;
+			fiber->pollData = nullptr;
+			fiber->owner = nullptr;
+			fiber->fiber.create(fiberMain, fiber, FIBER_STACK_SIZE);
+			ArrayFn::pushBack(fibers, fiber);
+			ArrayFn::pushBack(freeFibers, fiber);
+		}
+
+		for (uint32_t i = 0; i < workersCount + 1; ++i)
+		{
+			Worker* worker = a.makeNew<Worker>();
+			worker->jobSystem = this;
+			worker->jobs = (Job*)a.allocate(sizeof(Job) * MAX_JOBS, RIO_CACHE_LINE_SIZE);
+			for (uint32_t j = 0; j < MAX_JOBS; ++j)
+			{
+				Job* job = new (&worker->jobs[j]) Job();
+				job->unfinishedJobs.store(0, MemoryOrder::RELAXED);
+			}
+			worker->jobsAllocated = 0;
+			worker->random = i + 1;
+			worker->threadFiber.jobSystem = this;
+			worker->threadFiber.waitedJob = nullptr;
+			worker->threadFiber.poll = nullptr;
+			worker->threadFiber.pollData = nullptr;
+			worker->threadFiber.owner = worker;
+			worker->currentFiber = &worker->threadFiber;
+			worker->fiberToFree = nullptr;
+			worker->fiberToSuspend = nullptr;
+			ArrayFn::pushBack(workers, worker);
+		}
+		currentWorker = workers[0];
+		workers[0]->threadFiber.fiber.createFromCurrentThread();
+
+		// Started once all the workers exist, they steal from each other
+		for (uint32_t i = 1; i < ArrayFn::getCount(workers); ++i)
+		{
+			char name[32];
+			snprintf(name, sizeof(name), "Job worker %u", i);
+			workers[i]->thread.setName(name);
+			workers[i]->thread.start(workerMain, workers[i]);
+		}
+	}
+
+	JobSystem::~JobSystem()
+	{
+		RIO_ASSERT(currentWorker == workers[0], "Must be destroyed by the thread which created it");
+
+		isStopping.store(1, MemoryOrder::SEQUENTIALLY_CONSISTENT);
+		semaphore.post(uint32_t(ArrayFn::getCount(workers)));
+		for (uint32_t i = 1; i < ArrayFn::getCount(workers); ++i)
+		{
+			workers[i]->thread.stop();
+		}
+		RIO_ASSERT(waitingFibersCount.load(MemoryOrder::RELAXED) == 0
+			&& pollingFibersCount.load(MemoryOrder::RELAXED) == 0
+			, "Jobs are still waiting");
+
+		workers[0]->threadFiber.fiber.destroy();
+		for (uint32_t i = 0; i < ArrayFn::getCount(workers); ++i)
+		{
+			allocator->deallocate(workers[i]->jobs);
+			allocator->makeDelete(workers[i]);
+		}
+		for (uint32_t i = 0; i < ArrayFn::getCount(fibers); ++i)
+		{
+			allocator->makeDelete(fibers[i]);
+		}
+		currentWorker = nullptr;
+	}
+
+	Job* JobSystem::createJob(JobFunction function, void* data, Job* parent)
+	{
+		Job* job = allocateJob(function, parent);
+		job->data = data;
+		return job;
+	}
+
+	Job* JobSystem::createJobWithData(JobFunction function, const void* data, size_t size, Job* parent)
+	{
+		RIO_ASSERT(size <= MAX_JOB_DATA_SIZE, "Job data is too large");
+		Job* job = allocateJob(function, parent);
+		memcpy(job->storage, data, size);
+		job->data = job->storage;
+		return job;
+	}
+
+	void JobSystem::addContinuation(Job* ancestor, Job* continuation)
+	{
+		const uint32_t index = ancestor->continuationsCount.fetchAdd(1, MemoryOrder::RELAXED);
+		RIO_ASSERT(index < MAX_CONTINUATIONS, "Too many continuations");
+		ancestor->continuations[index] = continuation;
+	}
+
+	void JobSystem::run(Job* job)
+	{
+		Worker& worker = getCurrentWorker();
+		if (!worker.queue.push(job))
+		{
+			// The queue is full, nobody would run it sooner than us
+			execute(job);
+			return;
+		}
+		wakeWorker();
+	}
+
+	void JobSystem::wait(const Job* job)
+	{
+		if (isDone(job))
+		{
+			return;
+		}
+
+		WorkerFiber* next = takeNextFiber();
+		while (next == nullptr)
+		{
+			// No fiber to switch to, runs jobs on this one until job is done or a fiber is free or ready
+			if (isDone(job))
+			{
+				return;
+			}
+			// Read again, the jobs may suspend this fiber and resume it on another thread
+			Job* other = getJob(getCurrentWorker());
+			if (other != nullptr)
+			{
+				execute(other);
+			}
+			else
+			{
+				Thread::yield();
+			}
+			next = takeNextFiber();
+		}
+
+		Worker& worker = getCurrentWorker();
+		// Suspended by next once it runs, resumed once job is done
+		WorkerFiber& self = *worker.currentFiber;
+		self.waitedJob = job;
+		worker.fiberToSuspend = &self;
+		switchFiber(self, *next);
+	}
+
+	void JobSystem::waitUntil(PollFunction poll, void* data)
+	{
+		RIO_ASSERT_NOT_NULL(poll);
+		if (poll(data))
+		{
+			return;
+		}
+
+		WorkerFiber* next = takeNextFiber();
+		while (next == nullptr)
+		{
+			// No fiber to switch to, runs jobs on this one until the condition is met or a fiber is free or ready
+			if (poll(data))
+			{
+				return;
+			}
+			// Read again, the jobs may suspend this fiber and resume it on another thread
+			Job* other = getJob(getCurrentWorker());
+			if (other != nullptr)
+			{
+				execute(other);
+			}
+			else
+			{
+				Thread::yield();
+			}
+			next = takeNextFiber();
+		}
+
+		Worker& worker = getCurrentWorker();
+		WorkerFiber& self = *worker.currentFiber;
+		self.poll = poll;
+		self.pollData = data;
+		worker.fiberToSuspend = &self;
+		switchFiber(self, *next);
+	}
+
+	void JobSystem::sleep(uint32_t milliseconds)
+	{
+		const int64_t endTime = Os::getClockTime() + Os::getClockFrequency() * milliseconds / 1000;
+		waitUntil(isTimeReached, (void*)&endTime);
+	}
+
+	void JobSystem::update()
+	{
+		pollFibers();
+	}
+
+	bool JobSystem::isDone(const Job* job) const
+	{
+		return job->unfinishedJobs.load(MemoryOrder::ACQUIRE) == 0;
+	}
+
+	Job* JobSystem::parallelFor(uint32_t count, ParallelForFunction function, void* data, uint32_t rangeSize)
+	{
+		if (rangeSize == 0)
+		{
+			// A few ranges per thread, the ones done early steal the others
+			rangeSize = count / (getThreadsCount() * 4);
+			rangeSize = rangeSize > 0 ? rangeSize : 1;
+		}
+
+		ParallelForData parallelForData;
+		parallelForData.function = function;
+		parallelForData.data = data;
+		parallelForData.first = 0;
+		parallelForData.last = count;
+		parallelForData.rangeSize = rangeSize;
+
+		Job* job = createJobWithData(parallelForJob, &parallelForData, sizeof(parallelForData));
+		run(job);
+		return job;
+	}
+
+	uint32_t JobSystem::getThreadsCount() const
+	{
+		return uint32_t(ArrayFn::getCount(workers));
+	}
+
+	Job* JobSystem::allocateJob(JobFunction function, Job* parent)
+	{
+		RIO_ASSERT_NOT_NULL(function);
+
+		Worker& worker = getCurrentWorker();
+		// Skips the jobs still running, parents live longer than their children
+		Job* job = &worker.jobs[worker.jobsAllocated & (MAX_JOBS - 1)];
+		++worker.jobsAllocated;
+		for (uint32_t i = 1; i < MAX_JOBS && !isDone(job); ++i)
+		{
+			job = &worker.jobs[worker.jobsAllocated & (MAX_JOBS - 1)];
+			++worker.jobsAllocated;
+		}
+		RIO_ASSERT(isDone(job), "Too many jobs in flight, more than MAX_JOBS");
+
+		job->function = function;
+		job->parent = parent;
+		job->data = nullptr;
+		job->continuationsCount.store(0, MemoryOrder::RELAXED);
+		job->unfinishedJobs.store(1, MemoryOrder::RELAXED);
+		if (parent != nullptr)
+		{
+			parent->unfinishedJobs.fetchAdd(1, MemoryOrder::RELAXED);
+		}
+		return job;
+	}
+
+	JobSystem::Worker& JobSystem::getCurrentWorker() const
+	{
+		RIO_ASSERT(currentWorker != nullptr && currentWorker->jobSystem == this, "Not a thread of this JobSystem");
+		return *currentWorker;
+	}
+
+	Job* JobSystem::getJob(Worker& worker)
+	{
+		Job* job = worker.queue.pop();
+		if (job != nullptr)
+		{
+			return job;
+		}
+
+		const uint32_t count = uint32_t(ArrayFn::getCount(workers));
+		// xorshift32, spreads the thieves over the workers
+		worker.random ^= worker.random << 13;
+		worker.random ^= worker.random >> 17;
+		worker.random ^= worker.random << 5;
+		const uint32_t first = worker.random % count;
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			Worker* victim = workers[(first + i) % count];
+			if (victim == &worker)
+			{
+				continue;
+			}
+			job = victim->queue.steal();
+			if (job != nullptr)
+			{
+				return job;
+			}
+		}
+		return nullptr;
+	}
+
+	void JobSystem::execute(Job* job)
+	{
+		job->function(*this, job, job->data);
+		finish(job);
+	}
+
+	void JobSystem::finish(Job* job)
+	{
+		// Read before the job is done, it may be reused right after
+		Job* parent = job->parent;
+		Job* continuations[MAX_CONTINUATIONS];
+		const uint32_t continuationsCount = job->continuationsCount.load(MemoryOrder::RELAXED);
+		for (uint32_t i = 0; i < continuationsCount; ++i)
+		{
+			continuations[i] = job->continuations[i];
+		}
+
+		if (job->unfinishedJobs.fetchSub(1, MemoryOrder::ACQUIRE_RELEASE) != 1)
+		{
+			return;
+		}
+
+		// Pairs with the fence of completeSwitch(), either it sees the job done or we see the fiber
+		AtomicFn::threadFence(MemoryOrder::SEQUENTIALLY_CONSISTENT);
+		if (waitingFibersCount.load(MemoryOrder::RELAXED) != 0)
+		{
+			resumeWaitingFibers(job);
+		}
+
+		if (parent != nullptr)
+		{
+			finish(parent);
+		}
+		for (uint32_t i = 0; i < continuationsCount; ++i)
+		{
+			run(continuations[i]);
+		}
+	}
+
+	bool JobSystem::hasJobs() const
+	{
+		if (readyFibersCount.load(MemoryOrder::RELAXED) != 0)
+		{
+			return true;
+		}
+		for (uint32_t i = 0; i < ArrayFn::getCount(workers); ++i)
+		{
+			if (!workers[i]->queue.getIsEmpty())
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void JobSystem::wakeWorker()
+	{
+		// Pairs with the fence of the worker going to sleep, either it sees the job or we see it
+		AtomicFn::threadFence(MemoryOrder::SEQUENTIALLY_CONSISTENT);
+		if (tryDecrement(sleepingCount))
+		{
+			semaphore.post();
+		}
+	}
+
+	void JobSystem::runWorker(WorkerFiber& self)
+	{
+		uint32_t idleCount = 0;
+		for (;;)
+		{
+			// Read again after each job, the fiber may have been suspended and resumed on another thread
+			Worker& worker = getCurrentWorker();
+			if (isStopping.load(MemoryOrder::ACQUIRE) != 0)
+			{
+				// Back to the thread, which ends. Not freed, it is never resumed.
+				switchFiber(self, worker.threadFiber);
+				continue;
+			}
+
+			WorkerFiber* ready = takeReadyFiber(worker);
+			if (ready != nullptr)
+			{
+				// Back to the pool once the other fiber runs
+				worker.fiberToFree = &self;
+				switchFiber(self, *ready);
+				idleCount = 0;
+				continue;
+			}
+
+			Job* job = getJob(worker);
+			if (job != nullptr)
+			{
+				execute(job);
+				idleCount = 0;
+				continue;
+			}
+
+			// Only when idle, the conditions may be costly to poll
+			pollFibers();
+			if (++idleCount < SPIN_COUNT)
+			{
+				Thread::yield();
+				continue;
+			}
+			idleCount = 0;
+
+			// The thread which created the JobSystem only runs here while it waits,
+			// nobody else can resume it so it does not sleep
+			if (&worker == workers[0])
+			{
+				Thread::yield();
+				continue;
+			}
+
+			sleepingCount.fetchAdd(1, MemoryOrder::SEQUENTIALLY_CONSISTENT);
+			AtomicFn::threadFence(MemoryOrder::SEQUENTIALLY_CONSISTENT);
+			// A job queued before we were counted would not wake us
+			if (hasJobs() && tryDecrement(sleepingCount))
+			{
+				continue;
+			}
+			// Otherwise a post is owed to us, or to a worker which took our place
+			semaphore.wait();
+		}
+	}
+
+	JobSystem::WorkerFiber* JobSystem::allocateFiber()
+	{
+		ScopedMutex lock(fibersMutex);
+		if (ArrayFn::getIsEmpty(freeFibers))
+		{
+			return nullptr;
+		}
+		WorkerFiber* fiber = ArrayFn::back(freeFibers);
+		ArrayFn::popBack(freeFibers);
+		return fiber;
+	}
+
+	JobSystem::WorkerFiber* JobSystem::takeReadyFiber(Worker& worker)
+	{
+		if (readyFibersCount.load(MemoryOrder::RELAXED) == 0)
+		{
+			return nullptr;
+		}
+
+		ScopedMutex lock(fibersMutex);
+		for (uint32_t i = 0; i < ArrayFn::getCount(readyFibers); ++i)
+		{
+			WorkerFiber* fiber = readyFibers[i];
+			if (fiber->owner == nullptr || fiber->owner == &worker)
+			{
+				readyFibers[i] = ArrayFn::back(readyFibers);
+				ArrayFn::popBack(readyFibers);
+				readyFibersCount.fetchSub(1, MemoryOrder::RELAXED);
+				return fiber;
+			}
+		}
+		return nullptr;
+	}
+
+	void JobSystem::resumeWaitingFibers(const Job* job)
+	{
+		bool isResumed = false;
+		{
+			ScopedMutex lock(fibersMutex);
+			for (uint32_t i = 0; i < ArrayFn::getCount(waitingFibers); )
+			{
+				WorkerFiber* fiber = waitingFibers[i];
+				if (fiber->waitedJob != job)
+				{
+					++i;
+					continue;
+				}
+				waitingFibers[i] = ArrayFn::back(waitingFibers);
+				ArrayFn::popBack(waitingFibers);
+				waitingFibersCount.fetchSub(1, MemoryOrder::RELAXED);
+				ArrayFn::pushBack(readyFibers, fiber);
+				readyFibersCount.fetchAdd(1, MemoryOrder::RELAXED);
+				isResumed = true;
+			}
+		}
+		if (isResumed)
+		{
+			wakeWorker();
+		}
+	}
+
+	void JobSystem::pollFibers()
+	{
+		if (pollingFibersCount.load(MemoryOrder::RELAXED) == 0)
+		{
+			return;
+		}
+
+		bool isResumed = false;
+		{
+			ScopedMutex lock(fibersMutex);
+			for (uint32_t i = 0; i < ArrayFn::getCount(pollingFibers); )
+			{
+				WorkerFiber* fiber = pollingFibers[i];
+				if (!fiber->poll(fiber->pollData))
+				{
+					++i;
+					continue;
+				}
+				fiber->poll = nullptr;
+				fiber->pollData = nullptr;
+				pollingFibers[i] = ArrayFn::back(pollingFibers);
+				ArrayFn::popBack(pollingFibers);
+				pollingFibersCount.fetchSub(1, MemoryOrder::RELAXED);
+				ArrayFn::pushBack(readyFibers, fiber);
+				readyFibersCount.fetchAdd(1, MemoryOrder::RELAXED);
+				isResumed = true;
+			}
+		}
+		if (isResumed)
+		{
+			wakeWorker();
+		}
+	}
+
+	JobSystem::WorkerFiber* JobSystem::takeNextFiber()
+	{
+		WorkerFiber* fiber = allocateFiber();
+		if (fiber != nullptr)
+		{
+			return fiber;
+		}
+		// The waiting fibers hold the whole pool, only they can run what they wait for
+		pollFibers();
+		return takeReadyFiber(getCurrentWorker());
+	}
+
+	void JobSystem::switchFiber(WorkerFiber& from, WorkerFiber& to)
+	{
+		getCurrentWorker().currentFiber = &to;
+		Fiber::switchTo(from.fiber, to.fiber);
+		// Resumed, maybe by another thread
+		completeSwitch();
+	}
+
+	void JobSystem::completeSwitch()
+	{
+		Worker& worker = getCurrentWorker();
+		WorkerFiber* fiberToFree = worker.fiberToFree;
+		WorkerFiber* fiberToSuspend = worker.fiberToSuspend;
+		worker.fiberToFree = nullptr;
+		worker.fiberToSuspend = nullptr;
+		if (fiberToFree == nullptr && fiberToSuspend == nullptr)
+		{
+			return;
+		}
+
+		ScopedMutex lock(fibersMutex);
+		if (fiberToFree != nullptr)
+		{
+			ArrayFn::pushBack(freeFibers, fiberToFree);
+		}
+		if (fiberToSuspend != nullptr && fiberToSuspend->poll != nullptr)
+		{
+			// Polled by the idle workers and update()
+			ArrayFn::pushBack(pollingFibers, fiberToSuspend);
+			pollingFibersCount.fetchAdd(1, MemoryOrder::RELAXED);
+		}
+		else if (fiberToSuspend != nullptr)
+		{
+			waitingFibersCount.fetchAdd(1, MemoryOrder::RELAXED);
+			// Pairs with the fence of finish(), either it sees the fiber or we see the job done
+			AtomicFn::threadFence(MemoryOrder::SEQUENTIALLY_CONSISTENT);
+			if (isDone(fiberToSuspend->waitedJob))
+			{
+				waitingFibersCount.fetchSub(1, MemoryOrder::RELAXED);
+				ArrayFn::pushBack(readyFibers, fiberToSuspend);
+				readyFibersCount.fetchAdd(1, MemoryOrder::RELAXED);
+			}
+			else
+			{
+				ArrayFn::pushBack(waitingFibers, fiberToSuspend);
+			}
+		}
+	}
+
+	void JobSystem::fiberMain(void* data)
+	{
+		WorkerFiber& self = *(WorkerFiber*)data;
+		self.jobSystem->completeSwitch();
+		self.jobSystem->runWorker(self);
+	}
+
+	int32_t JobSystem::workerMain(void* data)
+	{
+		Worker& worker = *(Worker*)data;
+		JobSystem& jobSystem = *worker.jobSystem;
+		currentWorker = &worker;
+
+		// Switched back to by the fiber of the worker which sees isStopping
+		worker.threadFiber.fiber.createFromCurrentThread();
+		WorkerFiber* fiber = jobSystem.allocateFiber();
+		RIO_ASSERT_NOT_NULL(fiber);
+		jobSystem.switchFiber(worker.threadFiber, *fiber);
+		worker.threadFiber.fiber.destroy();
+
+		currentWorker = nullptr;
+		return 0;
+	}
+
+	void JobSystem::parallelForJob(JobSystem& jobSystem, Job* job, void* data)
+	{
+		ParallelForData range = *(const ParallelForData*)data;
+
+		// Splits off the upper half until the range is small enough,
+		// the thieves take the oldest and largest halves first
+		while (range.last - range.first > range.rangeSize)
+		{
+			const uint32_t middle = range.first + (range.last - range.first) / 2;
+			ParallelForData upper = range;
+			upper.first = middle;
+			jobSystem.run(jobSystem.createJobWithData(parallelForJob, &upper, sizeof(upper), job));
+			range.last = middle;
+		}
+		range.function(range.first, range.last, range.data);
+	}
+
+} // namespace Rio
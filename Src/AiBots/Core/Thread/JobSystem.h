@@ -0,0 +1,176 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#pragma once
+
+#include "Core/Base/Config.h"
+#include "Core/Base/Types.h"
+
+#include "Core/Memory/Allocator.h"
+#include "Core/Containers/Array.h"
+#include "Core/Thread/Atomic.h"
+#include "Core/Thread/Fiber.h"
+#include "Core/Thread/Mutex.h"
+#include "Core/Thread/Semaphore.h"
+#include "Core/Thread/Thread.h"
+#include "Core/Thread/WorkStealingQueue.h"
+
+namespace Rio
+{
+	class JobSystem;
+	struct Job;
+
+	// job is the running job, children created with it as parent are waited for before it is done
+	typedef void (*JobFunction)(JobSystem& jobSystem, Job* job, void* data);
+	// Processes the items [first, last)
+	typedef void (*ParallelForFunction)(uint32_t first, uint32_t last, void* data);
+	// Returns whether the condition a job waits for is met, called from any thread
+	typedef bool (*PollFunction)(void* data);
+
+	// Runs jobs on one worker thread per core.
+	// Each thread has its own deque of jobs, an idle thread steals from the others.
+	// The thread which created the JobSystem is a worker too, it runs jobs while it waits.
+	//
+	// A job is done when its function and all of its children are done.
+	// Continuations of a job are run once it is done, they express dependencies between jobs.
+	//
+	// Jobs run on fibers. A job which waits for another one with wait() suspends its fiber instead of
+	// blocking its thread, the thread runs other jobs meanwhile and the first thread free once the
+	// other job is done resumes the fiber. A job may then carry on on another thread than the one it
+	// started on, it must not keep thread_local values across wait().
+	// The thread which created the JobSystem waits the same way but is only resumed by itself.
+	//
+	// A job can also wait for a condition with waitUntil(), which idle workers and update() poll.
+	// The main loop calls update() once per frame, so that the conditions are polled while the workers sleep.
+	//
+	// Jobs are created and run from the worker threads and the thread which created the JobSystem only.
+	// Each thread allocates jobs from its own ring of MAX_JOBS jobs, a Job* is valid until it is done
+	// and the thread which created it has created MAX_JOBS more jobs.
+	class JobSystem
+	{
+	public:
+		static const uint32_t MAX_JOBS = 4096;
+		static const uint32_t MAX_CONTINUATIONS = 4;
+		// Size of the data copied by createJobWithData()
+		static const uint32_t MAX_JOB_DATA_SIZE = 64;
+		// Fibers running or waiting, wait() blocks its thread when they are all taken
+		static const uint32_t MAX_FIBERS = 128;
+		static const size_t FIBER_STACK_SIZE = 256 * 1024;
+
+		// workersCount is the number of threads started, 0 starts one per core but the current one
+		JobSystem(Allocator& a, uint32_t workersCount = 0);
+		// Waits for the jobs in progress
+		~JobSystem();
+
+		// Creates a job which is started by run(), data must stay valid until it is done
+		Job* createJob(JobFunction function, void* data = nullptr, Job* parent = nullptr);
+		// Creates a job with a copy of the size bytes of data
+		Job* createJobWithData(JobFunction function, const void* data, size_t size, Job* parent = nullptr);
+		// Runs continuation once ancestor is done, must be called before ancestor is run.
+		// continuation must not be run.
+		void addContinuation(Job* ancestor, Job* continuation);
+		// Queues the job on the current thread
+		void run(Job* job);
+		// Returns once job is done, the thread runs other jobs meanwhile
+		void wait(const Job* job);
+		// Returns once poll(data) returns true, the thread runs other jobs meanwhile.
+		// poll must be quick and must not block, data must stay valid until it returns true.
+		void waitUntil(PollFunction poll, void* data);
+		// Returns after at least milliseconds, give or take a frame if the workers sleep
+		void sleep(uint32_t milliseconds);
+		// Polls the conditions of waitUntil(), called by the main loop
+		void update();
+		bool isDone(const Job* job) const;
+		// Calls function on [0, count) split in ranges of rangeSize items, run by the workers.
+		// rangeSize 0 picks a size which gives a few ranges per thread.
+		// Returns the running job, wait() for it.
+		Job* parallelFor(uint32_t count, ParallelForFunction function, void* data, uint32_t rangeSize = 0);
+		// Returns the number of threads running jobs, the one which created the JobSystem included
+		uint32_t getThreadsCount() const;
+
+	private:
+		struct Worker;
+
+		struct WorkerFiber
+		{
+			Fiber fiber;
+			JobSystem* jobSystem;
+			// Job or condition the fiber waits for while it is suspended
+			const Job* waitedJob;
+			PollFunction poll;
+			void* pollData;
+			// Worker which must resume the fiber, nullptr for any
+			Worker* owner;
+		};
+
+		struct Worker
+		{
+			JobSystem* jobSystem;
+			WorkStealingQueue<Job, MAX_JOBS> queue;
+			Job* jobs;
+			uint32_t jobsAllocated;
+			// State of the xorshift which picks the workers to steal from
+			uint32_t random;
+			Thread thread;
+			// The thread itself, the workers run the jobs on fibers of the pool
+			WorkerFiber threadFiber;
+			WorkerFiber* currentFiber;
+			// Left by the fiber which switched away, handled by completeSwitch() on the fiber switched to
+			WorkerFiber* fiberToFree;
+			WorkerFiber* fiberToSuspend;
+		};
+
+		Job* allocateJob(JobFunction function, Job* parent);
+		// Never inlined, a fiber resumed on another thread must not see the thread_local of the previous one
+		RIO_NO_INLINE Worker& getCurrentWorker() const;
+		// Returns a job of the worker or one stolen from another one, nullptr if there are none
+		Job* getJob(Worker& worker);
+		void execute(Job* job);
+		void finish(Job* job);
+		bool hasJobs() const;
+		void wakeWorker();
+		// Runs jobs and resumes the fibers whose job is done until the JobSystem stops
+		void runWorker(WorkerFiber& self);
+		// Returns a fiber of the pool, nullptr if they are all taken
+		WorkerFiber* allocateFiber();
+		// Returns a suspended fiber whose job is done, nullptr if there are none
+		WorkerFiber* takeReadyFiber(Worker& worker);
+		// Moves the fibers waiting for the job, which is done, to the ready ones
+		void resumeWaitingFibers(const Job* job);
+		// Moves the fibers whose condition is met to the ready ones
+		void pollFibers();
+		// Returns the fiber a waiting one switches to: one of the pool or, when they are all taken, a ready one.
+		// nullptr if there are neither.
+		WorkerFiber* takeNextFiber();
+		void switchFiber(WorkerFiber& from, WorkerFiber& to);
+		// Frees or suspends the fiber left by the one which switched away, it cannot do it itself while it runs
+		void completeSwitch();
+		static void fiberMain(void* data);
+		static int32_t workerMain(void* data);
+		static void parallelForJob(JobSystem& jobSystem, Job* job, void* data);
+
+		Allocator* allocator;
+		// The first one is the thread which created the JobSystem
+		Array<Worker*> workers;
+		// Idle workers wait on the semaphore, sleepingCount is the number of them not woken yet
+		Semaphore semaphore;
+		Atomic<int32_t> sleepingCount;
+		Atomic<uint32_t> isStopping;
+
+		Array<WorkerFiber*> fibers;
+		Mutex fibersMutex;
+		Array<WorkerFiber*> freeFibers;
+		Array<WorkerFiber*> waitingFibers;
+		Array<WorkerFiber*> readyFibers;
+		Array<WorkerFiber*> pollingFibers;
+		// Read without the mutex, to skip it when there are none
+		Atomic<uint32_t> waitingFibersCount;
+		Atomic<uint32_t> pollingFibersCount;
+		Atomic<uint32_t> readyFibersCount;
+
+		static thread_local Worker* currentWorker;
+	private:
+		// Disable copying
+		JobSystem(const JobSystem&);
+		JobSystem& operator=(const JobSystem&);
+	};
+
+} // namespace Rio
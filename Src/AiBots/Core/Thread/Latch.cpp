@@ -0,0 +1,55 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/Thread/Latch.h"
+
+#include "Core/Debug/Error.h"
+#include "Core/Thread/Futex.h"
+
+namespace Rio
+{
+	namespace
+	{
+		const uint32_t WAITERS = 0x80000000u;
+	} // namespace (anonymous)
+
+	Latch::Latch(uint32_t count)
+		: count(count)
+	{
+		RIO_ASSERT(count < WAITERS, "Count is too large");
+	}
+
+	void Latch::countDown(uint32_t count)
+	{
+		const uint32_t previous = this->count.fetchSub(count, MemoryOrder::RELEASE);
+		RIO_ASSERT((previous & ~WAITERS) >= count, "Latch counted down below 0");
+		if (previous == (count | WAITERS))
+		{
+			FutexFn::wakeAll(this->count);
+		}
+	}
+
+	bool Latch::getIsDone() const
+	{
+		return (count.load(MemoryOrder::ACQUIRE) & ~WAITERS) == 0;
+	}
+
+	void Latch::wait()
+	{
+		const uint32_t spinCount = FutexFn::getSpinCount();
+		for (uint32_t i = 0; i < spinCount; ++i)
+		{
+			if (getIsDone())
+			{
+				return;
+			}
+			AtomicFn::pause();
+		}
+
+		uint32_t value = count.fetchOr(WAITERS, MemoryOrder::ACQUIRE) | WAITERS;
+		while (value != WAITERS)
+		{
+			FutexFn::wait(count, value);
+			value = count.load(MemoryOrder::ACQUIRE);
+		}
+	}
+
+} // namespace Rio
@@ -0,0 +1,31 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#pragma once
+
+#include "Core/Base/Config.h"
+#include "Core/Base/Types.h"
+#include "Core/Thread/Atomic.h"
+
+namespace Rio
+{
+	// Single-use countdown, wait() returns once countDown() has been called count times.
+	// E.g. the main thread waits for N threads to finish a step.
+	class Latch
+	{
+	public:
+		Latch(uint32_t count);
+
+		void countDown(uint32_t count = 1);
+		bool getIsDone() const;
+		// Blocks until the count reaches 0
+		void wait();
+	private:
+		// The top bit is set once a thread waits. Nothing else is touched after
+		// the last countDown(), the latch may be destroyed as soon as wait() returns.
+		Atomic<uint32_t> count;
+	private:
+		// Disable copying
+		Latch(const Latch&);
+		Latch& operator=(const Latch&);
+	};
+
+} // namespace Rio
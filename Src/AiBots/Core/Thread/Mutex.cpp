@@ -0,0 +1,63 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/Thread/Mutex.h"
+
+#if RIO_FUTEX
+
+#include "Core/Debug/Error.h"
+#include "Core/Thread/Futex.h"
+
+namespace Rio
+{
+	// See "Futexes Are Tricky", Drepper 2011, mutex3
+	Mutex::Mutex()
+		: state(0)
+	{
+	}
+
+	Mutex::~Mutex()
+	{
+		RIO_ASSERT(state.load(MemoryOrder::RELAXED) == 0, "Mutex is locked");
+	}
+
+	void Mutex::lock()
+	{
+		uint32_t expected = 0;
+		if (state.compareExchangeStrong(expected, 1, MemoryOrder::ACQUIRE, MemoryOrder::RELAXED))
+		{
+			return;
+		}
+
+		// Held for a short time most often, spinning avoids the system calls
+		const uint32_t spinCount = FutexFn::getSpinCount();
+		for (uint32_t i = 0; i < spinCount; ++i)
+		{
+			AtomicFn::pause();
+			expected = 0;
+			if (state.load(MemoryOrder::RELAXED) == 0
+				&& state.compareExchangeWeak(expected, 1, MemoryOrder::ACQUIRE, MemoryOrder::RELAXED))
+			{
+				return;
+			}
+		}
+
+		// Marked as contended, unlock() wakes a waiter. Locked as contended too,
+		// we cannot know if there are other waiters.
+		while (state.exchange(2, MemoryOrder::ACQUIRE) != 0)
+		{
+			FutexFn::wait(state, 2);
+		}
+	}
+
+	void Mutex::unlock()
+	{
+		const uint32_t previous = state.exchange(0, MemoryOrder::RELEASE);
+		RIO_ASSERT(previous != 0, "Mutex is not locked");
+		if (previous == 2)
+		{
+			FutexFn::wake(state, 1);
+		}
+	}
+
+} // namespace Rio
+
+#endif // RIO_FUTEX
@@ -4,7 +4,9 @@
 #include "Core/Base/Config.h"
 #include "Core/Base/Types.h"
 
-#if RIO_PLATFORM_POSIX
+#if RIO_FUTEX
+	#include "Core/Thread/Atomic.h"
+#elif RIO_PLATFORM_POSIX
 	#include <pthread.h>
 #elif RIO_PLATFORM_WINDOWS
 	#include "Core/Os/Windows/Headers_Windows.h"
@@ -15,6 +17,8 @@ namespace Rio
 // Why not use std::mutex and std::lock_guard
 // CriticalSection should be faster than std::mutex for Windows
 // For POSIX std::mutex uses PThreads internally
+// With RIO_FUTEX the lock spins for a while and then waits on a futex,
+// uncontended lock() and unlock() are a single atomic operation each
 class Mutex
 {
 public:
@@ -23,12 +27,17 @@ public:
 	void lock();
 	void unlock();
 private:
-#if RIO_PLATFORM_POSIX
+#if RIO_FUTEX
+	// 0 unlocked, 1 locked, 2 locked with waiters
+	Atomic<uint32_t> state;
+#elif RIO_PLATFORM_POSIX
 	pthread_mutex_t mutex;
 	pthread_mutexattr_t mutexAttr;
 #elif RIO_PLATFORM_WINDOWS
 	CRITICAL_SECTION criticalSection;
 #endif
+	// Semaphore waits on the native mutex
+	friend class Semaphore;
 private:
 	// Disable copying.
 	Mutex(const Mutex&);
@@ -0,0 +1,717 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#pragma once
+
+#include "Core/Base/Config.h"
+#include "Core/Base/Types.h"
+
+#include "Core/Debug/Error.h"
+
+#include "Core/Memory/Allocator.h"
+
+#include "Core/Containers/Array.h"
+#include "Core/Containers/Functional.h"
+#include "Core/Thread/JobSystem.h"
+
+#include <algorithm> // std::swap
+
+namespace Rio
+{
+	// Sort, scan, reduce and partition split in blocks run by the workers of a JobSystem.
+	// Below PARALLEL_MIN_COUNT items, or with a single thread, they run on the calling thread.
+	//
+	// They wait for their blocks like JobSystem::wait(), they are called from the threads of the
+	// JobSystem only. Items are copied with operator=, scratch buffers are taken from the allocator.
+	namespace ParallelFn
+	{
+		// Below this many items the algorithms do not split
+		const uint32_t PARALLEL_MIN_COUNT = 4096;
+
+		// Stable merge sort of items with compare, scratch holds a copy of count items
+		template <typename T, typename Compare> void sort(JobSystem& jobSystem, T* items, uint32_t count, Allocator& a, Compare compare);
+		template <typename T> void sort(JobSystem& jobSystem, T* items, uint32_t count, Allocator& a);
+		template <typename T, typename Compare> void sort(JobSystem& jobSystem, Array<T>& items, Compare compare);
+		template <typename T> void sort(JobSystem& jobSystem, Array<T>& items);
+
+		// Stable LSD radix sort of unsigned 32 or 64 bits keys, values are moved along with their key.
+		// Passes whose byte is the same in all the keys are skipped.
+		template <typename TKey, typename TValue> void radixSort(JobSystem& jobSystem, TKey* keys, TValue* values, uint32_t count, Allocator& a);
+		template <typename TKey> void radixSort(JobSystem& jobSystem, TKey* keys, uint32_t count, Allocator& a);
+		template <typename TKey, typename TValue> void radixSort(JobSystem& jobSystem, Array<TKey>& keys, Array<TValue>& values);
+		template <typename TKey> void radixSort(JobSystem& jobSystem, Array<TKey>& keys);
+
+		// Returns init combined with all the items, reduce must be associative
+		template <typename T, typename Reduce> T reduce(JobSystem& jobSystem, const T* items, uint32_t count, const T& init, Reduce reduce);
+		template <typename T, typename Reduce> T reduce(JobSystem& jobSystem, const Array<T>& items, const T& init, Reduce reduce);
+
+		// Writes to output[i] the sum of init and the items before i, output may be items.
+		// Returns the sum of init and all the items.
+		template <typename T> T exclusiveScan(JobSystem& jobSystem, const T* items, uint32_t count, T* output, const T& init);
+		// Writes to output[i] the sum of init and the items up to i included, output may be items
+		template <typename T> void inclusiveScan(JobSystem& jobSystem, const T* items, uint32_t count, T* output, const T& init);
+
+		// Moves the items for which predicate is true before the others, keeping their order in both parts.
+		// Returns the number of items for which predicate is true. predicate is called twice per item.
+		template <typename T, typename Predicate> uint32_t stablePartition(JobSystem& jobSystem, T* items, uint32_t count, Allocator& a, Predicate predicate);
+		template <typename T, typename Predicate> uint32_t stablePartition(JobSystem& jobSystem, Array<T>& items, Predicate predicate);
+
+		// Copies the items for which predicate is true to output in order and returns their number.
+		// output has room for count items and does not overlap items. predicate is called twice per item.
+		template <typename T, typename Predicate> uint32_t compact(JobSystem& jobSystem, const T* items, uint32_t count, T* output, Predicate predicate);
+		// Resizes output to the items kept
+		template <typename T, typename Predicate> void compact(JobSystem& jobSystem, const Array<T>& items, Array<T>& output, Predicate predicate);
+	} // namespace ParallelFn
+
+	namespace ParallelInternalFn
+	{
+		// A few blocks per thread, the ones done early steal the others
+		const uint32_t MAX_BLOCKS = 64;
+		const uint32_t MIN_BLOCK_SIZE = 1024;
+		// Sorted by insertion before the merge passes
+		const uint32_t SORT_RUN_SIZE = 32;
+		const uint32_t RADIX_BITS = 8;
+		const uint32_t RADIX_SIZE = 1 << RADIX_BITS;
+
+		inline uint32_t getBlocksCount(const JobSystem& jobSystem, uint32_t count)
+		{
+			if (count < ParallelFn::PARALLEL_MIN_COUNT || jobSystem.getThreadsCount() == 1)
+			{
+				return 1;
+			}
+			uint32_t blocksCount = jobSystem.getThreadsCount() * 4;
+			blocksCount = blocksCount < MAX_BLOCKS ? blocksCount : MAX_BLOCKS;
+			const uint32_t maxBlocksCount = count / MIN_BLOCK_SIZE;
+			return blocksCount < maxBlocksCount ? blocksCount : maxBlocksCount;
+		}
+
+		// Returns the items [first, last) of the block, the blocks differ by one item at most
+		inline void getBlock(uint32_t count, uint32_t blocksCount, uint32_t block, uint32_t& first, uint32_t& last)
+		{
+			first = uint32_t(uint64_t(count) * block / blocksCount);
+			last = uint32_t(uint64_t(count) * (block + 1) / blocksCount);
+		}
+
+		// Returns the items [first, last) of the blocks [firstBlock, lastBlock)
+		inline void getBlocks(uint32_t count, uint32_t blocksCount, uint32_t firstBlock, uint32_t lastBlock, uint32_t& first, uint32_t& last)
+		{
+			first = uint32_t(uint64_t(count) * firstBlock / blocksCount);
+			last = uint32_t(uint64_t(count) * lastBlock / blocksCount);
+		}
+
+		// Calls function on the blocks [0, blocksCount) and waits for them
+		inline void runBlocks(JobSystem& jobSystem, uint32_t blocksCount, ParallelForFunction function, void* data)
+		{
+			if (blocksCount == 1)
+			{
+				function(0, 1, data);
+				return;
+			}
+			jobSystem.wait(jobSystem.parallelFor(blocksCount, function, data, 1));
+		}
+
+		template <typename T>
+		struct CopyData
+		{
+			const T* source;
+			T* destination;
+			uint32_t count;
+			uint32_t blocksCount;
+		};
+
+		template <typename T>
+		void copyBlocks(uint32_t firstBlock, uint32_t lastBlock, void* data)
+		{
+			const CopyData<T>& copy = *(const CopyData<T>*)data;
+			uint32_t first;
+			uint32_t last;
+			getBlocks(copy.count, copy.blocksCount, firstBlock, lastBlock, first, last);
+			for (uint32_t i = first; i < last; ++i)
+			{
+				copy.destination[i] = copy.source[i];
+			}
+		}
+
+		template <typename T>
+		void copy(JobSystem& jobSystem, const T* source, T* destination, uint32_t count)
+		{
+			CopyData<T> copyData;
+			copyData.source = source;
+			copyData.destination = destination;
+			copyData.count = count;
+			copyData.blocksCount = getBlocksCount(jobSystem, count);
+			runBlocks(jobSystem, copyData.blocksCount, copyBlocks<T>, &copyData);
+		}
+
+		template <typename T, typename Compare>
+		struct SortData
+		{
+			T* source;
+			T* destination;
+			uint32_t count;
+			uint32_t blocksCount;
+			// Size of the sorted runs merged by pairs
+			uint32_t runSize;
+			Compare* compare;
+		};
+
+		template <typename T, typename Compare>
+		void sortRunBlocks(uint32_t firstBlock, uint32_t lastBlock, void* data)
+		{
+			const SortData<T, Compare>& sortData = *(const SortData<T, Compare>*)data;
+			const uint32_t runsCount = (sortData.count + SORT_RUN_SIZE - 1) / SORT_RUN_SIZE;
+			Compare& compare = *sortData.compare;
+			for (uint32_t block = firstBlock; block < lastBlock; ++block)
+			{
+				uint32_t firstRun;
+				uint32_t lastRun;
+				getBlock(runsCount, sortData.blocksCount, block, firstRun, lastRun);
+				for (uint32_t run = firstRun; run < lastRun; ++run)
+				{
+					T* items = sortData.source + run * SORT_RUN_SIZE;
+					const uint32_t count = run + 1 < runsCount ? SORT_RUN_SIZE : sortData.count - run * SORT_RUN_SIZE;
+					for (uint32_t i = 1; i < count; ++i)
+					{
+						const T item = items[i];
+						uint32_t j = i;
+						for (; j > 0 && compare(item, items[j - 1]); --j)
+						{
+							items[j] = items[j - 1];
+						}
+						items[j] = item;
+					}
+				}
+			}
+		}
+
+		// Returns the number of items of a among the first outputs of the stable merge of a and b
+		template <typename T, typename Compare>
+		uint32_t getMergeSplit(const T* a, uint32_t aCount, const T* b, uint32_t bCount, uint32_t outputs, Compare& compare)
+		{
+			uint32_t low = outputs > bCount ? outputs - bCount : 0;
+			uint32_t high = outputs < aCount ? outputs : aCount;
+			while (low < high)
+			{
+				const uint32_t middle = low + (high - low) / 2;
+				// Ties are taken from a first
+				if (!compare(b[outputs - middle - 1], a[middle]))
+				{
+					low = middle + 1;
+				}
+				else
+				{
+					high = middle;
+				}
+			}
+			return low;
+		}
+
+		// Each block writes its range of the output of a merge pass, it finds where its range starts
+		// in the two runs with a binary search so that the last passes are split as much as the first ones
+		template <typename T, typename Compare>
+		void mergeBlocks(uint32_t firstBlock, uint32_t lastBlock, void* data)
+		{
+			const SortData<T, Compare>& sortData = *(const SortData<T, Compare>*)data;
+			Compare& compare = *sortData.compare;
+			uint32_t position;
+			uint32_t last;
+			getBlocks(sortData.count, sortData.blocksCount, firstBlock, lastBlock, position, last);
+
+			const uint32_t pairSize = 2 * sortData.runSize;
+			while (position < last)
+			{
+				const uint32_t pairFirst = position - position % pairSize;
+				const uint32_t pairMiddle = pairFirst + sortData.runSize < sortData.count ? pairFirst + sortData.runSize : sortData.count;
+				const uint32_t pairLast = pairFirst + pairSize < sortData.count ? pairFirst + pairSize : sortData.count;
+				const T* a = sortData.source + pairFirst;
+				const T* b = sortData.source + pairMiddle;
+				const uint32_t aCount = pairMiddle - pairFirst;
+				const uint32_t bCount = pairLast - pairMiddle;
+
+				uint32_t i = getMergeSplit(a, aCount, b, bCount, position - pairFirst, compare);
+				uint32_t j = position - pairFirst - i;
+				const uint32_t end = last < pairLast ? last : pairLast;
+				for (; position < end; ++position)
+				{
+					if (j == bCount || (i < aCount && !compare(b[j], a[i])))
+					{
+						sortData.destination[position] = a[i++];
+					}
+					else
+					{
+						sortData.destination[position] = b[j++];
+					}
+				}
+			}
+		}
+
+		template <typename TKey, typename TValue>
+		struct RadixSortData
+		{
+			TKey* keys;
+			TValue* values;
+			TKey* keysDestination;
+			TValue* valuesDestination;
+			uint32_t count;
+			uint32_t blocksCount;
+			uint32_t shift;
+			// RADIX_SIZE counts per block, then the output positions of the block per radix
+			uint32_t* histograms;
+		};
+
+		template <typename TKey, typename TValue>
+		void radixHistogramBlocks(uint32_t firstBlock, uint32_t lastBlock, void* data)
+		{
+			const RadixSortData<TKey, TValue>& sortData = *(const RadixSortData<TKey, TValue>*)data;
+			for (uint32_t block = firstBlock; block < lastBlock; ++block)
+			{
+				uint32_t first;
+				uint32_t last;
+				getBlock(sortData.count, sortData.blocksCount, block, first, last);
+				uint32_t* histogram = sortData.histograms + block * RADIX_SIZE;
+				for (uint32_t i = 0; i < RADIX_SIZE; ++i)
+				{
+					histogram[i] = 0;
+				}
+				for (uint32_t i = first; i < last; ++i)
+				{
+					++histogram[(sortData.keys[i] >> sortData.shift) & (RADIX_SIZE - 1)];
+				}
+			}
+		}
+
+		template <typename TKey, typename TValue>
+		void radixScatterBlocks(uint32_t firstBlock, uint32_t lastBlock, void* data)
+		{
+			const RadixSortData<TKey, TValue>& sortData = *(const RadixSortData<TKey, TValue>*)data;
+			for (uint32_t block = firstBlock; block < lastBlock; ++block)
+			{
+				uint32_t first;
+				uint32_t last;
+				getBlock(sortData.count, sortData.blocksCount, block, first, last);
+				uint32_t* positions = sortData.histograms + block * RADIX_SIZE;
+				for (uint32_t i = first; i < last; ++i)
+				{
+					const TKey key = sortData.keys[i];
+					const uint32_t position = positions[(key >> sortData.shift) & (RADIX_SIZE - 1)]++;
+					sortData.keysDestination[position] = key;
+					if (sortData.values != nullptr)
+					{
+						sortData.valuesDestination[position] = sortData.values[i];
+					}
+				}
+			}
+		}
+
+		template <typename TKey, typename TValue>
+		void radixSort(JobSystem& jobSystem, TKey* keys, TValue* values, uint32_t count, Allocator& a)
+		{
+			static_assert(std::is_integral<TKey>::value && std::is_unsigned<TKey>::value, "Keys must be unsigned integers");
+			if (count < 2)
+			{
+				return;
+			}
+
+			RadixSortData<TKey, TValue> sortData;
+			sortData.keys = keys;
+			sortData.values = values;
+			sortData.keysDestination = (TKey*)a.allocate(count * sizeof(TKey), alignof(TKey));
+			sortData.valuesDestination = values != nullptr ? (TValue*)a.allocate(count * sizeof(TValue), alignof(TValue)) : nullptr;
+			sortData.count = count;
+			sortData.blocksCount = getBlocksCount(jobSystem, count);
+			sortData.histograms = (uint32_t*)a.allocate(sortData.blocksCount * RADIX_SIZE * sizeof(uint32_t), alignof(uint32_t));
+			TKey* keysScratch = sortData.keysDestination;
+			TValue* valuesScratch = sortData.valuesDestination;
+
+			for (sortData.shift = 0; sortData.shift < sizeof(TKey) * 8; sortData.shift += RADIX_BITS)
+			{
+				runBlocks(jobSystem, sortData.blocksCount, radixHistogramBlocks<TKey, TValue>, &sortData);
+
+				// Turns the counts into the positions where each block writes each radix,
+				// the blocks of a radix follow each other so that the sort is stable
+				uint32_t position = 0;
+				bool isSkipped = false;
+				for (uint32_t radix = 0; radix < RADIX_SIZE && !isSkipped; ++radix)
+				{
+					const uint32_t radixFirst = position;
+					for (uint32_t block = 0; block < sortData.blocksCount; ++block)
+					{
+						uint32_t& histogram = sortData.histograms[block * RADIX_SIZE + radix];
+						const uint32_t blockCount = histogram;
+						histogram = position;
+						position += blockCount;
+					}
+					// All the keys have this radix, the pass would not move them
+					isSkipped = radixFirst == 0 && position == count;
+				}
+				if (isSkipped)
+				{
+					continue;
+				}
+
+				runBlocks(jobSystem, sortData.blocksCount, radixScatterBlocks<TKey, TValue>, &sortData);
+				std::swap(sortData.keys, sortData.keysDestination);
+				std::swap(sortData.values, sortData.valuesDestination);
+			}
+
+			if (sortData.keys != keys)
+			{
+				copy(jobSystem, (const TKey*)sortData.keys, keys, count);
+				if (values != nullptr)
+				{
+					copy(jobSystem, (const TValue*)sortData.values, values, count);
+				}
+			}
+
+			a.deallocate(sortData.histograms);
+			if (valuesScratch != nullptr)
+			{
+				a.deallocate(valuesScratch);
+			}
+			a.deallocate(keysScratch);
+		}
+
+		template <typename T, typename Reduce>
+		struct ReduceData
+		{
+			const T* items;
+			uint32_t count;
+			uint32_t blocksCount;
+			Reduce* reduce;
+			T partials[MAX_BLOCKS];
+		};
+
+		template <typename T, typename Reduce>
+		void reduceBlocks(uint32_t firstBlock, uint32_t lastBlock, void* data)
+		{
+			ReduceData<T, Reduce>& reduceData = *(ReduceData<T, Reduce>*)data;
+			for (uint32_t block = firstBlock; block < lastBlock; ++block)
+			{
+				uint32_t first;
+				uint32_t last;
+				getBlock(reduceData.count, reduceData.blocksCount, block, first, last);
+				T partial = reduceData.items[first];
+				for (uint32_t i = first + 1; i < last; ++i)
+				{
+					partial = (*reduceData.reduce)(partial, reduceData.items[i]);
+				}
+				reduceData.partials[block] = partial;
+			}
+		}
+
+		template <typename T>
+		struct Sum
+		{
+			T operator()(const T& a, const T& b) const
+			{
+				return a + b;
+			}
+		};
+
+		template <typename T>
+		struct ScanData
+		{
+			const T* items;
+			T* output;
+			uint32_t count;
+			uint32_t blocksCount;
+			bool isInclusive;
+			// Sum before each block, then the sum up to its end
+			T sums[MAX_BLOCKS];
+		};
+
+		template <typename T>
+		void scanBlocks(uint32_t firstBlock, uint32_t lastBlock, void* data)
+		{
+			ScanData<T>& scanData = *(ScanData<T>*)data;
+			for (uint32_t block = firstBlock; block < lastBlock; ++block)
+			{
+				uint32_t first;
+				uint32_t last;
+				getBlock(scanData.count, scanData.blocksCount, block, first, last);
+				T sum = scanData.sums[block];
+				for (uint32_t i = first; i < last; ++i)
+				{
+					// Read before the write, output may be items
+					const T item = scanData.items[i];
+					if (scanData.isInclusive)
+					{
+						sum = sum + item;
+						scanData.output[i] = sum;
+					}
+					else
+					{
+						scanData.output[i] = sum;
+						sum = sum + item;
+					}
+				}
+				scanData.sums[block] = sum;
+			}
+		}
+
+		// Returns the sum of init and all the items
+		template <typename T>
+		T scan(JobSystem& jobSystem, const T* items, uint32_t count, T* output, const T& init, bool isInclusive)
+		{
+			ScanData<T> scanData;
+			scanData.items = items;
+			scanData.output = output;
+			scanData.count = count;
+			scanData.blocksCount = getBlocksCount(jobSystem, count);
+			scanData.isInclusive = isInclusive;
+
+			scanData.sums[0] = init;
+			if (scanData.blocksCount > 1)
+			{
+				// Sums of the blocks, scanned on the calling thread, then each block is scanned from its sum
+				Sum<T> add;
+				ReduceData<T, Sum<T> > reduceData;
+				reduceData.items = items;
+				reduceData.count = count;
+				reduceData.blocksCount = scanData.blocksCount;
+				reduceData.reduce = &add;
+				runBlocks(jobSystem, reduceData.blocksCount, reduceBlocks<T, Sum<T> >, &reduceData);
+				for (uint32_t block = 1; block < scanData.blocksCount; ++block)
+				{
+					scanData.sums[block] = scanData.sums[block - 1] + reduceData.partials[block - 1];
+				}
+			}
+			runBlocks(jobSystem, scanData.blocksCount, scanBlocks<T>, &scanData);
+			return scanData.sums[scanData.blocksCount - 1];
+		}
+
+		template <typename T, typename Predicate>
+		struct PartitionData
+		{
+			const T* items;
+			T* output;
+			uint32_t count;
+			uint32_t blocksCount;
+			Predicate* predicate;
+			// Whether the items failing predicate are written after the others
+			bool isPartition;
+			// Items passing predicate per block, then the position of the first of them
+			uint32_t passed[MAX_BLOCKS];
+			uint32_t passedCount;
+		};
+
+		template <typename T, typename Predicate>
+		void countPassedBlocks(uint32_t firstBlock, uint32_t lastBlock, void* data)
+		{
+			PartitionData<T, Predicate>& partitionData = *(PartitionData<T, Predicate>*)data;
+			for (uint32_t block = firstBlock; block < lastBlock; ++block)
+			{
+				uint32_t first;
+				uint32_t last;
+				getBlock(partitionData.count, partitionData.blocksCount, block, first, last);
+				uint32_t passed = 0;
+				for (uint32_t i = first; i < last; ++i)
+				{
+					passed += (*partitionData.predicate)(partitionData.items[i]) ? 1 : 0;
+				}
+				partitionData.passed[block] = passed;
+			}
+		}
+
+		template <typename T, typename Predicate>
+		void partitionBlocks(uint32_t firstBlock, uint32_t lastBlock, void* data)
+		{
+			const PartitionData<T, Predicate>& partitionData = *(const PartitionData<T, Predicate>*)data;
+			for (uint32_t block = firstBlock; block < lastBlock; ++block)
+			{
+				uint32_t first;
+				uint32_t last;
+				getBlock(partitionData.count, partitionData.blocksCount, block, first, last);
+				uint32_t passedPosition = partitionData.passed[block];
+				// The items failing predicate in the blocks before are the ones which did not pass
+				uint32_t failedPosition = partitionData.passedCount + first - passedPosition;
+				for (uint32_t i = first; i < last; ++i)
+				{
+					if ((*partitionData.predicate)(partitionData.items[i]))
+					{
+						partitionData.output[passedPosition++] = partitionData.items[i];
+					}
+					else if (partitionData.isPartition)
+					{
+						partitionData.output[failedPosition++] = partitionData.items[i];
+					}
+				}
+			}
+		}
+
+		// Writes the items passing predicate to output, then the others with isPartition, returns the number passing
+		template <typename T, typename Predicate>
+		uint32_t partition(JobSystem& jobSystem, const T* items, uint32_t count, T* output, Predicate& predicate, bool isPartition)
+		{
+			PartitionData<T, Predicate> partitionData;
+			partitionData.items = items;
+			partitionData.output = output;
+			partitionData.count = count;
+			partitionData.blocksCount = getBlocksCount(jobSystem, count);
+			partitionData.predicate = &predicate;
+			partitionData.isPartition = isPartition;
+
+			runBlocks(jobSystem, partitionData.blocksCount, countPassedBlocks<T, Predicate>, &partitionData);
+			uint32_t passedCount = 0;
+			for (uint32_t block = 0; block < partitionData.blocksCount; ++block)
+			{
+				const uint32_t passed = partitionData.passed[block];
+				partitionData.passed[block] = passedCount;
+				passedCount += passed;
+			}
+			partitionData.passedCount = passedCount;
+			runBlocks(jobSystem, partitionData.blocksCount, partitionBlocks<T, Predicate>, &partitionData);
+			return passedCount;
+		}
+	} // namespace ParallelInternalFn
+
+	namespace ParallelFn
+	{
+		template <typename T, typename Compare>
+		inline void sort(JobSystem& jobSystem, T* items, uint32_t count, Allocator& a, Compare compare)
+		{
+			using namespace ParallelInternalFn;
+
+			SortData<T, Compare> sortData;
+			sortData.source = items;
+			sortData.destination = nullptr;
+			sortData.count = count;
+			sortData.blocksCount = getBlocksCount(jobSystem, count);
+			sortData.compare = &compare;
+			runBlocks(jobSystem, sortData.blocksCount, sortRunBlocks<T, Compare>, &sortData);
+			if (count <= SORT_RUN_SIZE)
+			{
+				return;
+			}
+
+			// Merges pairs of runs back and forth between the items and the scratch
+			T* scratch = (T*)a.allocate(count * sizeof(T), alignof(T));
+			sortData.destination = scratch;
+			for (sortData.runSize = SORT_RUN_SIZE; sortData.runSize < count; sortData.runSize *= 2)
+			{
+				runBlocks(jobSystem, sortData.blocksCount, mergeBlocks<T, Compare>, &sortData);
+				std::swap(sortData.source, sortData.destination);
+			}
+			if (sortData.source != items)
+			{
+				copy(jobSystem, (const T*)sortData.source, items, count);
+			}
+			a.deallocate(scratch);
+		}
+
+		template <typename T>
+		inline void sort(JobSystem& jobSystem, T* items, uint32_t count, Allocator& a)
+		{
+			sort(jobSystem, items, count, a, less<T>());
+		}
+
+		template <typename T, typename Compare>
+		inline void sort(JobSystem& jobSystem, Array<T>& items, Compare compare)
+		{
+			sort(jobSystem, ArrayFn::begin(items), uint32_t(ArrayFn::getCount(items)), *items.allocator, compare);
+		}
+
+		template <typename T>
+		inline void sort(JobSystem& jobSystem, Array<T>& items)
+		{
+			sort(jobSystem, items, less<T>());
+		}
+
+		template <typename TKey, typename TValue>
+		inline void radixSort(JobSystem& jobSystem, TKey* keys, TValue* values, uint32_t count, Allocator& a)
+		{
+			RIO_ASSERT(count == 0 || values != nullptr, "Values must not be null");
+			ParallelInternalFn::radixSort(jobSystem, keys, values, count, a);
+		}
+
+		template <typename TKey>
+		inline void radixSort(JobSystem& jobSystem, TKey* keys, uint32_t count, Allocator& a)
+		{
+			ParallelInternalFn::radixSort(jobSystem, keys, (char*)nullptr, count, a);
+		}
+
+		template <typename TKey, typename TValue>
+		inline void radixSort(JobSystem& jobSystem, Array<TKey>& keys, Array<TValue>& values)
+		{
+			RIO_ASSERT(ArrayFn::getCount(keys) == ArrayFn::getCount(values), "Keys and values differ in count");
+			ParallelInternalFn::radixSort(jobSystem, ArrayFn::begin(keys), ArrayFn::begin(values), uint32_t(ArrayFn::getCount(keys)), *keys.allocator);
+		}
+
+		template <typename TKey>
+		inline void radixSort(JobSystem& jobSystem, Array<TKey>& keys)
+		{
+			ParallelInternalFn::radixSort(jobSystem, ArrayFn::begin(keys), (char*)nullptr, uint32_t(ArrayFn::getCount(keys)), *keys.allocator);
+		}
+
+		template <typename T, typename Reduce>
+		inline T reduce(JobSystem& jobSystem, const T* items, uint32_t count, const T& init, Reduce reduce)
+		{
+			using namespace ParallelInternalFn;
+
+			if (count == 0)
+			{
+				return init;
+			}
+			ReduceData<T, Reduce> reduceData;
+			reduceData.items = items;
+			reduceData.count = count;
+			reduceData.blocksCount = getBlocksCount(jobSystem, count);
+			reduceData.reduce = &reduce;
+			runBlocks(jobSystem, reduceData.blocksCount, reduceBlocks<T, Reduce>, &reduceData);
+
+			T result = init;
+			for (uint32_t block = 0; block < reduceData.blocksCount; ++block)
+			{
+				result = reduce(result, reduceData.partials[block]);
+			}
+			return result;
+		}
+
+		template <typename T, typename Reduce>
+		inline T reduce(JobSystem& jobSystem, const Array<T>& items, const T& init, Reduce reduce)
+		{
+			return ParallelFn::reduce(jobSystem, ArrayFn::begin(items), uint32_t(ArrayFn::getCount(items)), init, reduce);
+		}
+
+		template <typename T>
+		inline T exclusiveScan(JobSystem& jobSystem, const T* items, uint32_t count, T* output, const T& init)
+		{
+			return ParallelInternalFn::scan(jobSystem, items, count, output, init, false);
+		}
+
+		template <typename T>
+		inline void inclusiveScan(JobSystem& jobSystem, const T* items, uint32_t count, T* output, const T& init)
+		{
+			ParallelInternalFn::scan(jobSystem, items, count, output, init, true);
+		}
+
+		template <typename T, typename Predicate>
+		inline uint32_t stablePartition(JobSystem& jobSystem, T* items, uint32_t count, Allocator& a, Predicate predicate)
+		{
+			T* scratch = (T*)a.allocate(count * sizeof(T), alignof(T));
+			const uint32_t passedCount = ParallelInternalFn::partition(jobSystem, (const T*)items, count, scratch, predicate, true);
+			ParallelInternalFn::copy(jobSystem, (const T*)scratch, items, count);
+			a.deallocate(scratch);
+			return passedCount;
+		}
+
+		template <typename T, typename Predicate>
+		inline uint32_t stablePartition(JobSystem& jobSystem, Array<T>& items, Predicate predicate)
+		{
+			return stablePartition(jobSystem, ArrayFn::begin(items), uint32_t(ArrayFn::getCount(items)), *items.allocator, predicate);
+		}
+
+		template <typename T, typename Predicate>
+		inline uint32_t compact(JobSystem& jobSystem, const T* items, uint32_t count, T* output, Predicate predicate)
+		{
+			return ParallelInternalFn::partition(jobSystem, items, count, output, predicate, false);
+		}
+
+		template <typename T, typename Predicate>
+		inline void compact(JobSystem& jobSystem, const Array<T>& items, Array<T>& output, Predicate predicate)
+		{
+			ArrayFn::resize(output, ArrayFn::getCount(items));
+			const uint32_t keptCount = compact(jobSystem, ArrayFn::begin(items), uint32_t(ArrayFn::getCount(items)), ArrayFn::begin(output), predicate);
+			ArrayFn::resize(output, keptCount);
+		}
+	} // namespace ParallelFn
+
+} // namespace Rio
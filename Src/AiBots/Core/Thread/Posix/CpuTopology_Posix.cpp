@@ -0,0 +1,278 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/Thread/CpuTopology.h"
+#include "Core/Base/Platform.h"
+
+#if RIO_PLATFORM_POSIX
+
+#include <fcntl.h> // open
+#include <stdio.h> // snprintf
+#include <string.h> // memset, memcmp, strncmp
+#include <unistd.h> // read, close, sysconf
+
+namespace Rio
+{
+
+namespace CpuTopologyFn
+{
+	// Every logical processor is its own core
+	static void queryFallback(CpuTopology& topology)
+	{
+		const long count = sysconf(_SC_NPROCESSORS_ONLN);
+		topology.cpusCount = count > 0 ? uint32_t(count) : 1;
+		if (topology.cpusCount > CpuSet::MAX_CPUS)
+		{
+			topology.cpusCount = CpuSet::MAX_CPUS;
+		}
+		for (uint32_t i = 0; i < topology.cpusCount; ++i)
+		{
+			CpuSetFn::add(topology.onlineCpus, i);
+			topology.cpus[i].core = uint16_t(i);
+		}
+		topology.coresCount = topology.cpusCount;
+		topology.packagesCount = 1;
+		topology.numaNodesCount = 1;
+	}
+
+#if RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID
+	// Reads a small sysfs file, the content ends with a '\0'
+	static bool readFile(const char* path, char* buffer, size_t size)
+	{
+		const int fd = open(path, O_RDONLY | O_CLOEXEC);
+		if (fd == -1)
+		{
+			return false;
+		}
+		const ssize_t bytesRead = read(fd, buffer, size - 1);
+		close(fd);
+		if (bytesRead <= 0)
+		{
+			return false;
+		}
+		buffer[bytesRead] = '\0';
+		return true;
+	}
+
+	static const char* parseUint(const char* str, uint32_t& value)
+	{
+		value = 0;
+		while (*str >= '0' && *str <= '9')
+		{
+			value = value * 10 + uint32_t(*str - '0');
+			++str;
+		}
+		return str;
+	}
+
+	static bool readUint(const char* path, uint32_t& value)
+	{
+		char buffer[64];
+		if (!readFile(path, buffer, sizeof(buffer)) || buffer[0] < '0' || buffer[0] > '9')
+		{
+			return false;
+		}
+		const char* end = parseUint(buffer, value);
+		// Sizes are like "32K"
+		if (*end == 'K')
+		{
+			value *= 1024;
+		}
+		else if (*end == 'M')
+		{
+			value *= 1024 * 1024;
+		}
+		return true;
+	}
+
+	// Parses lists like "0-3,8,10-11"
+	static bool readCpuList(const char* path, CpuSet& cpus)
+	{
+		CpuSetFn::clear(cpus);
+		char buffer[1024];
+		if (!readFile(path, buffer, sizeof(buffer)))
+		{
+			return false;
+		}
+		const char* str = buffer;
+		while (*str >= '0' && *str <= '9')
+		{
+			uint32_t first = 0;
+			uint32_t last = 0;
+			str = parseUint(str, first);
+			last = first;
+			if (*str == '-')
+			{
+				str = parseUint(str + 1, last);
+			}
+			for (uint32_t i = first; i <= last && i < CpuSet::MAX_CPUS; ++i)
+			{
+				CpuSetFn::add(cpus, i);
+			}
+			if (*str == ',')
+			{
+				++str;
+			}
+		}
+		return true;
+	}
+
+	static void readCaches(CpuTopology& topology, uint32_t cpu)
+	{
+		char path[128];
+		for (uint32_t index = 0; topology.cachesCount < CpuTopology::MAX_CACHES; ++index)
+		{
+			CpuCache cache;
+			snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/level", cpu, index);
+			if (!readUint(path, cache.level))
+			{
+				return;
+			}
+			snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/shared_cpu_list", cpu, index);
+			if (!readCpuList(path, cache.cpus))
+			{
+				CpuSetFn::clear(cache.cpus);
+				CpuSetFn::add(cache.cpus, cpu);
+			}
+			char type[32];
+			snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/type", cpu, index);
+			if (!readFile(path, type, sizeof(type)))
+			{
+				type[0] = '\0';
+			}
+			cache.type = strncmp(type, "Data", 4) == 0 ? CpuCacheType::DATA
+				: strncmp(type, "Instruction", 11) == 0 ? CpuCacheType::INSTRUCTION
+				: CpuCacheType::UNIFIED;
+			snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/size", cpu, index);
+			if (!readUint(path, cache.size))
+			{
+				cache.size = 0;
+			}
+			snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/coherency_line_size", cpu, index);
+			if (!readUint(path, cache.lineSize))
+			{
+				cache.lineSize = RIO_CACHE_LINE_SIZE;
+			}
+
+			// A shared cache is listed by each of its cpus
+			bool isKnown = false;
+			for (uint32_t i = 0; i < topology.cachesCount && !isKnown; ++i)
+			{
+				const CpuCache& known = topology.caches[i];
+				isKnown = known.level == cache.level
+					&& known.type == cache.type
+					&& memcmp(known.cpus.bits, cache.cpus.bits, sizeof(cache.cpus.bits)) == 0;
+			}
+			if (!isKnown)
+			{
+				topology.caches[topology.cachesCount++] = cache;
+			}
+		}
+	}
+#endif // RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID
+
+	void query(CpuTopology& topology)
+	{
+		memset(&topology, 0, sizeof(topology));
+
+#if RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID
+		if (!readCpuList("/sys/devices/system/cpu/online", topology.onlineCpus)
+			|| CpuSetFn::getIsEmpty(topology.onlineCpus))
+		{
+			queryFallback(topology);
+			return;
+		}
+
+		// OS ids of the cores and packages seen so far, indexed by their number in the topology
+		uint32_t packageIds[CpuSet::MAX_CPUS];
+		uint32_t corePackages[CpuSet::MAX_CPUS];
+		uint32_t coreIds[CpuSet::MAX_CPUS];
+		uint16_t coreThreadsCounts[CpuSet::MAX_CPUS];
+
+		char path[128];
+		for (uint32_t cpu = 0; cpu < CpuSet::MAX_CPUS; ++cpu)
+		{
+			if (!CpuSetFn::has(topology.onlineCpus, cpu))
+			{
+				continue;
+			}
+			++topology.cpusCount;
+
+			uint32_t packageId = 0;
+			uint32_t coreId = cpu;
+			snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/physical_package_id", cpu);
+			readUint(path, packageId);
+			snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/core_id", cpu);
+			readUint(path, coreId);
+
+			uint32_t package = 0;
+			while (package < topology.packagesCount && packageIds[package] != packageId)
+			{
+				++package;
+			}
+			if (package == topology.packagesCount)
+			{
+				packageIds[topology.packagesCount++] = packageId;
+			}
+
+			// Core ids are only unique in their package
+			uint32_t core = 0;
+			while (core < topology.coresCount && (corePackages[core] != package || coreIds[core] != coreId))
+			{
+				++core;
+			}
+			if (core == topology.coresCount)
+			{
+				corePackages[core] = package;
+				coreIds[core] = coreId;
+				coreThreadsCounts[core] = 0;
+				++topology.coresCount;
+			}
+
+			Cpu& info = topology.cpus[cpu];
+			info.core = uint16_t(core);
+			info.package = uint16_t(package);
+			info.numaNode = 0;
+			info.smtIndex = coreThreadsCounts[core]++;
+
+			readCaches(topology, cpu);
+		}
+
+		// Kernels built without NUMA have no node directory, everything is node 0
+		topology.numaNodesCount = 1;
+		CpuSet nodes;
+		if (readCpuList("/sys/devices/system/node/online", nodes))
+		{
+			topology.numaNodesCount = 0;
+			for (uint32_t node = 0; node < CpuSet::MAX_CPUS; ++node)
+			{
+				if (!CpuSetFn::has(nodes, node))
+				{
+					continue;
+				}
+				CpuSet nodeCpus;
+				snprintf(path, sizeof(path), "/sys/devices/system/node/node%u/cpulist", node);
+				if (readCpuList(path, nodeCpus))
+				{
+					for (uint32_t cpu = 0; cpu < CpuSet::MAX_CPUS; ++cpu)
+					{
+						if (CpuSetFn::has(nodeCpus, cpu))
+						{
+							topology.cpus[cpu].numaNode = uint16_t(topology.numaNodesCount);
+						}
+					}
+				}
+				++topology.numaNodesCount;
+			}
+			if (topology.numaNodesCount == 0)
+			{
+				topology.numaNodesCount = 1;
+			}
+		}
+#else
+		queryFallback(topology);
+#endif // RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID
+	}
+} // namespace CpuTopologyFn
+
+} // namespace Rio
+
+#endif // RIO_PLATFORM_POSIX
@@ -0,0 +1,204 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+// Must come before any system header, OSX hides ucontext without it
+#if defined(__APPLE__) && !defined(_XOPEN_SOURCE)
+	#define _XOPEN_SOURCE 700
+	#define _DARWIN_C_SOURCE
+#endif // defined(__APPLE__) && !defined(_XOPEN_SOURCE)
+
+#include "Core/Thread/Fiber.h"
+
+#if RIO_PLATFORM_POSIX
+
+#include "Core/Debug/Error.h"
+
+#include <errno.h> // errno
+#include <sys/mman.h> // mmap, mprotect
+#include <unistd.h> // sysconf
+
+#if !RIO_FIBER_ASM
+	#include "Core/Memory/Memory.h"
+	#include <ucontext.h>
+#endif // !RIO_FIBER_ASM
+
+#if RIO_FIBER_ASM
+// Pushes the callee-saved registers and the FPU control words of the SysV ABI on the stack of the
+// running fiber, saves its stack pointer to fromStackPointer and pops the ones of the other fiber.
+extern "C" void rioFiberSwitch(void** fromStackPointer, void* toStackPointer);
+// First return address of a new fiber, calls r12 with r13
+extern "C" void rioFiberStart();
+
+asm(
+	".text\n"
+	".globl rioFiberSwitch\n"
+	".hidden rioFiberSwitch\n"
+	".type rioFiberSwitch, @function\n"
+	".p2align 4\n"
+	"rioFiberSwitch:\n"
+	"	pushq %rbp\n"
+	"	pushq %rbx\n"
+	"	pushq %r12\n"
+	"	pushq %r13\n"
+	"	pushq %r14\n"
+	"	pushq %r15\n"
+	"	subq $16, %rsp\n"
+	"	stmxcsr 8(%rsp)\n"
+	"	fnstcw (%rsp)\n"
+	"	movq %rsp, (%rdi)\n"
+	"	movq %rsi, %rsp\n"
+	"	fldcw (%rsp)\n"
+	"	ldmxcsr 8(%rsp)\n"
+	"	addq $16, %rsp\n"
+	"	popq %r15\n"
+	"	popq %r14\n"
+	"	popq %r13\n"
+	"	popq %r12\n"
+	"	popq %rbx\n"
+	"	popq %rbp\n"
+	"	ret\n"
+	".size rioFiberSwitch, .-rioFiberSwitch\n"
+	"\n"
+	".globl rioFiberStart\n"
+	".hidden rioFiberStart\n"
+	".type rioFiberStart, @function\n"
+	".p2align 4\n"
+	"rioFiberStart:\n"
+	"	movq %r13, %rdi\n"
+	"	callq *%r12\n"
+	"	ud2\n"
+	".size rioFiberStart, .-rioFiberStart\n"
+);
+#endif // RIO_FIBER_ASM
+
+namespace Rio
+{
+
+#if !RIO_FIBER_ASM
+	// Fiber started by the last switchTo() of the thread
+	static thread_local Fiber* startingFiber = nullptr;
+#endif // !RIO_FIBER_ASM
+
+	Fiber::Fiber()
+		: stack(nullptr)
+		, stackSize(0)
+		, context(nullptr)
+		, function(nullptr)
+		, data(nullptr)
+		, isCreated(false)
+	{
+	}
+
+	Fiber::~Fiber()
+	{
+		if (isCreated)
+		{
+			destroy();
+		}
+	}
+
+	void Fiber::create(FiberFunction function, void* data, size_t stackSize)
+	{
+		RIO_ASSERT(!isCreated, "Fiber is already created");
+		RIO_ASSERT_NOT_NULL(function);
+		this->function = function;
+		this->data = data;
+
+		const size_t pageSize = size_t(sysconf(_SC_PAGESIZE));
+		this->stackSize = (stackSize + pageSize - 1) / pageSize * pageSize;
+		stack = mmap(nullptr, this->stackSize + pageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		RIO_ASSERT(stack != MAP_FAILED, "mmap: errno = %d", errno);
+		// The stack grows down into the guard page
+		int err = mprotect(stack, pageSize, PROT_NONE);
+		RIO_ASSERT(err == 0, "mprotect: errno = %d", errno);
+		RIO_UNUSED(err);
+		char* stackTop = (char*)stack + pageSize + this->stackSize;
+
+#if RIO_FIBER_ASM
+		// Frame popped by rioFiberSwitch(), rioFiberStart() is entered with a 16 bytes aligned stack
+		uint64_t* frame = (uint64_t*)(stackTop - 88);
+		frame[0] = 0x037f; // x87 control word, the default of the ABI
+		frame[1] = 0x1f80; // MXCSR
+		frame[2] = 0; // r15
+		frame[3] = 0; // r14
+		frame[4] = uint64_t(this); // r13
+		frame[5] = uint64_t(&Fiber::entry); // r12
+		frame[6] = 0; // rbx
+		frame[7] = 0; // rbp
+		frame[8] = uint64_t(&rioFiberStart);
+		frame[9] = 0;
+		frame[10] = 0;
+		context = frame;
+#else
+		ucontext_t* ucontext = (ucontext_t*)getDefaultAllocator().allocate(sizeof(ucontext_t), alignof(ucontext_t));
+		getcontext(ucontext);
+		ucontext->uc_stack.ss_sp = stackTop - this->stackSize;
+		ucontext->uc_stack.ss_size = this->stackSize;
+		ucontext->uc_link = nullptr;
+		makecontext(ucontext, &Fiber::entry, 0);
+		context = ucontext;
+#endif // RIO_FIBER_ASM
+
+		isCreated = true;
+	}
+
+	void Fiber::createFromCurrentThread()
+	{
+		RIO_ASSERT(!isCreated, "Fiber is already created");
+#if RIO_FIBER_ASM
+		// Saved by the first switchTo()
+		context = nullptr;
+#else
+		context = getDefaultAllocator().allocate(sizeof(ucontext_t), alignof(ucontext_t));
+#endif // RIO_FIBER_ASM
+		isCreated = true;
+	}
+
+	void Fiber::destroy()
+	{
+		RIO_ASSERT(isCreated, "Fiber is not created");
+		if (stack != nullptr)
+		{
+			munmap(stack, stackSize + size_t(sysconf(_SC_PAGESIZE)));
+			stack = nullptr;
+		}
+#if !RIO_FIBER_ASM
+		getDefaultAllocator().deallocate(context);
+#endif // !RIO_FIBER_ASM
+		context = nullptr;
+		isCreated = false;
+	}
+
+	bool Fiber::getIsCreated() const
+	{
+		return isCreated;
+	}
+
+	void Fiber::switchTo(Fiber& from, Fiber& to)
+	{
+		RIO_ASSERT(from.isCreated && to.isCreated, "Fiber is not created");
+#if RIO_FIBER_ASM
+		rioFiberSwitch(&from.context, to.context);
+#else
+		startingFiber = &to;
+		swapcontext((ucontext_t*)from.context, (ucontext_t*)to.context);
+#endif // RIO_FIBER_ASM
+	}
+
+#if RIO_FIBER_ASM
+	void Fiber::entry(void* fiber)
+	{
+		Fiber& self = *(Fiber*)fiber;
+		self.function(self.data);
+		RIO_FATAL("Fiber function returned");
+	}
+#else
+	void Fiber::entry()
+	{
+		Fiber& self = *startingFiber;
+		self.function(self.data);
+		RIO_FATAL("Fiber function returned");
+	}
+#endif // RIO_FIBER_ASM
+
+} // namespace Rio
+
+#endif // RIO_PLATFORM_POSIX
@@ -0,0 +1,103 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/Thread/Futex.h"
+
+#if RIO_PLATFORM_POSIX
+
+#include "Core/Debug/Error.h"
+
+#if RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID
+	#include <errno.h>
+	#include <limits.h> // INT_MAX
+	#include <linux/futex.h>
+	#include <sys/syscall.h>
+	#include <unistd.h> // syscall
+#else
+	#include <pthread.h>
+#endif // RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID
+
+namespace Rio
+{
+	namespace FutexFn
+	{
+		static_assert(sizeof(Atomic<uint32_t>) == sizeof(uint32_t), "The futex is the address of the Atomic");
+
+#if RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID
+		void wait(Atomic<uint32_t>& word, uint32_t expected)
+		{
+			// The kernel checks the value under its lock, a wake between our check and the wait is not lost
+			const long result = syscall(SYS_futex, (uint32_t*)&word, FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+			RIO_ASSERT(result == 0 || errno == EAGAIN || errno == EINTR, "futex: errno = %d", errno);
+			RIO_UNUSED(result);
+		}
+
+		void wake(Atomic<uint32_t>& word, uint32_t count)
+		{
+			syscall(SYS_futex, (uint32_t*)&word, FUTEX_WAKE_PRIVATE, count < INT_MAX ? int(count) : INT_MAX, nullptr, nullptr, 0);
+		}
+
+		void wakeAll(Atomic<uint32_t>& word)
+		{
+			syscall(SYS_futex, (uint32_t*)&word, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+		}
+#else
+		namespace
+		{
+			// Waiters of different addresses may share a bucket, they are woken spuriously
+			const uint32_t BUCKETS_COUNT = 64;
+
+			struct Bucket
+			{
+				pthread_mutex_t mutex;
+				pthread_cond_t condition;
+				char padding[RIO_CACHE_LINE_SIZE];
+			};
+
+			Bucket buckets[BUCKETS_COUNT] =
+			{
+#define RIO_FUTEX_BUCKET { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, {} }
+#define RIO_FUTEX_BUCKET_8 RIO_FUTEX_BUCKET, RIO_FUTEX_BUCKET, RIO_FUTEX_BUCKET, RIO_FUTEX_BUCKET, RIO_FUTEX_BUCKET, RIO_FUTEX_BUCKET, RIO_FUTEX_BUCKET, RIO_FUTEX_BUCKET
+				RIO_FUTEX_BUCKET_8, RIO_FUTEX_BUCKET_8, RIO_FUTEX_BUCKET_8, RIO_FUTEX_BUCKET_8,
+				RIO_FUTEX_BUCKET_8, RIO_FUTEX_BUCKET_8, RIO_FUTEX_BUCKET_8, RIO_FUTEX_BUCKET_8
+#undef RIO_FUTEX_BUCKET_8
+#undef RIO_FUTEX_BUCKET
+			};
+
+			Bucket& getBucket(const Atomic<uint32_t>& word)
+			{
+				const uintptr_t address = (uintptr_t)&word;
+				return buckets[((address >> 2) ^ (address >> 9)) % BUCKETS_COUNT];
+			}
+		} // namespace (anonymous)
+
+		void wait(Atomic<uint32_t>& word, uint32_t expected)
+		{
+			Bucket& bucket = getBucket(word);
+			pthread_mutex_lock(&bucket.mutex);
+			// The wakers take the lock after changing the word, checked under it nothing is missed
+			if (word.load(MemoryOrder::SEQUENTIALLY_CONSISTENT) == expected)
+			{
+				pthread_cond_wait(&bucket.condition, &bucket.mutex);
+			}
+			pthread_mutex_unlock(&bucket.mutex);
+		}
+
+		void wake(Atomic<uint32_t>& word, uint32_t count)
+		{
+			// The bucket is shared, a signal could go to a waiter of another address
+			RIO_UNUSED(count);
+			wakeAll(word);
+		}
+
+		void wakeAll(Atomic<uint32_t>& word)
+		{
+			Bucket& bucket = getBucket(word);
+			pthread_mutex_lock(&bucket.mutex);
+			pthread_cond_broadcast(&bucket.condition);
+			pthread_mutex_unlock(&bucket.mutex);
+		}
+#endif // RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID
+	} // namespace FutexFn
+
+} // namespace Rio
+
+#endif // RIO_PLATFORM_POSIX
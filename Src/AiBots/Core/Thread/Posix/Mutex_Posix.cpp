@@ -2,7 +2,7 @@
 #include "Core/Thread/Mutex.h"
 #include "Core/Debug/Error.h"
 
-#if RIO_PLATFORM_POSIX
+#if RIO_PLATFORM_POSIX && !RIO_FUTEX
 
 namespace Rio
 {
@@ -41,4 +41,4 @@ namespace Rio
 	}
 } // namespace Rio
 
-#endif RIO_PLATFORM_POSIX
\ No newline at end of file
+#endif // RIO_PLATFORM_POSIX && !RIO_FUTEX
\ No newline at end of file
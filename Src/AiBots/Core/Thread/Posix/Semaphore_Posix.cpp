@@ -1,7 +1,8 @@
 // Copyright (c) 2015 Volodymyr Syvochka
 #include "Core/Thread/Semaphore.h"
+#include "Core/Thread/ScopedMutex.h"
 
-#if RIO_PLATFORM_POSIX
+#if RIO_PLATFORM_POSIX && !RIO_FUTEX
 
 namespace Rio
 {
@@ -39,7 +40,7 @@ namespace Rio
 		ScopedMutex sm(mutex);
 		while (count <= 0)
 		{
-			int result = pthread_cond_wait(&threadCond, &(mutex._mutex));
+			int result = pthread_cond_wait(&threadCond, &(mutex.mutex));
 			RIO_ASSERT(result == 0, "pthread_cond_wait: errno = %d", result);
 			RIO_UNUSED(result);
 		}
@@ -48,4 +49,4 @@ namespace Rio
 	}
 } // namespace Rio
 
-#endif  // RIO_PLATFORM_POSIX
\ No newline at end of file
+#endif // RIO_PLATFORM_POSIX && !RIO_FUTEX
\ No newline at end of file
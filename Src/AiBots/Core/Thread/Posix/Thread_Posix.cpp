@@ -3,16 +3,113 @@
 
 #if RIO_PLATFORM_POSIX
 
+#include <limits.h> // PTHREAD_STACK_MIN
+#include <sched.h> // sched_yield, sched_setaffinity, sched_getaffinity, sched_getcpu
+#include <string.h> // strncpy, memset
+#include <unistd.h> // sysconf
+
+#if RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID
+	#include <sys/resource.h> // setpriority
+	#include <sys/syscall.h> // SYS_gettid
+#endif // RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID
+
 namespace Rio
 {
 
+static int32_t getCurrentThreadId()
+{
+#if RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID
+	return int32_t(syscall(SYS_gettid));
+#else
+	return 0;
+#endif // RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID
+}
+
+static void setNativeName(pthread_t handle, const char* name)
+{
+#if RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID
+	// Longer names are refused with ERANGE
+	char truncated[16];
+	strncpy(truncated, name, sizeof(truncated) - 1);
+	truncated[sizeof(truncated) - 1] = '\0';
+	pthread_setname_np(handle, truncated);
+#elif RIO_PLATFORM_OSX || RIO_PLATFORM_IOS
+	// Only the calling thread can be named
+	if (pthread_equal(handle, pthread_self()))
+	{
+		pthread_setname_np(name);
+	}
+#else
+	RIO_UNUSED(handle);
+	RIO_UNUSED(name);
+#endif // RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID
+}
+
+static bool setNativePriority(pthread_t handle, int32_t threadId, ThreadPriority::Enum priority)
+{
+	sched_param param;
+	memset(&param, 0, sizeof(param));
+	if (priority == ThreadPriority::REALTIME)
+	{
+		// Low in the realtime range, under the interrupt threads of PREEMPT_RT kernels
+		const int minPriority = sched_get_priority_min(SCHED_FIFO);
+		const int maxPriority = sched_get_priority_max(SCHED_FIFO);
+		param.sched_priority = minPriority + (maxPriority - minPriority) / 4;
+		return pthread_setschedparam(handle, SCHED_FIFO, &param) == 0;
+	}
+
+#if RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID
+	// SCHED_OTHER has a single static priority, the threads are weighted by their nice value instead.
+	// A negative nice value needs CAP_SYS_NICE or RLIMIT_NICE.
+	RIO_UNUSED(threadId);
+	if (pthread_setschedparam(handle, SCHED_OTHER, &param) != 0)
+	{
+		return false;
+	}
+	const int niceValues[] = { 10, 0, -10 };
+	return setpriority(PRIO_PROCESS, id_t(threadId), niceValues[priority]) == 0;
+#else
+	RIO_UNUSED(threadId);
+	const int minPriority = sched_get_priority_min(SCHED_OTHER);
+	const int maxPriority = sched_get_priority_max(SCHED_OTHER);
+	const int priorities[] = { minPriority, (minPriority + maxPriority) / 2, maxPriority };
+	param.sched_priority = priorities[priority];
+	return pthread_setschedparam(handle, SCHED_OTHER, &param) == 0;
+#endif // RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID
+}
+
+static bool setNativeAffinity(int32_t threadId, const CpuSet& cpus)
+{
+#if RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	for (uint32_t i = 0; i < CpuSet::MAX_CPUS && i < CPU_SETSIZE; ++i)
+	{
+		if (CpuSetFn::has(cpus, i))
+		{
+			CPU_SET(i, &set);
+		}
+	}
+	return sched_setaffinity(pid_t(threadId), sizeof(set), &set) == 0;
+#else
+	// OSX only has affinity tags, which are hints
+	RIO_UNUSED(threadId);
+	RIO_UNUSED(cpus);
+	return false;
+#endif // RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID
+}
+
 Thread::Thread()
 	: threadHandle(0)
+	, threadId(0)
 	, threadFunction(NULL)
 	, threadData(NULL)
 	, threadStackSize(0)
+	, priority(ThreadPriority::NORMAL)
 	, isRunning(false)
 {
+	name[0] = '\0';
+	CpuSetFn::clear(affinity);
 }
 
 Thread::~Thread()
@@ -38,6 +135,13 @@ void Thread::start(ThreadFunction func, void* data, size_t stackSize)
 
 	if (threadStackSize != 0)
 	{
+		// pthread_attr_setstacksize() fails below PTHREAD_STACK_MIN and may fail on partial pages
+		const size_t pageSize = size_t(sysconf(_SC_PAGESIZE));
+		threadStackSize = (threadStackSize + pageSize - 1) / pageSize * pageSize;
+		if (threadStackSize < size_t(PTHREAD_STACK_MIN))
+		{
+			threadStackSize = size_t(PTHREAD_STACK_MIN);
+		}
 		result = pthread_attr_setstacksize(&attr, threadStackSize);
 		RIO_ASSERT(result == 0, "pthread_attr_setstacksize: errno = %d", result);
 	}
@@ -62,10 +166,110 @@ void Thread::stop()
 	RIO_ASSERT(result == 0, "pthread_join: errno = %d", result);
 	RIO_UNUSED(result);
 	threadHandle = 0;
+	threadId = 0;
 
 	isRunning = false;
 }
 
+void Thread::setName(const char* name)
+{
+	RIO_ASSERT_NOT_NULL(name);
+	strncpy(this->name, name, sizeof(this->name) - 1);
+	this->name[sizeof(this->name) - 1] = '\0';
+	if (isRunning)
+	{
+		setNativeName(threadHandle, this->name);
+	}
+}
+
+bool Thread::setPriority(ThreadPriority::Enum priority)
+{
+	this->priority = priority;
+	return isRunning ? setNativePriority(threadHandle, threadId, priority) : true;
+}
+
+bool Thread::setAffinity(const CpuSet& cpus)
+{
+	RIO_ASSERT(!CpuSetFn::getIsEmpty(cpus), "The set must have a cpu");
+	affinity = cpus;
+	return isRunning ? setNativeAffinity(threadId, affinity) : true;
+}
+
+bool Thread::setNumaNode(uint32_t numaNode)
+{
+	CpuSet cpus;
+	CpuTopologyFn::getNumaNodeCpus(CpuTopologyFn::get(), numaNode, cpus);
+	return !CpuSetFn::getIsEmpty(cpus) && setAffinity(cpus);
+}
+
+void Thread::applySettings()
+{
+	threadId = getCurrentThreadId();
+	if (name[0] != '\0')
+	{
+		setNativeName(pthread_self(), name);
+	}
+	if (priority != ThreadPriority::NORMAL)
+	{
+		setNativePriority(pthread_self(), threadId, priority);
+	}
+	if (!CpuSetFn::getIsEmpty(affinity))
+	{
+		setNativeAffinity(threadId, affinity);
+	}
+}
+
+void Thread::setCurrentName(const char* name)
+{
+	RIO_ASSERT_NOT_NULL(name);
+	setNativeName(pthread_self(), name);
+}
+
+bool Thread::setCurrentPriority(ThreadPriority::Enum priority)
+{
+	return setNativePriority(pthread_self(), getCurrentThreadId(), priority);
+}
+
+bool Thread::setCurrentAffinity(const CpuSet& cpus)
+{
+	RIO_ASSERT(!CpuSetFn::getIsEmpty(cpus), "The set must have a cpu");
+	return setNativeAffinity(getCurrentThreadId(), cpus);
+}
+
+uint32_t Thread::getCurrentCpu()
+{
+#if RIO_PLATFORM_LINUX
+	const int cpu = sched_getcpu();
+	return cpu >= 0 ? uint32_t(cpu) : 0;
+#else
+	return 0;
+#endif // RIO_PLATFORM_LINUX
+}
+
+uint32_t Thread::getProcessorsCount()
+{
+#if RIO_PLATFORM_LINUX
+	// Honors taskset and cgroup cpusets, the online processors may not all be available
+	cpu_set_t cpus;
+	CPU_ZERO(&cpus);
+	if (sched_getaffinity(0, sizeof(cpus), &cpus) == 0)
+	{
+		const int cpuCount = CPU_COUNT(&cpus);
+		if (cpuCount > 0)
+		{
+			return uint32_t(cpuCount);
+		}
+	}
+#endif // RIO_PLATFORM_LINUX
+	const long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return count > 0 ? uint32_t(count) : 1;
+}
+
+void Thread::yield()
+{
+	sched_yield();
+}
+
 } // namespace Rio
 
 #endif // RIO_PLATFORM_POSIX
\ No newline at end of file
@@ -0,0 +1,123 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/Thread/ReadWriteLock.h"
+
+#include "Core/Debug/Error.h"
+#include "Core/Thread/Futex.h"
+
+namespace Rio
+{
+	namespace
+	{
+		const uint32_t READERS_MASK = 0x3fffffffu;
+		const uint32_t WRITER = 0x40000000u;
+		// A thread waits on the futex, the next unlock wakes all of them
+		const uint32_t WAITERS = 0x80000000u;
+	} // namespace (anonymous)
+
+	ReadWriteLock::ReadWriteLock()
+		: state(0)
+		, writersWaitingCount(0)
+	{
+	}
+
+	ReadWriteLock::~ReadWriteLock()
+	{
+		RIO_ASSERT((state.load(MemoryOrder::RELAXED) & ~WAITERS) == 0, "ReadWriteLock is locked");
+	}
+
+	void ReadWriteLock::lockRead()
+	{
+		uint32_t value = state.load(MemoryOrder::RELAXED);
+		const uint32_t spinCount = FutexFn::getSpinCount();
+		for (uint32_t i = 0; i < spinCount; ++i)
+		{
+			if (tryLockRead(value))
+			{
+				return;
+			}
+			AtomicFn::pause();
+			value = state.load(MemoryOrder::RELAXED);
+		}
+
+		while (!tryLockRead(value))
+		{
+			if ((value & WAITERS) == 0 && !state.compareExchangeWeak(value, value | WAITERS, MemoryOrder::RELAXED))
+			{
+				continue;
+			}
+			FutexFn::wait(state, value | WAITERS);
+			value = state.load(MemoryOrder::RELAXED);
+		}
+	}
+
+	void ReadWriteLock::unlockRead()
+	{
+		const uint32_t previous = state.fetchSub(1, MemoryOrder::RELEASE);
+		RIO_ASSERT((previous & READERS_MASK) != 0, "ReadWriteLock is not locked for reading");
+
+		// The last reader wakes the waiters, unless another reader came in meanwhile
+		uint32_t expected = WAITERS;
+		if (previous == (WAITERS | 1) && state.compareExchangeStrong(expected, 0, MemoryOrder::RELAXED))
+		{
+			FutexFn::wakeAll(state);
+		}
+	}
+
+	void ReadWriteLock::lockWrite()
+	{
+		uint32_t value = state.load(MemoryOrder::RELAXED);
+		const uint32_t spinCount = FutexFn::getSpinCount();
+		for (uint32_t i = 0; i < spinCount; ++i)
+		{
+			if (tryLockWrite(value))
+			{
+				return;
+			}
+			AtomicFn::pause();
+			value = state.load(MemoryOrder::RELAXED);
+		}
+
+		writersWaitingCount.fetchAdd(1, MemoryOrder::RELAXED);
+		while (!tryLockWrite(value))
+		{
+			if ((value & WAITERS) == 0 && !state.compareExchangeWeak(value, value | WAITERS, MemoryOrder::RELAXED))
+			{
+				continue;
+			}
+			FutexFn::wait(state, value | WAITERS);
+			value = state.load(MemoryOrder::RELAXED);
+		}
+		writersWaitingCount.fetchSub(1, MemoryOrder::RELAXED);
+	}
+
+	void ReadWriteLock::unlockWrite()
+	{
+		const uint32_t previous = state.exchange(0, MemoryOrder::RELEASE);
+		RIO_ASSERT((previous & WRITER) != 0, "ReadWriteLock is not locked for writing");
+		if ((previous & WAITERS) != 0)
+		{
+			FutexFn::wakeAll(state);
+		}
+	}
+
+	bool ReadWriteLock::tryLockRead(uint32_t& value)
+	{
+		// Either locked for writing or a writer waits, the CAS is not tried
+		if ((value & WRITER) != 0 || writersWaitingCount.load(MemoryOrder::RELAXED) != 0)
+		{
+			return false;
+		}
+		return state.compareExchangeWeak(value, value + 1, MemoryOrder::ACQUIRE, MemoryOrder::RELAXED);
+	}
+
+	bool ReadWriteLock::tryLockWrite(uint32_t& value)
+	{
+		if ((value & ~WAITERS) != 0)
+		{
+			return false;
+		}
+		// The waiters flag is kept, unlockWrite() wakes them
+		return state.compareExchangeWeak(value, value | WRITER, MemoryOrder::ACQUIRE, MemoryOrder::RELAXED);
+	}
+
+} // namespace Rio
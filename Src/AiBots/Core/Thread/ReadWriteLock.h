@@ -0,0 +1,80 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#pragma once
+
+#include "Core/Base/Config.h"
+#include "Core/Base/Types.h"
+#include "Core/Thread/Atomic.h"
+
+namespace Rio
+{
+	// Many readers or one writer. Spins for a while and then waits on a futex.
+	// Writers go first, new readers wait while a writer is waiting.
+	class ReadWriteLock
+	{
+	public:
+		ReadWriteLock();
+		~ReadWriteLock();
+
+		void lockRead();
+		void unlockRead();
+		void lockWrite();
+		void unlockWrite();
+	private:
+		// Try once with the given value of state, which is updated on failure
+		bool tryLockRead(uint32_t& value);
+		bool tryLockWrite(uint32_t& value);
+
+		// Readers count, WRITER and WAITERS bits
+		Atomic<uint32_t> state;
+		// Writers waiting for the readers, only a hint for the readers
+		Atomic<uint32_t> writersWaitingCount;
+	private:
+		// Disable copying
+		ReadWriteLock(const ReadWriteLock&);
+		ReadWriteLock& operator=(const ReadWriteLock&);
+	};
+
+	// RAII wrappers, like ScopedMutex
+	class ScopedReadLock
+	{
+	public:
+		ScopedReadLock(ReadWriteLock& lock)
+			: lock(lock)
+		{
+			lock.lockRead();
+		}
+
+		~ScopedReadLock()
+		{
+			lock.unlockRead();
+		}
+	private:
+		ReadWriteLock& lock;
+	private:
+		// Disable copying
+		ScopedReadLock(const ScopedReadLock&);
+		ScopedReadLock& operator=(const ScopedReadLock&);
+	};
+
+	class ScopedWriteLock
+	{
+	public:
+		ScopedWriteLock(ReadWriteLock& lock)
+			: lock(lock)
+		{
+			lock.lockWrite();
+		}
+
+		~ScopedWriteLock()
+		{
+			lock.unlockWrite();
+		}
+	private:
+		ReadWriteLock& lock;
+	private:
+		// Disable copying
+		ScopedWriteLock(const ScopedWriteLock&);
+		ScopedWriteLock& operator=(const ScopedWriteLock&);
+	};
+
+} // namespace Rio
@@ -0,0 +1,63 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/Thread/Semaphore.h"
+
+#if RIO_FUTEX
+
+#include "Core/Thread/Futex.h"
+
+namespace Rio
+{
+	Semaphore::Semaphore()
+		: count(0)
+		, waitersCount(0)
+	{
+	}
+
+	Semaphore::~Semaphore()
+	{
+	}
+
+	void Semaphore::post(uint32_t count)
+	{
+		this->count.fetchAdd(count, MemoryOrder::SEQUENTIALLY_CONSISTENT);
+		// Pairs with the waiter registering itself before looking at count
+		if (waitersCount.load(MemoryOrder::SEQUENTIALLY_CONSISTENT) > 0)
+		{
+			FutexFn::wake(this->count, count);
+		}
+	}
+
+	void Semaphore::wait()
+	{
+		// A post often follows shortly, e.g. the next job, spinning avoids the system calls
+		const uint32_t spinCount = FutexFn::getSpinCount();
+		for (uint32_t i = 0; i < spinCount; ++i)
+		{
+			uint32_t value = count.load(MemoryOrder::RELAXED);
+			if (value > 0 && count.compareExchangeWeak(value, value - 1, MemoryOrder::ACQUIRE, MemoryOrder::RELAXED))
+			{
+				return;
+			}
+			AtomicFn::pause();
+		}
+
+		waitersCount.fetchAdd(1, MemoryOrder::SEQUENTIALLY_CONSISTENT);
+		while (true)
+		{
+			uint32_t value = count.load(MemoryOrder::SEQUENTIALLY_CONSISTENT);
+			if (value == 0)
+			{
+				FutexFn::wait(count, 0);
+				continue;
+			}
+			if (count.compareExchangeWeak(value, value - 1, MemoryOrder::ACQUIRE, MemoryOrder::RELAXED))
+			{
+				break;
+			}
+		}
+		waitersCount.fetchSub(1, MemoryOrder::RELAXED);
+	}
+
+} // namespace Rio
+
+#endif // RIO_FUTEX
@@ -6,7 +6,9 @@
 #include "Core/Debug/Error.h"
 #include "Core/Thread/Mutex.h"
 
-#if RIO_PLATFORM_POSIX
+#if RIO_FUTEX
+	#include "Core/Thread/Atomic.h"
+#elif RIO_PLATFORM_POSIX
 	#include <pthread.h>
 #elif RIO_PLATFORM_WINDOWS
 	#include "Core/Os/Windows/Headers_Windows.h"
@@ -24,7 +26,10 @@ public:
 	void post(uint32_t count = 1);
 	void wait();
 private:
-#if RIO_PLATFORM_POSIX
+#if RIO_FUTEX
+	Atomic<uint32_t> count;
+	Atomic<uint32_t> waitersCount;
+#elif RIO_PLATFORM_POSIX
 	Mutex mutex;
 	pthread_cond_t threadCond;
 	int32_t count;
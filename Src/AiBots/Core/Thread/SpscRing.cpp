@@ -0,0 +1,191 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/Thread/SpscRing.h"
+
+#include "Core/Debug/Error.h"
+#include "Core/Thread/Futex.h"
+
+namespace Rio
+{
+	SpscRing::SpscRing(Allocator& a, uint32_t capacity, bool canBlock)
+		: allocator(&a)
+		, canBlock(canBlock)
+	{
+		RIO_ASSERT(capacity <= (uint32_t(1) << 31), "Capacity is too large");
+		uint32_t roundedCapacity = 2 * sizeof(Header);
+		while (roundedCapacity < capacity)
+		{
+			roundedCapacity *= 2;
+		}
+		buffer = (char*)a.allocate(roundedCapacity, RIO_CACHE_LINE_SIZE);
+		mask = roundedCapacity - 1;
+
+		producer.position.store(0, MemoryOrder::RELAXED);
+		producer.isWaiting.store(0, MemoryOrder::RELAXED);
+		consumer.position.store(0, MemoryOrder::RELAXED);
+		consumer.isWaiting.store(0, MemoryOrder::RELAXED);
+		producerLocal.position = 0;
+		producerLocal.otherPosition = 0;
+		consumerLocal.position = 0;
+		consumerLocal.otherPosition = 0;
+	}
+
+	SpscRing::~SpscRing()
+	{
+		allocator->deallocate(buffer);
+	}
+
+	void* SpscRing::reserve(uint32_t size)
+	{
+		RIO_ASSERT(size <= getMaxRecordSize(), "Record is too large");
+		if (!hasSpace(size, producerLocal.otherPosition))
+		{
+			producerLocal.otherPosition = consumer.position.load(MemoryOrder::ACQUIRE);
+			if (!hasSpace(size, producerLocal.otherPosition))
+			{
+				return nullptr;
+			}
+		}
+		return reserveAt(size);
+	}
+
+	void* SpscRing::reserveBlocking(uint32_t size)
+	{
+		RIO_ASSERT(canBlock, "The ring cannot block");
+		void* data = reserve(size);
+		while (data == nullptr)
+		{
+			// The consumer may wait for the records reserved so far
+			commit();
+
+			producer.isWaiting.store(1, MemoryOrder::RELAXED);
+			// Pairs with the fence of release(), either it sees us waiting or we see its head
+			AtomicFn::threadFence(MemoryOrder::SEQUENTIALLY_CONSISTENT);
+			const uint32_t head = consumer.position.load(MemoryOrder::ACQUIRE);
+			if (!hasSpace(size, head))
+			{
+				FutexFn::wait(consumer.position, head);
+			}
+			producer.isWaiting.store(0, MemoryOrder::RELAXED);
+			data = reserve(size);
+		}
+		return data;
+	}
+
+	void SpscRing::commit()
+	{
+		producer.position.store(producerLocal.position, MemoryOrder::RELEASE);
+		if (canBlock)
+		{
+			AtomicFn::threadFence(MemoryOrder::SEQUENTIALLY_CONSISTENT);
+			if (consumer.isWaiting.load(MemoryOrder::RELAXED) != 0)
+			{
+				FutexFn::wake(producer.position, 1);
+			}
+		}
+	}
+
+	const void* SpscRing::read(uint32_t& size)
+	{
+		uint32_t position = consumerLocal.position;
+		if (position == consumerLocal.otherPosition)
+		{
+			consumerLocal.otherPosition = producer.position.load(MemoryOrder::ACQUIRE);
+			if (position == consumerLocal.otherPosition)
+			{
+				return nullptr;
+			}
+		}
+
+		const Header* header = (const Header*)(buffer + (position & mask));
+		if (header->size == SKIP)
+		{
+			// The record was committed with the skip, it is at the beginning of the buffer
+			position += mask + 1 - (position & mask);
+			header = (const Header*)buffer;
+		}
+		size = header->size;
+		consumerLocal.position = position + getRecordSize(size);
+		return header + 1;
+	}
+
+	const void* SpscRing::readBlocking(uint32_t& size)
+	{
+		RIO_ASSERT(canBlock, "The ring cannot block");
+		const void* data = read(size);
+		while (data == nullptr)
+		{
+			// The producer may wait for the records read so far
+			release();
+
+			consumer.isWaiting.store(1, MemoryOrder::RELAXED);
+			// Pairs with the fence of commit(), either it sees us waiting or we see its tail
+			AtomicFn::threadFence(MemoryOrder::SEQUENTIALLY_CONSISTENT);
+			const uint32_t tail = producer.position.load(MemoryOrder::ACQUIRE);
+			if (tail == consumerLocal.position)
+			{
+				FutexFn::wait(producer.position, tail);
+			}
+			consumer.isWaiting.store(0, MemoryOrder::RELAXED);
+			data = read(size);
+		}
+		return data;
+	}
+
+	void SpscRing::release()
+	{
+		consumer.position.store(consumerLocal.position, MemoryOrder::RELEASE);
+		if (canBlock)
+		{
+			AtomicFn::threadFence(MemoryOrder::SEQUENTIALLY_CONSISTENT);
+			if (producer.isWaiting.load(MemoryOrder::RELAXED) != 0)
+			{
+				FutexFn::wake(consumer.position, 1);
+			}
+		}
+	}
+
+	uint32_t SpscRing::getCapacity() const
+	{
+		return mask + 1;
+	}
+
+	uint32_t SpscRing::getMaxRecordSize() const
+	{
+		return (mask + 1) / 2 - sizeof(Header);
+	}
+
+	uint32_t SpscRing::getRecordSize(uint32_t size)
+	{
+		return sizeof(Header) + ((size + 7) & ~uint32_t(7));
+	}
+
+	bool SpscRing::hasSpace(uint32_t size, uint32_t head) const
+	{
+		const uint32_t position = producerLocal.position;
+		const uint32_t untilEnd = mask + 1 - (position & mask);
+		uint32_t needed = getRecordSize(size);
+		if (needed > untilEnd)
+		{
+			needed += untilEnd;
+		}
+		return needed <= mask + 1 - (position - head);
+	}
+
+	void* SpscRing::reserveAt(uint32_t size)
+	{
+		uint32_t position = producerLocal.position;
+		const uint32_t untilEnd = mask + 1 - (position & mask);
+		const uint32_t recordSize = getRecordSize(size);
+		if (recordSize > untilEnd)
+		{
+			// The remaining bytes are a multiple of the record alignment, there is room for the header
+			((Header*)(buffer + (position & mask)))->size = SKIP;
+			position += untilEnd;
+		}
+		Header* header = (Header*)(buffer + (position & mask));
+		header->size = size;
+		producerLocal.position = position + recordSize;
+		return header + 1;
+	}
+
+} // namespace Rio
@@ -0,0 +1,104 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#pragma once
+
+#include "Core/Base/Config.h"
+#include "Core/Base/Platform.h"
+#include "Core/Base/Types.h"
+
+#include "Core/Memory/Allocator.h"
+#include "Core/Thread/Atomic.h"
+
+namespace Rio
+{
+	// Lock-free ring of variable size records between one producer thread and one consumer thread,
+	// e.g. the main thread and the render thread.
+	//
+	// The producer reserves contiguous space for a record, writes it in place and commits it.
+	// Several records reserved before a commit() are published at once, as are several records read
+	// before a release(), which keeps the shared positions off the hot path.
+	// A record which does not fit before the end of the buffer starts at its beginning,
+	// the end is skipped. Records are 8 bytes aligned.
+	//
+	// With canBlock, reserveBlocking() and readBlocking() wait on a futex when the ring is full or empty.
+	// commit() and release() then cost a fence to check for a waiting thread.
+	class SpscRing
+	{
+	public:
+		// capacity is rounded up to a power of 2, in bytes
+		SpscRing(Allocator& a, uint32_t capacity, bool canBlock = false);
+		~SpscRing();
+
+		// Producer only.
+		// Returns size bytes to write the record to, nullptr if the ring is full
+		void* reserve(uint32_t size);
+		// Waits for space, the ring must be created with canBlock.
+		// Commits the records reserved so far before it waits.
+		void* reserveBlocking(uint32_t size);
+		// Publishes the records reserved since the last commit
+		void commit();
+
+		// Consumer only.
+		// Returns the next record and its size, nullptr if there are none
+		const void* read(uint32_t& size);
+		// Waits for a record, the ring must be created with canBlock.
+		// Releases the records read so far before it waits.
+		const void* readBlocking(uint32_t& size);
+		// Gives the space of the records read since the last release back to the producer,
+		// the records must not be used anymore
+		void release();
+
+		uint32_t getCapacity() const;
+		// Size of the largest record, half the capacity so that it always fits after skipping the end
+		uint32_t getMaxRecordSize() const;
+
+	private:
+		struct Header
+		{
+			uint32_t size;
+			uint32_t padding;
+		};
+
+		// Size of the record which makes the consumer skip to the beginning of the buffer
+		static const uint32_t SKIP = UINT32_MAX;
+
+		// Written by one thread, read by the other
+		struct alignas(RIO_CACHE_LINE_SIZE) SharedState
+		{
+			Atomic<uint32_t> position;
+			Atomic<uint32_t> isWaiting;
+		};
+
+		// Used by one thread only, caches the last position of the other so that it is read only when needed
+		struct alignas(RIO_CACHE_LINE_SIZE) LocalState
+		{
+			uint32_t position;
+			uint32_t otherPosition;
+		};
+
+		// Returns the bytes taken by a record of size, header included
+		static uint32_t getRecordSize(uint32_t size);
+		// Returns whether there are size bytes free at the producer's position with head as the consumer's one
+		bool hasSpace(uint32_t size, uint32_t head) const;
+		void* reserveAt(uint32_t size);
+
+		// Read by both threads, never written after the constructor
+		Allocator* allocator;
+		char* buffer;
+		uint32_t mask;
+		bool canBlock;
+
+		// Tail, committed by the producer
+		SharedState producer;
+		// Head, released by the consumer
+		SharedState consumer;
+		// Reserved but not committed yet, and the head last read by the producer
+		LocalState producerLocal;
+		// Read but not released yet, and the tail last read by the consumer
+		LocalState consumerLocal;
+	private:
+		// Disable copying
+		SpscRing(const SpscRing&);
+		SpscRing& operator=(const SpscRing&);
+	};
+
+} // namespace Rio
@@ -0,0 +1,231 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#pragma once
+
+#include "Core/Base/Config.h"
+#include "Core/Base/Types.h"
+#include "Core/Debug/Error.h"
+#include "Core/Thread/Atomic.h"
+#include "Core/Thread/Fiber.h"
+#include "Core/Thread/JobSystem.h"
+
+namespace Rio
+{
+	// Result of a function run as a job. A job which gets the result of a task not done yet is
+	// suspended without blocking its thread, so dependent steps read as straight-line code:
+	//
+	//	Mesh* loadLevel(JobSystem& jobSystem, void* data)
+	//	{
+	//		Task<Geometry*> geometry(jobSystem, loadGeometry, "level.geometry");
+	//		Task<Material*> material(jobSystem, loadMaterial, "level.material");
+	//		return createMesh(geometry.get(), material.get());
+	//	}
+	//
+	// Tasks are created and read from the threads of the JobSystem only.
+	// The task must stay alive until it is done, the destructor waits for it.
+	template <typename T>
+	class Task
+	{
+	public:
+		typedef T (*TaskFunction)(JobSystem& jobSystem, void* data);
+
+		// Runs function(data) as a job
+		Task(JobSystem& jobSystem, TaskFunction function, void* data = nullptr)
+			: jobSystem(&jobSystem)
+			, function(function)
+			, data(data)
+			, isDone(0)
+		{
+			job = jobSystem.createJob(run, this);
+			jobSystem.run(job);
+		}
+
+		~Task()
+		{
+			get();
+		}
+
+		bool getIsDone() const
+		{
+			return isDone.load(MemoryOrder::ACQUIRE) != 0;
+		}
+
+		// Suspends the calling job until the task is done and returns its result
+		T& get()
+		{
+			if (!getIsDone())
+			{
+				jobSystem->wait(job);
+			}
+			return result;
+		}
+
+	private:
+		static void run(JobSystem& jobSystem, Job* job, void* data)
+		{
+			RIO_UNUSED(job);
+			Task& task = *(Task*)data;
+			task.result = task.function(jobSystem, task.data);
+			task.isDone.store(1, MemoryOrder::RELEASE);
+		}
+
+		JobSystem* jobSystem;
+		TaskFunction function;
+		void* data;
+		// Valid while the task is not done, the JobSystem reuses it afterwards
+		Job* job;
+		Atomic<uint32_t> isDone;
+		T result;
+	private:
+		// Disable copying
+		Task(const Task&);
+		Task& operator=(const Task&);
+	};
+
+	template <>
+	class Task<void>
+	{
+	public:
+		typedef void (*TaskFunction)(JobSystem& jobSystem, void* data);
+
+		Task(JobSystem& jobSystem, TaskFunction function, void* data = nullptr)
+			: jobSystem(&jobSystem)
+			, function(function)
+			, data(data)
+			, isDone(0)
+		{
+			job = jobSystem.createJob(run, this);
+			jobSystem.run(job);
+		}
+
+		~Task()
+		{
+			get();
+		}
+
+		bool getIsDone() const
+		{
+			return isDone.load(MemoryOrder::ACQUIRE) != 0;
+		}
+
+		void get()
+		{
+			if (!getIsDone())
+			{
+				jobSystem->wait(job);
+			}
+		}
+
+	private:
+		static void run(JobSystem& jobSystem, Job* job, void* data)
+		{
+			RIO_UNUSED(job);
+			Task& task = *(Task*)data;
+			task.function(jobSystem, task.data);
+			task.isDone.store(1, MemoryOrder::RELEASE);
+		}
+
+		JobSystem* jobSystem;
+		TaskFunction function;
+		void* data;
+		Job* job;
+		Atomic<uint32_t> isDone;
+	private:
+		// Disable copying
+		Task(const Task&);
+		Task& operator=(const Task&);
+	};
+
+	// Produces a sequence of values with straight-line code. The function runs on its own fiber,
+	// each yield() suspends it until the consumer asks for the next value:
+	//
+	//	void countDown(Generator<uint32_t>& generator, void* data)
+	//	{
+	//		for (uint32_t i = *(uint32_t*)data; i > 0; --i)
+	//		{
+	//			generator.yield(i);
+	//		}
+	//	}
+	//
+	//	Generator<uint32_t> generator(countDown, &count);
+	//	uint32_t value;
+	//	while (generator.next(value))
+	//	{
+	//	}
+	//
+	// next() is called by the fiber or thread which created the generator.
+	// The function must not wait for jobs, it would suspend the fiber of the generator.
+	template <typename T>
+	class Generator
+	{
+	public:
+		typedef void (*GeneratorFunction)(Generator<T>& generator, void* data);
+
+		Generator(GeneratorFunction function, void* data = nullptr, size_t stackSize = Fiber::DEFAULT_STACK_SIZE)
+			: function(function)
+			, data(data)
+			, isDone(false)
+		{
+			fiber.create(run, this, stackSize);
+			callerFiber.createFromCurrentThread();
+		}
+
+		// The function may not have returned, its stack is then freed without unwinding it
+		~Generator()
+		{
+		}
+
+		// Runs the function until its next yield() and returns the value, false once the function returned
+		bool next(T& value)
+		{
+			if (isDone)
+			{
+				return false;
+			}
+			Fiber::switchTo(callerFiber, fiber);
+			if (isDone)
+			{
+				return false;
+			}
+			value = current;
+			return true;
+		}
+
+		// Called by the function, returns once the consumer asks for the next value
+		void yield(const T& value)
+		{
+			current = value;
+			Fiber::switchTo(fiber, callerFiber);
+		}
+
+		bool getIsDone() const
+		{
+			return isDone;
+		}
+
+	private:
+		static void run(void* data)
+		{
+			Generator& generator = *(Generator*)data;
+			generator.function(generator, generator.data);
+			generator.isDone = true;
+			// A fiber must not return
+			for (;;)
+			{
+				Fiber::switchTo(generator.fiber, generator.callerFiber);
+			}
+		}
+
+		Fiber fiber;
+		// The consumer, saved by next()
+		Fiber callerFiber;
+		GeneratorFunction function;
+		void* data;
+		T current;
+		bool isDone;
+	private:
+		// Disable copying
+		Generator(const Generator&);
+		Generator& operator=(const Generator&);
+	};
+
+} // namespace Rio
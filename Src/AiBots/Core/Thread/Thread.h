@@ -5,6 +5,7 @@
 #include "Core/Debug/Error.h"
 #include "Core/Base/Types.h"
 #include "Semaphore.h"
+#include "CpuTopology.h"
 
 #if RIO_PLATFORM_POSIX
 	#include <pthread.h>
@@ -17,23 +18,68 @@ namespace Rio
 {
 	typedef int32_t(*ThreadFunction)(void*);
 
+	struct ThreadPriority
+	{
+		enum Enum
+		{
+			LOW,
+			NORMAL,
+			// Above the other threads of the process, for the render and audio threads
+			HIGH,
+			// Scheduled before any normal thread of the system, needs CAP_SYS_NICE or RLIMIT_RTPRIO on Linux.
+			// A realtime thread which never blocks starves the rest of the machine.
+			REALTIME
+		};
+	};
+
 struct Thread
 {
 	Thread();
 	~Thread();
+	// stackSize 0 uses the default of the OS, other sizes are rounded up to whole pages
 	void start(ThreadFunction func, void* data = NULL, size_t stackSize = 0);
 	void stop();
+
+	// The setters can be called before start() or while the thread runs.
+	// Before start() they are applied by the thread before it calls its function, failures are ignored then.
+
+	// Names the thread for debuggers, profilers and /proc/<pid>/task/<tid>/comm.
+	// Linux keeps the first 15 characters.
+	void setName(const char* name);
+	// Returns false if the OS refused it
+	bool setPriority(ThreadPriority::Enum priority);
+	// Keeps the thread on the cpus of the set, returns false if none of them can be used by the process
+	bool setAffinity(const CpuSet& cpus);
+	// Keeps the thread on the cpus of the NUMA node of CpuTopologyFn::get().
+	// The memory the thread touches first is then allocated by the OS on that node.
+	bool setNumaNode(uint32_t numaNode);
+
+	// Same for the calling thread, which does not have to be started by a Thread
+	static void setCurrentName(const char* name);
+	static bool setCurrentPriority(ThreadPriority::Enum priority);
+	static bool setCurrentAffinity(const CpuSet& cpus);
+	// Returns the cpu the calling thread runs on, which may change as soon as it returns unless it is pinned
+	static uint32_t getCurrentCpu();
 	bool getIsRunning()
 	{
 		return isRunning;
 	}
+
+	// Returns the number of logical processors available to the process
+	static uint32_t getProcessorsCount();
+	// Gives the rest of the time slice of the calling thread to another thread
+	static void yield();
 private:
 	int32_t run()
 	{
+		applySettings();
 		semaphore.post();
 		return threadFunction(threadData);
 	}
 
+	// Applies the settings given before start() to the calling thread
+	void applySettings();
+
 #if RIO_PLATFORM_POSIX
 	static void* threadProc(void* arg)
 	{
@@ -53,6 +99,8 @@ private:
 private:
 #if RIO_PLATFORM_POSIX
 	pthread_t threadHandle;
+	// Kernel id of the thread on Linux, known once it runs
+	int32_t threadId;
 #elif RIO_PLATFORM_WINDOWS
 	HANDLE threadHandle;
 #endif
@@ -60,6 +108,10 @@ private:
 	void* threadData;
 	Semaphore semaphore;
 	size_t threadStackSize;
+	char name[64];
+	ThreadPriority::Enum priority;
+	// Empty for any cpu
+	CpuSet affinity;
 	bool isRunning;
 private:
 	// Disable copying
@@ -0,0 +1,135 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/Thread/CpuTopology.h"
+
+#if RIO_PLATFORM_WINDOWS
+
+#include "Core/Memory/Memory.h"
+#include "Core/Os/Windows/Headers_Windows.h"
+
+#include <string.h> // memset
+
+namespace Rio
+{
+	namespace CpuTopologyFn
+	{
+		static void addGroupMask(CpuSet& cpus, const GROUP_AFFINITY& groupMask)
+		{
+			for (uint32_t i = 0; i < 64; ++i)
+			{
+				const uint32_t cpu = uint32_t(groupMask.Group) * 64 + i;
+				if ((uint64_t(groupMask.Mask) & (uint64_t(1) << i)) != 0 && cpu < CpuSet::MAX_CPUS)
+				{
+					CpuSetFn::add(cpus, cpu);
+				}
+			}
+		}
+
+		void query(CpuTopology& topology)
+		{
+			memset(&topology, 0, sizeof(topology));
+
+			DWORD size = 0;
+			GetLogicalProcessorInformationEx(RelationAll, NULL, &size);
+			Allocator& a = getDefaultAllocator();
+			char* buffer = (char*)a.allocate(size);
+			if (size == 0 || !GetLogicalProcessorInformationEx(RelationAll, (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)buffer, &size))
+			{
+				// Every logical processor is its own core
+				a.deallocate(buffer);
+				SYSTEM_INFO info;
+				GetSystemInfo(&info);
+				topology.cpusCount = info.dwNumberOfProcessors > 0 ? uint32_t(info.dwNumberOfProcessors) : 1;
+				for (uint32_t i = 0; i < topology.cpusCount && i < CpuSet::MAX_CPUS; ++i)
+				{
+					CpuSetFn::add(topology.onlineCpus, i);
+					topology.cpus[i].core = uint16_t(i);
+				}
+				topology.coresCount = topology.cpusCount;
+				topology.packagesCount = 1;
+				topology.numaNodesCount = 1;
+				return;
+			}
+
+			// The records are of variable size, each relation lists its processors with group masks
+			for (DWORD offset = 0; offset < size; )
+			{
+				const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX* info = (const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*)(buffer + offset);
+				offset += info->Size;
+
+				CpuSet cpus;
+				CpuSetFn::clear(cpus);
+				if (info->Relationship == RelationProcessorCore)
+				{
+					for (WORD i = 0; i < info->Processor.GroupCount; ++i)
+					{
+						addGroupMask(cpus, info->Processor.GroupMask[i]);
+					}
+					uint16_t smtIndex = 0;
+					for (uint32_t cpu = 0; cpu < CpuSet::MAX_CPUS; ++cpu)
+					{
+						if (CpuSetFn::has(cpus, cpu))
+						{
+							CpuSetFn::add(topology.onlineCpus, cpu);
+							topology.cpus[cpu].core = uint16_t(topology.coresCount);
+							topology.cpus[cpu].smtIndex = smtIndex++;
+							++topology.cpusCount;
+						}
+					}
+					++topology.coresCount;
+				}
+				else if (info->Relationship == RelationProcessorPackage)
+				{
+					for (WORD i = 0; i < info->Processor.GroupCount; ++i)
+					{
+						addGroupMask(cpus, info->Processor.GroupMask[i]);
+					}
+					for (uint32_t cpu = 0; cpu < CpuSet::MAX_CPUS; ++cpu)
+					{
+						if (CpuSetFn::has(cpus, cpu))
+						{
+							topology.cpus[cpu].package = uint16_t(topology.packagesCount);
+						}
+					}
+					++topology.packagesCount;
+				}
+				else if (info->Relationship == RelationNumaNode)
+				{
+					addGroupMask(cpus, info->NumaNode.GroupMask);
+					for (uint32_t cpu = 0; cpu < CpuSet::MAX_CPUS; ++cpu)
+					{
+						if (CpuSetFn::has(cpus, cpu))
+						{
+							topology.cpus[cpu].numaNode = uint16_t(topology.numaNodesCount);
+						}
+					}
+					++topology.numaNodesCount;
+				}
+				else if (info->Relationship == RelationCache && topology.cachesCount < CpuTopology::MAX_CACHES)
+				{
+					CpuCache& cache = topology.caches[topology.cachesCount++];
+					cache.level = info->Cache.Level;
+					cache.type = info->Cache.Type == CacheData ? CpuCacheType::DATA
+						: info->Cache.Type == CacheInstruction ? CpuCacheType::INSTRUCTION
+						: CpuCacheType::UNIFIED;
+					cache.size = info->Cache.CacheSize;
+					cache.lineSize = info->Cache.LineSize;
+					CpuSetFn::clear(cache.cpus);
+					addGroupMask(cache.cpus, info->Cache.GroupMask);
+				}
+			}
+			a.deallocate(buffer);
+
+			if (topology.packagesCount == 0)
+			{
+				topology.packagesCount = 1;
+			}
+			if (topology.numaNodesCount == 0)
+			{
+				topology.numaNodesCount = 1;
+			}
+		}
+	} // namespace CpuTopologyFn
+
+} // namespace Rio
+
+#endif // RIO_PLATFORM_WINDOWS
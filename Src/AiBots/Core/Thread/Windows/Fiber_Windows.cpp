@@ -0,0 +1,98 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/Thread/Fiber.h"
+
+#if RIO_PLATFORM_WINDOWS
+
+#include "Core/Debug/Error.h"
+#include "Core/Os/Windows/Headers_Windows.h"
+
+namespace Rio
+{
+	Fiber::Fiber()
+		: fiberHandle(NULL)
+		, isThread(false)
+		, function(NULL)
+		, data(NULL)
+		, isCreated(false)
+	{
+	}
+
+	Fiber::~Fiber()
+	{
+		if (isCreated)
+		{
+			destroy();
+		}
+	}
+
+	void Fiber::create(FiberFunction function, void* data, size_t stackSize)
+	{
+		RIO_ASSERT(!isCreated, "Fiber is already created");
+		RIO_ASSERT_NOT_NULL(function);
+		this->function = function;
+		this->data = data;
+
+		// stackSize is reserved, the pages are committed as the stack grows past its guard page
+		fiberHandle = CreateFiberEx(0, stackSize, FIBER_FLAG_FLOAT_SWITCH, (LPFIBER_START_ROUTINE)&Fiber::entry, this);
+		RIO_ASSERT(fiberHandle != NULL, "CreateFiberEx: GetLastError = %d", GetLastError());
+		isThread = false;
+		isCreated = true;
+	}
+
+	void Fiber::createFromCurrentThread()
+	{
+		RIO_ASSERT(!isCreated, "Fiber is already created");
+		if (IsThreadAFiber())
+		{
+			// Converted by someone else, who converts it back
+			fiberHandle = GetCurrentFiber();
+			isThread = false;
+		}
+		else
+		{
+			fiberHandle = ConvertThreadToFiberEx(NULL, FIBER_FLAG_FLOAT_SWITCH);
+			RIO_ASSERT(fiberHandle != NULL, "ConvertThreadToFiberEx: GetLastError = %d", GetLastError());
+			isThread = true;
+		}
+		function = NULL;
+		isCreated = true;
+	}
+
+	void Fiber::destroy()
+	{
+		RIO_ASSERT(isCreated, "Fiber is not created");
+		if (function != NULL)
+		{
+			DeleteFiber(fiberHandle);
+		}
+		else if (isThread)
+		{
+			// Must be called by the thread
+			ConvertFiberToThread();
+		}
+		fiberHandle = NULL;
+		isCreated = false;
+	}
+
+	bool Fiber::getIsCreated() const
+	{
+		return isCreated;
+	}
+
+	void Fiber::switchTo(Fiber& from, Fiber& to)
+	{
+		RIO_ASSERT(from.isCreated && to.isCreated, "Fiber is not created");
+		RIO_UNUSED(from);
+		SwitchToFiber(to.fiberHandle);
+	}
+
+	void __stdcall Fiber::entry(void* fiber)
+	{
+		Fiber& self = *(Fiber*)fiber;
+		self.function(self.data);
+		RIO_FATAL("Fiber function returned");
+	}
+
+} // namespace Rio
+
+#endif // RIO_PLATFORM_WINDOWS
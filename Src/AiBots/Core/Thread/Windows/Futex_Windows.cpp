@@ -0,0 +1,94 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#include "Core/Thread/Futex.h"
+
+#if RIO_PLATFORM_WINDOWS
+
+#include "Core/Os/Windows/Headers_Windows.h"
+
+#if _WIN32_WINNT >= 0x0602
+	#pragma comment(lib, "Synchronization.lib")
+#endif // _WIN32_WINNT >= 0x0602
+
+namespace Rio
+{
+	namespace FutexFn
+	{
+		static_assert(sizeof(Atomic<uint32_t>) == sizeof(uint32_t), "The futex is the address of the Atomic");
+
+#if _WIN32_WINNT >= 0x0602
+		void wait(Atomic<uint32_t>& word, uint32_t expected)
+		{
+			WaitOnAddress((volatile VOID*)&word, &expected, sizeof(expected), INFINITE);
+		}
+
+		void wake(Atomic<uint32_t>& word, uint32_t count)
+		{
+			if (count == 1)
+			{
+				WakeByAddressSingle((PVOID)&word);
+			}
+			else
+			{
+				WakeByAddressAll((PVOID)&word);
+			}
+		}
+
+		void wakeAll(Atomic<uint32_t>& word)
+		{
+			WakeByAddressAll((PVOID)&word);
+		}
+#else
+		namespace
+		{
+			// Waiters of different addresses may share a bucket, they are woken spuriously
+			const uint32_t BUCKETS_COUNT = 64;
+
+			struct Bucket
+			{
+				SRWLOCK lock;
+				CONDITION_VARIABLE condition;
+				char padding[RIO_CACHE_LINE_SIZE];
+			};
+
+			// SRWLOCK_INIT and CONDITION_VARIABLE_INIT are all zeros
+			Bucket buckets[BUCKETS_COUNT];
+
+			Bucket& getBucket(const Atomic<uint32_t>& word)
+			{
+				const uintptr_t address = (uintptr_t)&word;
+				return buckets[((address >> 2) ^ (address >> 9)) % BUCKETS_COUNT];
+			}
+		} // namespace (anonymous)
+
+		void wait(Atomic<uint32_t>& word, uint32_t expected)
+		{
+			Bucket& bucket = getBucket(word);
+			AcquireSRWLockExclusive(&bucket.lock);
+			// The wakers take the lock after changing the word, checked under it nothing is missed
+			if (word.load(MemoryOrder::SEQUENTIALLY_CONSISTENT) == expected)
+			{
+				SleepConditionVariableSRW(&bucket.condition, &bucket.lock, INFINITE, 0);
+			}
+			ReleaseSRWLockExclusive(&bucket.lock);
+		}
+
+		void wake(Atomic<uint32_t>& word, uint32_t count)
+		{
+			// The bucket is shared, a signal could go to a waiter of another address
+			RIO_UNUSED(count);
+			wakeAll(word);
+		}
+
+		void wakeAll(Atomic<uint32_t>& word)
+		{
+			Bucket& bucket = getBucket(word);
+			AcquireSRWLockExclusive(&bucket.lock);
+			WakeAllConditionVariable(&bucket.condition);
+			ReleaseSRWLockExclusive(&bucket.lock);
+		}
+#endif // _WIN32_WINNT >= 0x0602
+	} // namespace FutexFn
+
+} // namespace Rio
+
+#endif // RIO_PLATFORM_WINDOWS
@@ -2,7 +2,7 @@
 
 #include "Core/Thread/Mutex.h"
 
-#if RIO_PLATFORM_WINDOWS
+#if RIO_PLATFORM_WINDOWS && !RIO_FUTEX
 
 namespace Rio
 {
@@ -27,4 +27,4 @@ namespace Rio
 	}
 } // namespace Rio
 
-#endif // RIO_PLATFORM_WINDOWS
\ No newline at end of file
+#endif // RIO_PLATFORM_WINDOWS && !RIO_FUTEX
\ No newline at end of file
@@ -1,7 +1,7 @@
 // Copyright (c) 2015 Volodymyr Syvochka
 #include "Core/Thread/Semaphore.h"
 
-#if RIO_PLATFORM_WINDOWS
+#if RIO_PLATFORM_WINDOWS && !RIO_FUTEX
 
 namespace Rio
 {
@@ -36,4 +36,4 @@ namespace Rio
 
 } // namespace Rio
 
-#endif // RIO_PLATFORM_WINDOWS
\ No newline at end of file
+#endif // RIO_PLATFORM_WINDOWS && !RIO_FUTEX
\ No newline at end of file
@@ -3,15 +3,62 @@
 
 #if RIO_PLATFORM_WINDOWS
 
+#include <string.h> // strncpy, memset
+
 namespace Rio
 {
+	typedef HRESULT (WINAPI *SetThreadDescriptionFunction)(HANDLE, PCWSTR);
+
+	static void setNativeName(HANDLE handle, const char* name)
+	{
+		// Windows 10 1607 and later, shown by the debuggers and the profilers
+		static SetThreadDescriptionFunction setThreadDescription =
+			(SetThreadDescriptionFunction)GetProcAddress(GetModuleHandleA("kernel32.dll"), "SetThreadDescription");
+		if (setThreadDescription == NULL)
+		{
+			return;
+		}
+		WCHAR wideName[64];
+		if (MultiByteToWideChar(CP_UTF8, 0, name, -1, wideName, 64) == 0)
+		{
+			return;
+		}
+		setThreadDescription(handle, wideName);
+	}
+
+	static bool setNativePriority(HANDLE handle, ThreadPriority::Enum priority)
+	{
+		// Within the priority class of the process, TIME_CRITICAL is the highest outside of REALTIME_PRIORITY_CLASS
+		const int priorities[] =
+		{
+			THREAD_PRIORITY_BELOW_NORMAL,
+			THREAD_PRIORITY_NORMAL,
+			THREAD_PRIORITY_HIGHEST,
+			THREAD_PRIORITY_TIME_CRITICAL
+		};
+		return SetThreadPriority(handle, priorities[priority]) != 0;
+	}
+
+	static bool setNativeAffinity(HANDLE handle, const CpuSet& cpus)
+	{
+		// A thread runs in a single processor group of 64 cpus, the one of the first cpu of the set
+		const uint32_t first = CpuSetFn::getFirst(cpus);
+		GROUP_AFFINITY groupAffinity;
+		memset(&groupAffinity, 0, sizeof(groupAffinity));
+		groupAffinity.Group = WORD(first / 64);
+		groupAffinity.Mask = KAFFINITY(cpus.bits[first / 64]);
+		return SetThreadGroupAffinity(handle, &groupAffinity, NULL) != 0;
+	}
 	Thread::Thread()
 		: threadHandle(INVALID_HANDLE_VALUE)
 	, threadFunction(NULL)
 	, threadData(NULL)
 	, threadStackSize(0)
+	, priority(ThreadPriority::NORMAL)
 	, isRunning(false)
 	{
+		name[0] = '\0';
+		CpuSetFn::clear(affinity);
 	}
 
 	Thread::~Thread()
@@ -30,7 +77,8 @@ namespace Rio
 		threadData = data;
 		threadStackSize = stackSize;
 
-		threadHandle = CreateThread(NULL, stackSize, Thread::threadProc, this, 0, NULL);
+		// Without the flag stackSize is the memory committed up front, the reserved size is the one of the executable
+		threadHandle = CreateThread(NULL, stackSize, Thread::threadProc, this, STACK_SIZE_PARAM_IS_A_RESERVATION, NULL);
 		RIO_ASSERT(threadHandle != NULL, "CreateThread: GetLastError = %d", GetLastError());
 
 		isRunning = true;
@@ -48,6 +96,89 @@ namespace Rio
 		isRunning = false;
 	}
 
+	void Thread::setName(const char* name)
+	{
+		RIO_ASSERT_NOT_NULL(name);
+		strncpy(this->name, name, sizeof(this->name) - 1);
+		this->name[sizeof(this->name) - 1] = '\0';
+		if (isRunning)
+		{
+			setNativeName(threadHandle, this->name);
+		}
+	}
+
+	bool Thread::setPriority(ThreadPriority::Enum priority)
+	{
+		this->priority = priority;
+		return isRunning ? setNativePriority(threadHandle, priority) : true;
+	}
+
+	bool Thread::setAffinity(const CpuSet& cpus)
+	{
+		RIO_ASSERT(!CpuSetFn::getIsEmpty(cpus), "The set must have a cpu");
+		affinity = cpus;
+		return isRunning ? setNativeAffinity(threadHandle, affinity) : true;
+	}
+
+	bool Thread::setNumaNode(uint32_t numaNode)
+	{
+		CpuSet cpus;
+		CpuTopologyFn::getNumaNodeCpus(CpuTopologyFn::get(), numaNode, cpus);
+		return !CpuSetFn::getIsEmpty(cpus) && setAffinity(cpus);
+	}
+
+	void Thread::applySettings()
+	{
+		if (name[0] != '\0')
+		{
+			setNativeName(GetCurrentThread(), name);
+		}
+		if (priority != ThreadPriority::NORMAL)
+		{
+			setNativePriority(GetCurrentThread(), priority);
+		}
+		if (!CpuSetFn::getIsEmpty(affinity))
+		{
+			setNativeAffinity(GetCurrentThread(), affinity);
+		}
+	}
+
+	void Thread::setCurrentName(const char* name)
+	{
+		RIO_ASSERT_NOT_NULL(name);
+		setNativeName(GetCurrentThread(), name);
+	}
+
+	bool Thread::setCurrentPriority(ThreadPriority::Enum priority)
+	{
+		return setNativePriority(GetCurrentThread(), priority);
+	}
+
+	bool Thread::setCurrentAffinity(const CpuSet& cpus)
+	{
+		RIO_ASSERT(!CpuSetFn::getIsEmpty(cpus), "The set must have a cpu");
+		return setNativeAffinity(GetCurrentThread(), cpus);
+	}
+
+	uint32_t Thread::getCurrentCpu()
+	{
+		PROCESSOR_NUMBER number;
+		GetCurrentProcessorNumberEx(&number);
+		return uint32_t(number.Group) * 64 + number.Number;
+	}
+
+	uint32_t Thread::getProcessorsCount()
+	{
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+		return info.dwNumberOfProcessors > 0 ? uint32_t(info.dwNumberOfProcessors) : 1;
+	}
+
+	void Thread::yield()
+	{
+		SwitchToThread();
+	}
+
 } // namespace Rio
 
 #endif // RIO_PLATFORM_WINDOWS
\ No newline at end of file
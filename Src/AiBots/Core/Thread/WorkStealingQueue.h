@@ -0,0 +1,105 @@
+// Copyright (c) 2015 Volodymyr Syvochka
+#pragma once
+
+#include "Core/Base/Config.h"
+#include "Core/Base/Types.h"
+#include "Core/Base/Platform.h"
+#include "Core/Debug/Error.h"
+#include "Core/Thread/Atomic.h"
+
+namespace Rio
+{
+	// Chase-Lev deque of pointers with a fixed capacity.
+	// The owner thread pushes and pops at the bottom (LIFO), any other thread steals from the top (FIFO).
+	// See "Correct and Efficient Work-Stealing for Weak Memory Models", Le et al. 2013.
+	template <typename T, uint32_t CAPACITY>
+	class WorkStealingQueue
+	{
+	public:
+		WorkStealingQueue()
+			: bottom(0)
+			, top(0)
+		{
+			static_assert((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of 2");
+			for (uint32_t i = 0; i < CAPACITY; ++i)
+			{
+				items[i].store(nullptr, MemoryOrder::RELAXED);
+			}
+		}
+
+		// Owner only, returns false if the queue is full
+		bool push(T* item)
+		{
+			const int64_t b = bottom.load(MemoryOrder::RELAXED);
+			const int64_t t = top.load(MemoryOrder::ACQUIRE);
+			if (b - t >= int64_t(CAPACITY))
+			{
+				return false;
+			}
+			items[b & (CAPACITY - 1)].store(item, MemoryOrder::RELAXED);
+			bottom.store(b + 1, MemoryOrder::RELEASE);
+			return true;
+		}
+
+		// Owner only, returns the last pushed item or nullptr if the queue is empty
+		T* pop()
+		{
+			const int64_t b = bottom.load(MemoryOrder::RELAXED) - 1;
+			// Reserves the bottom item before looking at top, the thieves see it
+			bottom.store(b, MemoryOrder::SEQUENTIALLY_CONSISTENT);
+			int64_t t = top.load(MemoryOrder::SEQUENTIALLY_CONSISTENT);
+			if (t > b)
+			{
+				bottom.store(b + 1, MemoryOrder::RELAXED);
+				return nullptr;
+			}
+
+			T* item = items[b & (CAPACITY - 1)].load(MemoryOrder::RELAXED);
+			if (t == b)
+			{
+				// Last item, races with the thieves
+				if (!top.compareExchangeStrong(t, t + 1, MemoryOrder::SEQUENTIALLY_CONSISTENT, MemoryOrder::RELAXED))
+				{
+					item = nullptr;
+				}
+				bottom.store(b + 1, MemoryOrder::RELAXED);
+			}
+			return item;
+		}
+
+		// Any thread, returns the first pushed item or nullptr if the queue is empty or the steal lost a race
+		T* steal()
+		{
+			int64_t t = top.load(MemoryOrder::SEQUENTIALLY_CONSISTENT);
+			const int64_t b = bottom.load(MemoryOrder::SEQUENTIALLY_CONSISTENT);
+			if (t >= b)
+			{
+				return nullptr;
+			}
+
+			T* item = items[t & (CAPACITY - 1)].load(MemoryOrder::RELAXED);
+			if (!top.compareExchangeStrong(t, t + 1, MemoryOrder::SEQUENTIALLY_CONSISTENT, MemoryOrder::RELAXED))
+			{
+				return nullptr;
+			}
+			return item;
+		}
+
+		// Any thread, the result may be out of date once returned
+		bool getIsEmpty() const
+		{
+			return top.load(MemoryOrder::RELAXED) >= bottom.load(MemoryOrder::RELAXED);
+		}
+
+	private:
+		// bottom is written by the owner and top by the thieves, kept on separate cache lines
+		PaddedAtomic<int64_t> bottom;
+		PaddedAtomic<int64_t> top;
+		Atomic<T*> items[CAPACITY];
+	private:
+		// Disable copying
+		WorkStealingQueue(const WorkStealingQueue&);
+		WorkStealingQueue& operator=(const WorkStealingQueue&);
+	};
+
+} // namespace Rio
@@ -12,13 +12,15 @@ namespace Rio
 
 	struct ResourceId
 	{
-		ResourceId()
+		constexpr ResourceId()
 			: type(uint64_t(0))
 			, name(uint64_t(0))
 		{
 		}
 
-		ResourceId(StringId64 type, StringId64 name)
+		// Use with _id64 to compute the id at compile time
+		// e.g. ResourceId("texture"_id64, "logo"_id64)
+		constexpr ResourceId(StringId64 type, StringId64 name)
 			: type(type)
 			, name(name)
 		{